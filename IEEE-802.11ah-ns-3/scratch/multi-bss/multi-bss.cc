@@ -0,0 +1,264 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Several 802.11ah BSSs sharing one YansWifiChannel, each on its own
+ * channel number, with the same RAW setup and UDP echo traffic as
+ * scratch/test. The channel only visits the PHYs tuned to the channel
+ * of the sender, so the cost of a frame does not grow with the number
+ * of BSSs. The end of the run reports how many PHYs a frame visits,
+ * against the number attached to the channel.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/arp-table-helper.h"
+#include "ns3/rps.h"
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("s1g-multi-bss");
+
+uint32_t nAp = 12;
+uint32_t nStaPerAp = 50;
+uint32_t rawSlots = 2;
+double apDistance = 300;
+double rho = 100;
+double simulationTime = 10;
+uint32_t payloadSize = 100;
+uint32_t trafficInterval = 1000;
+uint32_t beaconInterval = 102400;
+uint32_t seed = 1;
+bool bulkAssociation = false;
+
+uint64_t transmissions = 0;
+uint32_t echoed = 0;
+uint32_t sent = 0;
+
+void onChannelTransmission(Ptr<NetDevice> senderDevice, Ptr<Packet> packet) {
+	transmissions++;
+}
+
+void onUdpPacketSent(Ptr<const Packet> packet) {
+	sent++;
+}
+
+void onUdpEchoPacketReceived(Ptr<const Packet> packet, Address from) {
+	echoed++;
+}
+
+// one RAW group per beacon covering all the stations of a BSS; the AP
+// takes the AID of a station from the low bits of its MAC address
+RPSVector configureRAW(uint32_t aidStart, uint32_t aidEnd) {
+	RPSVector rpslist;
+	RPS *rps = new RPS;
+	RPS::RawAssignment raw;
+	raw.SetRawControl(0);
+	raw.SetSlotCrossBoundary(1);
+	raw.SetSlotFormat(1);
+	raw.SetSlotDurationCount(200);
+	raw.SetSlotNum(rawSlots);
+	uint32_t page = 0;
+	raw.SetRawGroup((aidEnd << 13) | (aidStart << 2) | page);
+	rps->SetRawAssignment(raw);
+	rpslist.rpsset.push_back(rps);
+	return rpslist;
+}
+
+int main(int argc, char *argv[]) {
+	CommandLine cmd;
+	cmd.AddValue("NAp", "Number of BSSs, each on its own channel", nAp);
+	cmd.AddValue("NStaPerAp", "Number of stations in each BSS", nStaPerAp);
+	cmd.AddValue("NRawSlot", "Number of RAW slots", rawSlots);
+	cmd.AddValue("apDistance", "Distance between two neighbouring APs", apDistance);
+	cmd.AddValue("rho", "Maximal distance between an AP and its stations", rho);
+	cmd.AddValue("simulationTime", "Simulation time in seconds", simulationTime);
+	cmd.AddValue("payloadSize", "Size of payload to send in bytes", payloadSize);
+	cmd.AddValue("TrafficInterval", "Traffic interval time in ms", trafficInterval);
+	cmd.AddValue("BeaconInterval", "Beacon interval time in us", beaconInterval);
+	cmd.AddValue("seed", "random seed", seed);
+	cmd.AddValue("BulkAssociation", "Associate all the stations before the simulation starts, without the association frames (true/false)", bulkAssociation);
+	cmd.Parse(argc, argv);
+	NS_ABORT_MSG_IF(nAp == 0 || nAp > 12, "NAp must be in [1, 12]");
+	NS_ABORT_MSG_IF(nStaPerAp == 0 || nAp * (nStaPerAp + 1) > 2047,
+			"The stations must fit in one page of AIDs");
+
+	PhaseTimer setupTimer;
+	setupTimer.Start("setup");
+	RngSeedManager::SetSeed(seed);
+
+	YansWifiChannelHelper channelBuilder = YansWifiChannelHelper();
+	channelBuilder.AddPropagationLoss("ns3::LogDistancePropagationLossModel",
+			"Exponent", DoubleValue(3.76), "ReferenceLoss", DoubleValue(8.0),
+			"ReferenceDistance", DoubleValue(1.0));
+	channelBuilder.SetPropagationDelay(
+			"ns3::ConstantSpeedPropagationDelayModel");
+	Ptr<YansWifiChannel> channel = channelBuilder.Create();
+	channel->TraceConnectWithoutContext("Transmission",
+			MakeCallback(&onChannelTransmission));
+
+	WifiHelper wifi = WifiHelper::Default();
+	wifi.SetStandard(WIFI_PHY_STANDARD_80211ah);
+	StringValue dataRate = StringValue("OfdmRate650KbpsBW2MHz");
+	wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager", "DataMode",
+			dataRate, "ControlMode", dataRate);
+	S1gWifiMacHelper mac = S1gWifiMacHelper::Default();
+	pageSlice pageS;
+	pageS.SetPageindex(0);
+	pageS.SetPagePeriod(1);
+	pageS.SetPageSliceLen(1);
+	pageS.SetPageSliceCount(0);
+	pageS.SetBlockOffset(0);
+	pageS.SetTIMOffset(0);
+	TIM tim;
+	tim.SetPageIndex(0);
+	tim.SetDTIMPeriod(1);
+
+	NodeContainer allNodes;
+	NodeContainer apNodes;
+	NetDeviceContainer allDevices;
+	NetDeviceContainer apDevices;
+	vector<NodeContainer> staNodes(nAp);
+	uint32_t gridSize = ceil(sqrt(nAp));
+
+	for (uint32_t b = 0; b < nAp; b++) {
+		uint16_t channelNumber = 1 + 4 * b;
+		Ssid ssid = Ssid("ns380211ah-" + std::to_string(b));
+
+		staNodes[b].Create(nStaPerAp);
+		NodeContainer apNode;
+		apNode.Create(1);
+
+		YansWifiPhyHelper phy = YansWifiPhyHelper::Default();
+		phy.SetErrorRateModel("ns3::YansErrorRateModel");
+		phy.SetChannel(channel);
+		phy.Set("ChannelNumber", UintegerValue(channelNumber));
+		phy.Set("ShortGuardEnabled", BooleanValue(false));
+		phy.Set("ChannelWidth", UintegerValue(2));
+		phy.Set("EnergyDetectionThreshold", DoubleValue(-110.0));
+		phy.Set("CcaMode1Threshold", DoubleValue(-113.0));
+		phy.Set("TxGain", DoubleValue(0.0));
+		phy.Set("RxGain", DoubleValue(0.0));
+		phy.Set("TxPowerLevels", UintegerValue(1));
+		phy.Set("TxPowerEnd", DoubleValue(0.0));
+		phy.Set("TxPowerStart", DoubleValue(0.0));
+		phy.Set("RxNoiseFigure", DoubleValue(6.8));
+		phy.Set("LdpcEnabled", BooleanValue(true));
+
+		mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid),
+				"ActiveProbing", BooleanValue(false));
+		NetDeviceContainer staDevices = wifi.Install(phy, mac, staNodes[b]);
+
+		// the MAC addresses, hence the AIDs, are allocated in install order
+		uint32_t aidStart = b * (nStaPerAp + 1) + 1;
+		RPSVector rps = configureRAW(aidStart, aidStart + nStaPerAp - 1);
+		mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid),
+				"BeaconInterval", TimeValue(MicroSeconds(beaconInterval)),
+				"NRawStations", UintegerValue(nStaPerAp),
+				"RPSsetup", RPSVectorValue(rps),
+				"PageSliceSet", pageSliceValue(pageS),
+				"TIMSet", TIMValue(tim));
+		phy.Set("TxGain", DoubleValue(3.0));
+		phy.Set("RxGain", DoubleValue(3.0));
+		phy.Set("TxPowerEnd", DoubleValue(30.0));
+		phy.Set("TxPowerStart", DoubleValue(30.0));
+		NetDeviceContainer apDevice = wifi.Install(phy, mac, apNode);
+		// streams keyed by node and device, so that a BSS draws the same
+		// numbers whatever the other BSSs and their install order
+		wifi.AssignStreams(staDevices);
+		wifi.AssignStreams(apDevice);
+		if (bulkAssociation) {
+			WifiAssociationHelper association;
+			association.Associate(staDevices, apDevice.Get(0));
+		}
+
+		double x = apDistance * (b % gridSize) + rho;
+		double y = apDistance * (b / gridSize) + rho;
+		MobilityHelper mobility;
+		mobility.SetPositionAllocator("ns3::UniformDiscPositionAllocator",
+				"X", DoubleValue(x), "Y", DoubleValue(y),
+				"rho", DoubleValue(rho));
+		mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+		mobility.Install(staNodes[b]);
+		Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+		positionAlloc->Add(Vector(x, y, 0.0));
+		mobility.SetPositionAllocator(positionAlloc);
+		mobility.Install(apNode);
+
+		allNodes.Add(staNodes[b]);
+		allNodes.Add(apNode);
+		apNodes.Add(apNode);
+		allDevices.Add(staDevices);
+		allDevices.Add(apDevice);
+		apDevices.Add(apDevice);
+	}
+
+	InternetStackHelper stack;
+	stack.Install(allNodes);
+	Ipv4AddressHelper address;
+	address.SetBase("192.168.0.0", "255.255.0.0");
+	Ipv4InterfaceContainer interfaces = address.Assign(allDevices);
+	ArpTableHelper arp;
+	arp.InstallAll();
+
+	Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable>();
+	UdpEchoServerHelper server(9);
+	ApplicationContainer serverApps = server.Install(apNodes);
+	serverApps.Start(Seconds(0));
+	for (uint32_t b = 0; b < nAp; b++) {
+		// the AP follows its stations in the interface container
+		Ipv4Address apAddress = interfaces.GetAddress((b + 1) * (nStaPerAp + 1) - 1);
+		UdpEchoClientHelper client(apAddress, 9);
+		client.SetAttribute("MaxPackets", UintegerValue(4294967295u));
+		client.SetAttribute("Interval", TimeValue(MilliSeconds(trafficInterval)));
+		client.SetAttribute("PacketSize", UintegerValue(payloadSize));
+		for (uint32_t i = 0; i < nStaPerAp; i++) {
+			ApplicationContainer clientApp = client.Install(staNodes[b].Get(i));
+			clientApp.Get(0)->TraceConnectWithoutContext("Tx", MakeCallback(&onUdpPacketSent));
+			clientApp.Get(0)->TraceConnectWithoutContext("Rx", MakeCallback(&onUdpEchoPacketReceived));
+			clientApp.Start(MilliSeconds(rv->GetValue(0, trafficInterval)));
+		}
+	}
+
+	setupTimer.Start("run");
+	Simulator::Stop(Seconds(simulationTime));
+	Simulator::Run();
+	setupTimer.Stop();
+	Simulator::Destroy();
+
+	uint32_t nPhys = nAp * (nStaPerAp + 1);
+	cout << "BSSs " << nAp << ", PHYs " << nPhys << endl;
+	cout << "packets sent " << sent << ", echoed " << echoed << endl;
+	cout << "frames on the channel " << transmissions << endl;
+	if (transmissions > 0) {
+		// counted by the channel, each BSS alone on its channel number
+		// should only cost the other PHYs of the BSS
+		double perFrame = double(channel->GetNVisitedPhys()) / transmissions;
+		cout << "PHYs visited per frame " << perFrame << " instead of " << nPhys - 1
+				<< " (" << (nPhys - 1) / perFrame << "x fewer, expected " << nStaPerAp
+				<< " per frame)" << endl;
+	}
+	cout << "Wall clock time per stage:" << endl;
+	setupTimer.Report(cout);
+	return 0;
+}
@@ -16,6 +16,7 @@ Configuration::Configuration(int argc, char *argv[]) {
     cmd.AddValue("NRawSta", "number of stations supporting RAW. If -1 it will be based on NSta, should be divisible by NGroup", NRawSta);
     cmd.AddValue ("payloadSize", "Size of payload to send in bytes", payloadSize);
     cmd.AddValue("BeaconInterval", "Beacon interval time in us", BeaconInterval);
+    cmd.AddValue("BulkAssociation", "Associate all the stations before the simulation starts, without the association frames (true/false)", bulkAssociation);
     cmd.AddValue("DataMode", "Date mode (check MCStoWifiMode for more details) (format: MCSbw_mcs, e.g. MCS1_0 is OfdmRate300KbpsBW1Mhz)", DataMode);
     cmd.AddValue("datarate", "data rate in Mbps", datarate);
     cmd.AddValue("bandWidth", "bandwidth in MHz", bandWidth);
@@ -61,6 +61,7 @@ struct Configuration {
 	int NRawSta;
 	uint32_t Nsta;
 	uint32_t BeaconInterval = 102400;
+	bool bulkAssociation = false;	// associate the stations before the start instead of through the frames
 
 	double datarate = 7.8;
 	double bandWidth = 2;
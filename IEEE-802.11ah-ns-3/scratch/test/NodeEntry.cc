@@ -555,7 +555,7 @@ void NodeEntry::OnCoapPacketReceived(Ptr<const Packet> packet, Address from) {
 		Time newNow = Simulator::Now();
 		if (currentSequenceNumber == stats->get(this->id).m_prevPacketSeqClient + 1)
 		{
-			stats->get(this->id).m_interPacketDelayClient.push_back(newNow - stats->get(this->id).m_prevPacketTimeClient);
+			stats->get(this->id).m_interPacketDelayClient.add(newNow - stats->get(this->id).m_prevPacketTimeClient);
 			stats->get(this->id).interPacketDelayAtClient = newNow - stats->get(this->id).m_prevPacketTimeClient;
 			//cout << "============================================================================ interPacketDelayAtClient " << this->id << " is" << newNow - stats->get(this->id).m_prevPacketTimeClient << endl;
 
@@ -567,7 +567,7 @@ void NodeEntry::OnCoapPacketReceived(Ptr<const Packet> packet, Address from) {
 				NS_LOG_INFO (std::to_string(i) << " ");
 			NS_LOG_INFO ("is(are) lost in path Server -> Client");
 
-			stats->get(this->id).m_interPacketDelayClient.push_back(newNow - stats->get(this->id).m_prevPacketTimeClient);
+			stats->get(this->id).m_interPacketDelayClient.add(newNow - stats->get(this->id).m_prevPacketTimeClient);
 			stats->get(this->id).interPacketDelayAtClient = newNow - stats->get(this->id).m_prevPacketTimeClient;
 
 		}
@@ -632,9 +632,8 @@ void NodeEntry::OnCoapPacketReceivedAtServer(Ptr<const Packet> packet) {
 		else if (currentSequenceNumber == stats->get(this->id).m_prevPacketSeqServer + 1)
 		{
 			Time newNow = Simulator::Now();
-			stats->get(this->id).m_interPacketDelayServer.push_back(newNow - stats->get(this->id).m_prevPacketTimeServer);
+			stats->get(this->id).m_interPacketDelayServer.add(newNow - stats->get(this->id).m_prevPacketTimeServer);
 			stats->get(this->id).interPacketDelayAtServer = newNow - stats->get(this->id).m_prevPacketTimeServer;
-			stats->get(this->id).m_time.push_back(newNow);
 			stats->get(this->id).m_prevPacketSeqServer = currentSequenceNumber;
 			stats->get(this->id).m_prevPacketTimeServer = newNow;
 		}
@@ -646,9 +645,8 @@ void NodeEntry::OnCoapPacketReceivedAtServer(Ptr<const Packet> packet) {
 			NS_LOG_INFO ("is(are) lost in path Client->Server");
 
 			Time newNow = Simulator::Now();
-			stats->get(this->id).m_interPacketDelayServer.push_back(newNow - stats->get(this->id).m_prevPacketTimeServer);
+			stats->get(this->id).m_interPacketDelayServer.add(newNow - stats->get(this->id).m_prevPacketTimeServer);
 			stats->get(this->id).interPacketDelayAtServer = newNow - stats->get(this->id).m_prevPacketTimeServer;
-			stats->get(this->id).m_time.push_back(newNow);
 			stats->get(this->id).m_prevPacketSeqServer = currentSequenceNumber;
 			stats->get(this->id).m_prevPacketTimeServer = newNow;
 
@@ -24,26 +24,32 @@ double NodeStatistics::GetTotalEnergyConsumption (void)
 	return this->EnergyRxIdle + this->EnergyTx; //mW
 }
 
-Time NodeStatistics::GetAverageInterPacketDelay(std::vector<Time>& delayVector){
-	if (delayVector.size() != 0)
-	{
-		//cout << "inter packet delay vector size " << delayVector.size() << endl;
-		return std::accumulate(delayVector.begin(), delayVector.end(), Seconds(0.0))/delayVector.size();
-	}
+void InterPacketDelayStats::add(Time delay) {
+	long double us = delay.GetMicroSeconds();
+	count++;
+	total += delay;
+	totalMicroSeconds += us;
+	totalSquaredMicroSeconds += us * us;
+}
+
+Time NodeStatistics::GetAverageInterPacketDelay(const InterPacketDelayStats& delays){
+	if (delays.count != 0)
+		return delays.total / delays.count;
 	else return Time();
 }
 
-long double NodeStatistics::GetInterPacketDelayDeviation(std::vector<Time>& delayVector) // in microseconds
+long double NodeStatistics::GetInterPacketDelayDeviation(const InterPacketDelayStats& delays) // in microseconds
 {
-	long double meanInterPacketDelay (this->GetAverageInterPacketDelay(delayVector).GetMicroSeconds());
-	long double dev (0);
-	for (Time& delay : delayVector)
-	{
-		dev += (static_cast<long double>(delay.GetMicroSeconds()) - meanInterPacketDelay)*(static_cast<long double>(delay.GetMicroSeconds() - meanInterPacketDelay));
-	}
-	if (delayVector.size() > 0)
-		return sqrt(dev/delayVector.size());
-	else return -1; //implement exception handling for dummy nodes TODO
+	if (delays.count == 0)
+		return -1; //implement exception handling for dummy nodes TODO
+	long double meanInterPacketDelay (this->GetAverageInterPacketDelay(delays).GetMicroSeconds());
+	// sum of (delay - mean)^2, expanded over the running sums
+	long double dev = delays.totalSquaredMicroSeconds
+			- 2 * meanInterPacketDelay * delays.totalMicroSeconds
+			+ delays.count * meanInterPacketDelay * meanInterPacketDelay;
+	if (dev < 0)
+		dev = 0;
+	return sqrt(dev/delays.count);
 }
 
 //reliability for one node or for all nodes in whole network? impossible with dummy nodes.
@@ -57,10 +63,10 @@ float NodeStatistics::GetPacketLoss (std::string trafficType)
 	else return -1;
 }
 
-long double NodeStatistics::GetInterPacketDelayDeviationPercentage(std::vector<Time>& delayVector){
-	int64_t avg = GetAverageInterPacketDelay(delayVector).GetMicroSeconds();
+long double NodeStatistics::GetInterPacketDelayDeviationPercentage(const InterPacketDelayStats& delays){
+	int64_t avg = GetAverageInterPacketDelay(delays).GetMicroSeconds();
 	if (avg != 0)
-		return (100 * GetInterPacketDelayDeviation(delayVector)/avg);
+		return (100 * GetInterPacketDelayDeviation(delays)/avg);
 	else
 		return -1;
 }
@@ -8,6 +8,19 @@
 using namespace std;
 using namespace ns3;
 
+// Running sums of the inter-packet delays of a node. The mean and the
+// deviation are reported at every statistics interval, keeping the sums
+// instead of every delay makes that independent of the simulated time.
+class InterPacketDelayStats {
+public:
+    long count = 0;
+    Time total = Time();
+    long double totalMicroSeconds = 0;
+    long double totalSquaredMicroSeconds = 0;
+
+    void add(Time delay);
+};
+
 class NodeStatistics {
 
 public:
@@ -30,12 +43,11 @@ public:
     
     Time interPacketDelayAtServer = Time(); ///ami
     Time interPacketDelayAtClient = Time(); ///ami
-    std::vector<Time> m_interPacketDelayServer;
-    std::vector<Time> m_interPacketDelayClient;
-    std::vector<Time> m_time;
-    long double GetInterPacketDelayDeviation(std::vector<Time>& delayVector);
-    long double GetInterPacketDelayDeviationPercentage(std::vector<Time>& delayVector);
-    Time GetAverageInterPacketDelay(std::vector<Time>& delayVector);
+    InterPacketDelayStats m_interPacketDelayServer;
+    InterPacketDelayStats m_interPacketDelayClient;
+    long double GetInterPacketDelayDeviation(const InterPacketDelayStats& delays);
+    long double GetInterPacketDelayDeviationPercentage(const InterPacketDelayStats& delays);
+    Time GetAverageInterPacketDelay(const InterPacketDelayStats& delays);
     float GetPacketLoss (std::string trafficType);
     long double GetInterPacketDelayAtServer (void);
     long double GetInterPacketDelayAtClient (void);
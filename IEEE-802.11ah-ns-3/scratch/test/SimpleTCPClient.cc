@@ -74,22 +74,17 @@ int stat_connect(const char* hostname, const char* port) {
 
 bool stat_send(int sockfd, const char* buf) {
 	int length = strlen(buf);
-	if(length < MAXDATASIZE) {
-		int bytesSent = send(sockfd, buf, length, 0);
-		if(bytesSent < 0) fprintf(stderr, "socket send failed: %m\n");
-		return bytesSent != -1;
-	}
-	else {
-		int pos = 0;
-		while(pos < length) {
-			int size = pos +  MAXDATASIZE - 1 < length ?  MAXDATASIZE - 1 : (length - pos-1);
-			int bytesSent = send(sockfd, buf,size, 0);
-			if(bytesSent == -1)
-				return false;
-
-			pos+=bytesSent;
+	int pos = 0;
+	while(pos < length) {
+		int size = length - pos < MAXDATASIZE ? length - pos : MAXDATASIZE;
+		int bytesSent = send(sockfd, buf + pos, size, 0);
+		if(bytesSent < 0) {
+			fprintf(stderr, "socket send failed: %m\n");
+			return false;
 		}
+		pos += bytesSent;
 	}
+	return true;
 }
 
 void stat_close(int sockfd) {
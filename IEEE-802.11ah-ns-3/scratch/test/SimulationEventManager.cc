@@ -121,8 +121,16 @@ void SimulationEventManager::onUpdateSlotStatistics(vector<long>& transmissionsP
 }
 
 void SimulationEventManager::onUpdateStatistics(Statistics& stats) {
+	if(!hasOutput())
+		return;
+
+	// one line per node, written to the nss file at once so that it is
+	// opened once per interval instead of once per node. The visualizer
+	// still gets one line per send.
+	std::stringstream lines;
 	for(int i = 0; i < stats.getNumberOfNodes(); i++) {
-		send({"nodestats", std::to_string(i),
+		std::stringstream line;
+		format(line, {"nodestats", std::to_string(i),
 			std::to_string(stats.get(i).TotalTxTime.GetMilliSeconds()),
 			std::to_string(stats.get(i).TotalRxTime.GetMilliSeconds()),
 			std::to_string(stats.get(i).TotalSleepTime.GetMilliSeconds()),
@@ -174,25 +182,45 @@ void SimulationEventManager::onUpdateStatistics(Statistics& stats) {
 			std::to_string(stats.get(i).EnergyRxIdle),
 			std::to_string(stats.get(i).EnergyTx)
 		});
+		lines << line.str();
+		sendToVisualizer(line.str());
 	}
+	writeToFile(lines.str());
 }
 
-void SimulationEventManager::send(vector<string> str) {
+bool SimulationEventManager::hasOutput() const {
+	return (this->filename != "" && this->filename != "none")
+			|| (this->hostname != "" && this->hostname != "none");
+}
 
-	std::stringstream s;
+void SimulationEventManager::format(std::stringstream& s, const vector<string>& str) {
 	s << Simulator::Now().GetNanoSeconds() << ";";
 	for(uint32_t i = 0; i < str.size(); i++) {
 		s << str[i] << ((i != str.size()-1) ? ";" : "");
 	}
 	s << "\n";
+}
+
+void SimulationEventManager::send(vector<string> str) {
+
+	std::stringstream s;
+	format(s, str);
+	writeToFile(s.str());
+	sendToVisualizer(s.str());
+}
+
+void SimulationEventManager::writeToFile(const string& lines) {
 
 	if(this->filename != "" && this->filename != "none") {
 		ofstream fileStream(filename,fstream::out|fstream::app);
 		if(fileStream.is_open())
-			fileStream << s.str();
+			fileStream << lines;
 		// append to file
 		fileStream.close();
 	}
+}
+
+void SimulationEventManager::sendToVisualizer(const string& line) {
 
 	if(this->hostname != "" && this->hostname != "none") {
 
@@ -204,7 +232,7 @@ void SimulationEventManager::send(vector<string> str) {
 				return;
 		}
 
-		bool success = stat_send(socketDescriptor, string(s.str()).c_str());
+		bool success = stat_send(socketDescriptor, line.c_str());
 
 		if(!success) {
 			std::cout << "Sending failed" << std::endl;
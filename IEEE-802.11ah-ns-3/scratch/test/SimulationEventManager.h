@@ -28,6 +28,13 @@ private:
 	int socketDescriptor = -1;
 
 	void send(vector<string> str);
+	// appends one line of values to the buffer, without sending it
+	void format(std::stringstream& s, const vector<string>& str);
+	// appends the buffered lines to the nss file at once
+	void writeToFile(const string& lines);
+	// sends one line to the visualizer
+	void sendToVisualizer(const string& line);
+	bool hasOutput() const;
 
 public:
 	SimulationEventManager();
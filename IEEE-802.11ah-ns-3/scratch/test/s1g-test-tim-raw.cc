@@ -78,45 +78,12 @@ uint32_t GetAssocNum() {
 }
 
 void PopulateArpCache() {
-	Ptr<ArpCache> arp = CreateObject<ArpCache>();
-	arp->SetAliveTimeout(Seconds(3600 * 24 * 365));
-	for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); ++i) {
-		Ptr<Ipv4L3Protocol> ip = (*i)->GetObject<Ipv4L3Protocol>();
-		NS_ASSERT(ip != 0);
-		ObjectVectorValue interfaces;
-		ip->GetAttribute("InterfaceList", interfaces);
-		for (ObjectVectorValue::Iterator j = interfaces.Begin();
-				j != interfaces.End(); j++) {
-			Ptr<Ipv4Interface> ipIface =
-					(j->second)->GetObject<Ipv4Interface>();
-			NS_ASSERT(ipIface != 0);
-			Ptr<NetDevice> device = ipIface->GetDevice();
-			NS_ASSERT(device != 0);
-			Mac48Address addr = Mac48Address::ConvertFrom(device->GetAddress());
-			for (uint32_t k = 0; k < ipIface->GetNAddresses(); k++) {
-				Ipv4Address ipAddr = ipIface->GetAddress(k).GetLocal();
-				if (ipAddr == Ipv4Address::GetLoopback())
-					continue;
-				ArpCache::Entry * entry = arp->Add(ipAddr);
-				entry->MarkWaitReply(0);
-				entry->MarkAlive(addr);
-				std::cout << "Arp Cache: Adding the pair (" << addr << ","
-						<< ipAddr << ")" << std::endl;
-			}
-		}
-	}
-	for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); ++i) {
-		Ptr<Ipv4L3Protocol> ip = (*i)->GetObject<Ipv4L3Protocol>();
-		NS_ASSERT(ip != 0);
-		ObjectVectorValue interfaces;
-		ip->GetAttribute("InterfaceList", interfaces);
-		for (ObjectVectorValue::Iterator j = interfaces.Begin();
-				j != interfaces.End(); j++) {
-			Ptr<Ipv4Interface> ipIface =
-					(j->second)->GetObject<Ipv4Interface>();
-			ipIface->SetAttribute("ArpCache", PointerValue(arp));
-		}
-	}
+	// all the nodes share a single table, so that setting it up takes
+	// linear time and memory in the number of nodes
+	ArpTableHelper arp;
+	Ptr<SharedArpTable> table = arp.InstallAll();
+	std::cout << "Arp Cache: " << table->GetN() << " addresses shared by "
+			<< NodeList::GetNNodes() << " nodes" << std::endl;
 }
 
 uint16_t ngroup;
@@ -386,6 +353,35 @@ void RawSlotTrace(uint8_t oldValue, uint8_t newValue) {
 void configureNodes(NodeContainer& wifiStaNode, NetDeviceContainer& staDevice) {
 	cout << "Configuring STA Node trace sources..." << endl;
 
+	// The paths are compiled once and resolved from each node, instead of
+	// parsing a "/NodeList/<i>/..." string for every trace source of every node
+	const std::string staMac =
+			"/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/";
+	const std::string phy = "/DeviceList/0/$ns3::WifiNetDevice/Phy/";
+	const std::string stationManager =
+			"/DeviceList/0/$ns3::WifiNetDevice/RemoteStationManager/";
+	Config::CompiledPath assoc(staMac + "Assoc");
+	Config::CompiledPath deAssoc(staMac + "DeAssoc");
+	Config::CompiledPath nrOfTransmissionsDuringRawSlot(
+			staMac + "NrOfTransmissionsDuringRAWSlot");
+	Config::CompiledPath packetDropped(staMac + "PacketDropped");
+	Config::CompiledPath collision(staMac + "Collision");
+	Config::CompiledPath transmissionWillCrossRawBoundary(
+			staMac + "TransmissionWillCrossRAWBoundary");
+	Config::CompiledPath phyTxBegin(phy + "PhyTxBegin");
+	Config::CompiledPath phyTxEnd(phy + "PhyTxEnd");
+	Config::CompiledPath phyTxDrop(phy + "PhyTxDropWithReason");
+	Config::CompiledPath phyRxBegin(phy + "PhyRxBegin");
+	Config::CompiledPath phyRxEnd(phy + "PhyRxEnd");
+	Config::CompiledPath phyRxDrop(phy + "PhyRxDropWithReason");
+	Config::CompiledPath macTxRtsFailed(stationManager + "MacTxRtsFailed");
+	Config::CompiledPath macTxDataFailed(stationManager + "MacTxDataFailed");
+	Config::CompiledPath macTxFinalRtsFailed(
+			stationManager + "MacTxFinalRtsFailed");
+	Config::CompiledPath macTxFinalDataFailed(
+			stationManager + "MacTxFinalDataFailed");
+	Config::CompiledPath phyState(phy + "State/State");
+
 	for (uint32_t i = 0; i < config.Nsta; i++) {
 
 		cout << "Hooking up trace sources for STA " << i << endl;
@@ -397,88 +393,58 @@ void configureNodes(NodeContainer& wifiStaNode, NetDeviceContainer& staDevice) {
 		n->SetDeassociatedCallback([ = ] {onSTADeassociated(i);});
 
 		nodes.push_back(n);
+
+		Ptr<Node> node = NodeList::GetNode(i);
+		std::string nodePath = "/NodeList/" + std::to_string(i);
+
 		// hook up Associated and Deassociated events
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/Assoc",
+		assoc.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::SetAssociation, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/DeAssoc",
+		deAssoc.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::UnsetAssociation, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/NrOfTransmissionsDuringRAWSlot",
+		nrOfTransmissionsDuringRawSlot.Connect(node, nodePath,
 				MakeCallback(
 						&NodeEntry::OnNrOfTransmissionsDuringRAWSlotChanged,
 						n));	//not implem
 
 		//Config::Connect("/NodeList/" + std::to_string(i) + "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/S1gBeaconMissed", MakeCallback(&NodeEntry::OnS1gBeaconMissed, n));
 
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/PacketDropped",
+		packetDropped.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnMacPacketDropped, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/Collision",
+		collision.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnCollision, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/TransmissionWillCrossRAWBoundary",
+		transmissionWillCrossRawBoundary.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnTransmissionWillCrossRAWBoundary,
 						n)); //?
 
 		// hook up TX
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyTxBegin",
+		phyTxBegin.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnPhyTxBegin, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyTxEnd",
+		phyTxEnd.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnPhyTxEnd, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyTxDropWithReason",
+		phyTxDrop.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnPhyTxDrop, n)); //?
 
 		// hook up RX
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyRxBegin",
+		phyRxBegin.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnPhyRxBegin, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyRxEnd",
+		phyRxEnd.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnPhyRxEnd, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyRxDropWithReason",
+		phyRxDrop.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnPhyRxDrop, n));
 
 		// hook up MAC traces
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/RemoteStationManager/MacTxRtsFailed",
+		macTxRtsFailed.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnMacTxRtsFailed, n)); //?
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/RemoteStationManager/MacTxDataFailed",
+		macTxDataFailed.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnMacTxDataFailed, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/RemoteStationManager/MacTxFinalRtsFailed",
+		macTxFinalRtsFailed.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnMacTxFinalRtsFailed, n)); //?
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/RemoteStationManager/MacTxFinalDataFailed",
+		macTxFinalDataFailed.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnMacTxFinalDataFailed, n)); //?
 
 		// hook up PHY State change
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/State/State",
+		phyState.Connect(node, nodePath,
 				MakeCallback(&NodeEntry::OnPhyStateChange, n));
 
 	}
@@ -1163,6 +1129,9 @@ int main(int argc, char *argv[]) {
 	//LogComponentEnable ("EdcaTxopN", LOG_DEBUG);
 
 	bool OutputPosition = true;
+	// wall time and heap growth of each setup stage, reported before the run
+	PhaseTimer setupTimer;
+	setupTimer.Start("configuration");
 	config = Configuration(argc, argv);
 
 	config.rps = configureRAW(config.rps, config.RAWConfigFile);
@@ -1200,9 +1169,12 @@ int main(int argc, char *argv[]) {
 
 	RngSeedManager::SetSeed(config.seed);
 
+	setupTimer.Start("nodes");
 	wifiStaNode.Create(config.Nsta);
 	wifiApNode.Create(1);
 
+	setupTimer.Start("wifi devices");
+
 	YansWifiChannelHelper channelBuilder = YansWifiChannelHelper();
 	channelBuilder.AddPropagationLoss("ns3::LogDistancePropagationLossModel",
 			"Exponent", DoubleValue(3.76), "ReferenceLoss", DoubleValue(8.0),
@@ -1300,6 +1272,7 @@ int main(int argc, char *argv[]) {
 	Config::ConnectWithoutContext(oss.str() + "RawSlot", MakeCallback(&RawSlotTrace));
 
 	// mobility.
+	setupTimer.Start("mobility");
 	MobilityHelper mobility;
 	double xpos = std::stoi(config.rho, nullptr, 0);
 	double ypos = xpos;
@@ -1354,10 +1327,12 @@ int main(int argc, char *argv[]) {
 	 */
 
 	/* Internet stack*/
+	setupTimer.Start("internet stack");
 	InternetStackHelper stack;
 	stack.Install(wifiApNode);
 	stack.Install(wifiStaNode);
 
+	setupTimer.Start("ip addresses");
 	Ipv4AddressHelper address;
 
 	address.SetBase("192.168.0.0", "255.255.0.0");
@@ -1366,7 +1341,12 @@ int main(int argc, char *argv[]) {
 	apNodeInterface = address.Assign(apDevice);
 
 	//trace association
+	setupTimer.Start("association traces");
 	std::cout << "Configuring trace sources..." << std::endl;
+	Config::CompiledPath staAssoc(
+			"/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/Assoc");
+	Config::CompiledPath staDeAssoc(
+			"/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/DeAssoc");
 	for (uint16_t kk = 0; kk < config.Nsta; kk++) {
 		std::ostringstream STA;
 		STA << kk;
@@ -1374,23 +1354,23 @@ int main(int argc, char *argv[]) {
 
 		assoc_record *m_assocrecord = new assoc_record;
 		m_assocrecord->setstaid(kk);
-		Config::Connect(
-				"/NodeList/" + strSTA
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/Assoc",
+		staAssoc.Connect(NodeList::GetNode(kk), "/NodeList/" + strSTA,
 				MakeCallback(&assoc_record::SetAssoc, m_assocrecord));
-		Config::Connect(
-				"/NodeList/" + strSTA
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/DeAssoc",
+		staDeAssoc.Connect(NodeList::GetNode(kk), "/NodeList/" + strSTA,
 				MakeCallback(&assoc_record::UnsetAssoc, m_assocrecord));
 		assoc_vector.push_back(m_assocrecord);
 	}
 
-	std::cout << "Populating routing tables..." << std::endl;
-	Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+	// All the nodes are on the same subnet, so that the interface routes
+	// of the static routing are enough. Global routing would compute a
+	// shortest path tree over the whole BSS for every node, which is
+	// quadratic in the number of stations.
+	setupTimer.Start("arp cache");
 	std::cout << "Populating ARP cache..." << std::endl;
 	PopulateArpCache();
 
 	// configure tracing for associations & other metrics
+	setupTimer.Start("trace sinks");
 	std::cout << "Configuring trace sinks for nodes..." << std::endl;
 	configureNodes(wifiStaNode, staDevice);
 
@@ -1424,17 +1404,14 @@ int main(int argc, char *argv[]) {
 	}
 
 	/*Print of the state of the stations*/
-	for (uint32_t i = 0; i < config.Nsta; i++) {
-		std::ostringstream STA;
-		STA << i;
-		std::string strSTA = STA.str();
-
-		Config::Connect(
-				"/NodeList/" + strSTA
-						+ "/DeviceList/*/Phy/$ns3::YansWifiPhy/State/State",
+	if (config.Nsta > 0) {
+		Config::CompiledPath(
+				"/NodeList/[0-" + std::to_string(config.Nsta - 1)
+						+ "]/DeviceList/*/Phy/$ns3::YansWifiPhy/State/State").Connect(
 				MakeCallback(&PhyStateTrace));
 	}
 
+	setupTimer.Start("event manager");
 	eventManager.onStartHeader();
 	eventManager.onStart(config);
 	if (config.rps.rpsset.size() > 0)
@@ -1452,6 +1429,18 @@ int main(int argc, char *argv[]) {
 
 	sendStatistics(true);
 
+	// skip the association storm when it is not studied, the traffic
+	// starts from the Assoc traces either way
+	if (config.bulkAssociation) {
+		setupTimer.Start("association");
+		WifiAssociationHelper association;
+		association.Associate(staDevice, apDevice.Get(0));
+	}
+
+	setupTimer.Stop();
+	std::cout << "Setup time per stage:" << std::endl;
+	setupTimer.Report(std::cout);
+
 	Simulator::Stop(Seconds(config.simulationTime + config.CoolDownPeriod)); // allow up to a minute after the client & server apps are finished to process the queue
 	Simulator::Run();
 
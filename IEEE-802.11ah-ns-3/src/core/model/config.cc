@@ -24,9 +24,12 @@
 #include "object-ptr-container.h"
 #include "names.h"
 #include "pointer.h"
+#include "trace-source-accessor.h"
+#include "simple-ref-count.h"
 #include "log.h"
 
 #include <sstream>
+#include <map>
 
 /**
  * \file
@@ -873,6 +876,730 @@ Ptr<Object> GetRootNamespaceObject (uint32_t i)
   return ConfigImpl::Get ()->GetRootNamespaceObject (i);
 }
 
+/**
+ * \ingroup config
+ * The compiled form of a CompiledPath, shared by its copies.
+ */
+class CompiledPathImpl : public SimpleRefCount<CompiledPathImpl>
+{
+public:
+  /**
+   * Compile a Config path.
+   *
+   * \param [in] path The Config path.
+   */
+  CompiledPathImpl (std::string path);
+
+  /** The objects found while resolving the path. */
+  struct Matches
+  {
+    /**
+     * \param [in] withContext Whether the contexts are needed.
+     */
+    Matches (bool withContext) : withContext (withContext) {}
+    bool withContext;                  //!< Whether the contexts are built.
+    std::vector<Ptr<Object> > objects; //!< The matching objects.
+    std::vector<std::string> contexts; //!< The context of each object.
+  };
+
+  /**
+   * Resolve the path from the root namespace objects and from the
+   * root of the "/Names" name space.
+   *
+   * \param [in,out] matches The objects found.
+   */
+  void ResolveFromRoots (Matches *matches);
+  /**
+   * Resolve the path from an object.
+   *
+   * \param [in] root The object.
+   * \param [in] rootPath The path of \p root.
+   * \param [in,out] matches The objects found.
+   */
+  void ResolveFrom (Ptr<Object> root, std::string rootPath, Matches *matches);
+
+  /**
+   * \param [in] matches Objects found by a resolution.
+   * \param [in] value The value to set to the leaf attribute.
+   */
+  void Set (const Matches &matches, const AttributeValue &value);
+  /**
+   * \param [in] matches Objects found by a resolution with contexts.
+   * \param [in] cb The callback to connect to the leaf trace source.
+   */
+  void Connect (const Matches &matches, const CallbackBase &cb);
+  /**
+   * \param [in] matches Objects found by a resolution.
+   * \param [in] cb The callback to connect to the leaf trace source.
+   */
+  void ConnectWithoutContext (const Matches &matches, const CallbackBase &cb);
+  /**
+   * \param [in] matches Objects found by a resolution with contexts.
+   * \param [in] cb The callback to disconnect from the leaf trace source.
+   */
+  void Disconnect (const Matches &matches, const CallbackBase &cb);
+  /**
+   * \param [in] matches Objects found by a resolution.
+   * \param [in] cb The callback to disconnect from the leaf trace source.
+   */
+  void DisconnectWithoutContext (const Matches &matches, const CallbackBase &cb);
+
+  /** The path as given. */
+  std::string m_path;
+  /** The path without its leaf, as given to MatchContainer. */
+  std::string m_objectPath;
+  /** The last segment of the path. */
+  std::string m_leaf;
+
+private:
+  /** One segment of the path, before the leaf. */
+  struct Element
+  {
+    std::string name;   //!< The segment.
+    bool isGetObject;   //!< Whether the segment is a $TypeId.
+    TypeId tid;         //!< The TypeId of a $TypeId segment.
+    bool matchAll;      //!< Whether the segment is the "*" index.
+    /** The inclusive index ranges of the segment used as an array index. */
+    std::vector<std::pair<uint32_t, uint32_t> > ranges;
+  };
+  /** A pointer or container attribute selected by a segment. */
+  struct Target
+  {
+    std::string name;                              //!< The attribute name.
+    Ptr<const AttributeAccessor> accessor;         //!< The attribute accessor.
+    bool gettable;                                 //!< Whether the attribute can be read.
+    bool isContainer;                              //!< Whether this is an object container.
+    const ObjectPtrContainerAccessor *container;   //!< The container accessor, if it is one.
+  };
+  /** The targets of a segment for each TypeId uid. */
+  typedef std::map<uint16_t, std::vector<Target> > TargetCache;
+
+  /**
+   * Parse a segment as an array index, following ArrayMatcher.
+   *
+   * \param [in] element The segment.
+   * \param [in,out] e The compiled segment.
+   */
+  static void ParseIndexes (std::string element, Element *e);
+  /**
+   * \param [in] str The string.
+   * \param [out] value The location to store the \c uint32_t.
+   * \returns \c true if the string could be converted.
+   */
+  static bool StringToUint32 (std::string str, uint32_t *value);
+  /**
+   * \param [in] e The compiled segment.
+   * \param [in] index An array index.
+   * \returns \c true if the segment selects the index.
+   */
+  static bool MatchesIndex (const Element &e, uint32_t index);
+  /**
+   * \param [in] context The current context.
+   * \param [in] name The next segment.
+   * \param [in] matches The resolution in progress.
+   * \returns The context of the next segment, or an empty string when
+   *          \p matches does not need the contexts.
+   */
+  static std::string Append (const std::string &context, const std::string &name,
+                             const Matches *matches);
+  /**
+   * \param [in] tid The TypeId of an object on the path.
+   * \param [in] i The index of the segment.
+   * \returns The attributes of \p tid selected by the segment.
+   */
+  const std::vector<Target> &LookupTargets (TypeId tid, uint32_t i);
+  /**
+   * Read a pointer or container attribute, failing as
+   * ObjectBase::GetAttribute does.
+   *
+   * \param [in] object The object owning the attribute.
+   * \param [in] target The attribute.
+   * \param [out] value The value of the attribute.
+   */
+  static void GetAttribute (Ptr<Object> object, const Target &target, AttributeValue &value);
+  /**
+   * \param [in] object An object with the leaf trace source.
+   * \returns The trace source accessor, or 0.
+   */
+  Ptr<const TraceSourceAccessor> LookupTraceSource (Ptr<Object> object);
+  /**
+   * Resolve the segments of the path from an object.
+   *
+   * \param [in] object The object reached so far.
+   * \param [in] i The index of the next segment.
+   * \param [in] context The path of \p object.
+   * \param [in,out] matches The objects found.
+   */
+  void Resolve (Ptr<Object> object, uint32_t i, const std::string &context, Matches *matches);
+  /**
+   * Resolve an array index segment.
+   *
+   * \param [in] object The object owning the container attribute.
+   * \param [in] target The container attribute.
+   * \param [in] i The index of the array index segment.
+   * \param [in] context The path of the container.
+   * \param [in,out] matches The objects found.
+   */
+  void ResolveArray (Ptr<Object> object, const Target &target, uint32_t i,
+                     const std::string &context, Matches *matches);
+  /**
+   * Resolve the segments of the path in the root of the "/Names" name space.
+   *
+   * \param [in] i The index of the next segment.
+   * \param [in] context The path resolved so far.
+   * \param [in,out] matches The objects found.
+   */
+  void ResolveNames (uint32_t i, const std::string &context, Matches *matches);
+
+  /** The segments of the path, before the leaf. */
+  std::vector<Element> m_elements;
+  /** The attribute lookups, for each segment. */
+  std::vector<TargetCache> m_targets;
+  /** The leaf trace source lookups, for each TypeId uid. */
+  std::map<uint16_t, Ptr<const TraceSourceAccessor> > m_traceSources;
+};
+
+CompiledPathImpl::CompiledPathImpl (std::string path)
+  : m_path (path)
+{
+  NS_LOG_FUNCTION (this << path);
+
+  // same split as ConfigImpl::ParsePath and same canonical form as Resolver
+  std::string::size_type slash = path.find_last_of ("/");
+  NS_ASSERT (slash != std::string::npos);
+  m_objectPath = path.substr (0, slash);
+  m_leaf = path.substr (slash + 1, path.size () - (slash + 1));
+
+  std::string objectPath = m_objectPath;
+  if (objectPath.find ("/") != 0)
+    {
+      objectPath = "/" + objectPath;
+    }
+  if (objectPath.find_last_of ("/") != objectPath.size () - 1)
+    {
+      objectPath = objectPath + "/";
+    }
+
+  std::string::size_type start = 1;
+  std::string::size_type next;
+  while ((next = objectPath.find ("/", start)) != std::string::npos)
+    {
+      Element e;
+      e.name = objectPath.substr (start, next - start);
+      e.isGetObject = e.name.find ("$") == 0;
+      if (e.isGetObject)
+        {
+          e.tid = TypeId::LookupByName (e.name.substr (1, e.name.size () - 1));
+        }
+      e.matchAll = false;
+      ParseIndexes (e.name, &e);
+      m_elements.push_back (e);
+      start = next + 1;
+    }
+  m_targets.resize (m_elements.size ());
+}
+
+void
+CompiledPathImpl::ParseIndexes (std::string element, Element *e)
+{
+  if (element == "*")
+    {
+      e->matchAll = true;
+      return;
+    }
+  std::string::size_type tmp = element.find ("|");
+  if (tmp != std::string::npos)
+    {
+      ParseIndexes (element.substr (0, tmp), e);
+      ParseIndexes (element.substr (tmp + 1, element.size () - (tmp + 1)), e);
+      return;
+    }
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1 &&
+      dash > leftBracket && dash < rightBracket)
+    {
+      uint32_t min;
+      uint32_t max;
+      if (StringToUint32 (element.substr (leftBracket + 1, dash - (leftBracket + 1)), &min)
+          && StringToUint32 (element.substr (dash + 1, rightBracket - (dash + 1)), &max)
+          && min <= max)
+        {
+          e->ranges.push_back (std::make_pair (min, max));
+        }
+      return;
+    }
+  uint32_t value;
+  if (StringToUint32 (element, &value))
+    {
+      e->ranges.push_back (std::make_pair (value, value));
+    }
+}
+
+bool
+CompiledPathImpl::StringToUint32 (std::string str, uint32_t *value)
+{
+  std::istringstream iss;
+  iss.str (str);
+  iss >> (*value);
+  return !iss.bad () && !iss.fail ();
+}
+
+bool
+CompiledPathImpl::MatchesIndex (const Element &e, uint32_t index)
+{
+  if (e.matchAll)
+    {
+      return true;
+    }
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator i = e.ranges.begin ();
+       i != e.ranges.end (); ++i)
+    {
+      if (index >= i->first && index <= i->second)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+std::string
+CompiledPathImpl::Append (const std::string &context, const std::string &name,
+                          const Matches *matches)
+{
+  if (!matches->withContext)
+    {
+      return std::string ();
+    }
+  return context + name + "/";
+}
+
+const std::vector<CompiledPathImpl::Target> &
+CompiledPathImpl::LookupTargets (TypeId tid, uint32_t i)
+{
+  TargetCache &cache = m_targets[i];
+  TargetCache::const_iterator found = cache.find (tid.GetUid ());
+  if (found != cache.end ())
+    {
+      return found->second;
+    }
+
+  NS_LOG_DEBUG ("looking up " << m_elements[i].name << " in " << tid.GetName ());
+  std::vector<Target> &targets = cache[tid.GetUid ()];
+  const std::string &item = m_elements[i].name;
+  // same walk as Resolver::DoResolve: every matching attribute of the
+  // TypeId and of its parents, read through its name like
+  // ObjectBase::GetAttribute, which finds the most derived one
+  TypeId instanceTid = tid;
+  TypeId nextTid = tid;
+  do
+    {
+      tid = nextTid;
+      for (uint32_t j = 0; j < tid.GetAttributeN (); j++)
+        {
+          struct TypeId::AttributeInformation info = tid.GetAttribute (j);
+          if (info.name != item && item != "*")
+            {
+              continue;
+            }
+          bool isPointer = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0;
+          bool isContainer = dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0;
+          if (!isPointer && !isContainer)
+            {
+              continue;
+            }
+          struct TypeId::AttributeInformation read;
+          bool found = instanceTid.LookupAttributeByName (info.name, &read);
+          NS_ASSERT (found);
+          Target target;
+          target.name = info.name;
+          target.accessor = read.accessor;
+          target.gettable = (read.flags & TypeId::ATTR_GET) && read.accessor->HasGetter ();
+          target.isContainer = isContainer;
+          target.container = 0;
+          if (isContainer)
+            {
+              target.container = dynamic_cast<const ObjectPtrContainerAccessor *> (PeekPointer (read.accessor));
+            }
+          targets.push_back (target);
+        }
+      nextTid = tid.GetParent ();
+    } while (nextTid != tid);
+  return targets;
+}
+
+void
+CompiledPathImpl::GetAttribute (Ptr<Object> object, const Target &target, AttributeValue &value)
+{
+  if (!target.gettable)
+    {
+      NS_FATAL_ERROR ("Attribute name=" << target.name << " is not gettable for this object: tid="
+                                        << object->GetInstanceTypeId ().GetName ());
+    }
+  if (!target.accessor->Get (PeekPointer (object), value))
+    {
+      NS_FATAL_ERROR ("Attribute name=" << target.name << " tid=" << object->GetInstanceTypeId ().GetName ()
+                                        << ": could not get value");
+    }
+}
+
+Ptr<const TraceSourceAccessor>
+CompiledPathImpl::LookupTraceSource (Ptr<Object> object)
+{
+  TypeId tid = object->GetInstanceTypeId ();
+  std::map<uint16_t, Ptr<const TraceSourceAccessor> >::const_iterator found =
+    m_traceSources.find (tid.GetUid ());
+  if (found != m_traceSources.end ())
+    {
+      return found->second;
+    }
+  Ptr<const TraceSourceAccessor> accessor = tid.LookupTraceSourceByName (m_leaf);
+  m_traceSources[tid.GetUid ()] = accessor;
+  return accessor;
+}
+
+void
+CompiledPathImpl::Resolve (Ptr<Object> object, uint32_t i, const std::string &context, Matches *matches)
+{
+  if (i == m_elements.size ())
+    {
+      matches->objects.push_back (object);
+      if (matches->withContext)
+        {
+          matches->contexts.push_back (context);
+        }
+      return;
+    }
+  const Element &e = m_elements[i];
+
+  // as in Resolver::DoResolve, a named object takes precedence
+  Ptr<Object> namedObject = Names::Find<Object> (object, e.name);
+  if (namedObject)
+    {
+      Resolve (namedObject, i + 1, Append (context, e.name, matches), matches);
+      return;
+    }
+
+  if (e.isGetObject)
+    {
+      Ptr<Object> aggregated = object->GetObject<Object> (e.tid);
+      if (aggregated)
+        {
+          Resolve (aggregated, i + 1, Append (context, e.name, matches), matches);
+        }
+      return;
+    }
+
+  const std::vector<Target> &targets = LookupTargets (object->GetInstanceTypeId (), i);
+  for (std::vector<Target>::const_iterator t = targets.begin (); t != targets.end (); ++t)
+    {
+      if (t->isContainer)
+        {
+          ResolveArray (object, *t, i + 1, Append (context, t->name, matches), matches);
+          continue;
+        }
+      PointerValue ptr;
+      GetAttribute (object, *t, ptr);
+      Ptr<Object> next = ptr.Get<Object> ();
+      if (next == 0)
+        {
+          NS_LOG_ERROR ("Requested object name=\"" << e.name <<
+                        "\" exists on path=\"" << context << "\" but is null.");
+          continue;
+        }
+      Resolve (next, i + 1, Append (context, t->name, matches), matches);
+    }
+}
+
+void
+CompiledPathImpl::ResolveArray (Ptr<Object> object, const Target &target, uint32_t i,
+                                const std::string &context, Matches *matches)
+{
+  if (i == m_elements.size ())
+    {
+      return;
+    }
+  const Element &e = m_elements[i];
+
+  if (target.container != 0 && target.gettable && !e.matchAll && e.ranges.size () == 1
+      && e.ranges[0].first == e.ranges[0].second)
+    {
+      // a single index: fetch that element only, if it is at the
+      // position of the same number (always the case for vectors).
+      uint32_t wanted = e.ranges[0].first;
+      uint32_t n;
+      if (target.container->GetN (PeekPointer (object), &n) && wanted < n)
+        {
+          uint32_t index;
+          Ptr<Object> element = target.container->Get (PeekPointer (object), wanted, &index);
+          if (index == wanted)
+            {
+              Resolve (element, i + 1, Append (context, e.name, matches), matches);
+              return;
+            }
+        }
+    }
+
+  ObjectPtrContainerValue container;
+  GetAttribute (object, target, container);
+  for (ObjectPtrContainerValue::Iterator it = container.Begin (); it != container.End (); ++it)
+    {
+      if (!MatchesIndex (e, (*it).first))
+        {
+          continue;
+        }
+      std::string next;
+      if (matches->withContext)
+        {
+          std::ostringstream oss;
+          oss << (*it).first;
+          next = Append (context, oss.str (), matches);
+        }
+      Resolve ((*it).second, i + 1, next, matches);
+    }
+}
+
+void
+CompiledPathImpl::ResolveNames (uint32_t i, const std::string &context, Matches *matches)
+{
+  if (i == m_elements.size ())
+    {
+      return;
+    }
+  const Element &e = m_elements[i];
+  // Resolver::DoResolve tests whether the rest of the path starts with "/Names"
+  if (e.name.compare (0, 5, "Names") == 0)
+    {
+      ResolveNames (i + 1, Append (context, e.name, matches), matches);
+      return;
+    }
+  Ptr<Object> namedObject = Names::Find<Object> (Ptr<Object> (0), e.name);
+  if (namedObject)
+    {
+      Resolve (namedObject, i + 1, Append (context, e.name, matches), matches);
+    }
+}
+
+void
+CompiledPathImpl::ResolveFromRoots (Matches *matches)
+{
+  NS_LOG_FUNCTION (this << m_path);
+  for (uint32_t i = 0; i < GetRootNamespaceObjectN (); i++)
+    {
+      Resolve (GetRootNamespaceObject (i), 0, "/", matches);
+    }
+  ResolveNames (0, "/", matches);
+}
+
+void
+CompiledPathImpl::ResolveFrom (Ptr<Object> root, std::string rootPath, Matches *matches)
+{
+  NS_LOG_FUNCTION (this << m_path << root << rootPath);
+  if (matches->withContext && (rootPath.empty () || rootPath[rootPath.size () - 1] != '/'))
+    {
+      rootPath = rootPath + "/";
+    }
+  Resolve (root, 0, rootPath, matches);
+}
+
+void
+CompiledPathImpl::Set (const Matches &matches, const AttributeValue &value)
+{
+  for (std::vector<Ptr<Object> >::const_iterator i = matches.objects.begin ();
+       i != matches.objects.end (); ++i)
+    {
+      (*i)->SetAttribute (m_leaf, value);
+    }
+}
+
+void
+CompiledPathImpl::Connect (const Matches &matches, const CallbackBase &cb)
+{
+  NS_ASSERT (matches.objects.size () == matches.contexts.size ());
+  for (uint32_t i = 0; i < matches.objects.size (); i++)
+    {
+      Ptr<const TraceSourceAccessor> accessor = LookupTraceSource (matches.objects[i]);
+      if (accessor != 0)
+        {
+          accessor->Connect (PeekPointer (matches.objects[i]), matches.contexts[i] + m_leaf, cb);
+        }
+    }
+}
+
+void
+CompiledPathImpl::ConnectWithoutContext (const Matches &matches, const CallbackBase &cb)
+{
+  for (std::vector<Ptr<Object> >::const_iterator i = matches.objects.begin ();
+       i != matches.objects.end (); ++i)
+    {
+      Ptr<const TraceSourceAccessor> accessor = LookupTraceSource (*i);
+      if (accessor != 0)
+        {
+          accessor->ConnectWithoutContext (PeekPointer (*i), cb);
+        }
+    }
+}
+
+void
+CompiledPathImpl::Disconnect (const Matches &matches, const CallbackBase &cb)
+{
+  NS_ASSERT (matches.objects.size () == matches.contexts.size ());
+  for (uint32_t i = 0; i < matches.objects.size (); i++)
+    {
+      Ptr<const TraceSourceAccessor> accessor = LookupTraceSource (matches.objects[i]);
+      if (accessor != 0)
+        {
+          accessor->Disconnect (PeekPointer (matches.objects[i]), matches.contexts[i] + m_leaf, cb);
+        }
+    }
+}
+
+void
+CompiledPathImpl::DisconnectWithoutContext (const Matches &matches, const CallbackBase &cb)
+{
+  for (std::vector<Ptr<Object> >::const_iterator i = matches.objects.begin ();
+       i != matches.objects.end (); ++i)
+    {
+      Ptr<const TraceSourceAccessor> accessor = LookupTraceSource (*i);
+      if (accessor != 0)
+        {
+          accessor->DisconnectWithoutContext (PeekPointer (*i), cb);
+        }
+    }
+}
+
+CompiledPath::CompiledPath ()
+  : m_impl (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+CompiledPath::CompiledPath (std::string path)
+  : m_impl (Create<CompiledPathImpl> (path))
+{
+  NS_LOG_FUNCTION (this << path);
+}
+CompiledPath::CompiledPath (const CompiledPath &o)
+  : m_impl (o.m_impl)
+{
+  NS_LOG_FUNCTION (this << &o);
+}
+CompiledPath &
+CompiledPath::operator = (const CompiledPath &o)
+{
+  NS_LOG_FUNCTION (this << &o);
+  m_impl = o.m_impl;
+  return *this;
+}
+CompiledPath::~CompiledPath ()
+{
+  NS_LOG_FUNCTION (this);
+}
+std::string
+CompiledPath::GetPath (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_impl != 0);
+  return m_impl->m_path;
+}
+std::string
+CompiledPath::GetLeaf (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_impl != 0);
+  return m_impl->m_leaf;
+}
+MatchContainer
+CompiledPath::LookupMatches (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_impl != 0);
+  CompiledPathImpl::Matches matches (true);
+  m_impl->ResolveFromRoots (&matches);
+  return MatchContainer (matches.objects, matches.contexts, m_impl->m_objectPath);
+}
+MatchContainer
+CompiledPath::LookupMatches (Ptr<Object> root, std::string rootPath) const
+{
+  NS_LOG_FUNCTION (this << root << rootPath);
+  NS_ASSERT (m_impl != 0);
+  CompiledPathImpl::Matches matches (true);
+  m_impl->ResolveFrom (root, rootPath, &matches);
+  return MatchContainer (matches.objects, matches.contexts, m_impl->m_objectPath);
+}
+void
+CompiledPath::Set (const AttributeValue &value) const
+{
+  NS_LOG_FUNCTION (this << &value);
+  NS_ASSERT (m_impl != 0);
+  CompiledPathImpl::Matches matches (false);
+  m_impl->ResolveFromRoots (&matches);
+  m_impl->Set (matches, value);
+}
+void
+CompiledPath::Connect (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  NS_ASSERT (m_impl != 0);
+  CompiledPathImpl::Matches matches (true);
+  m_impl->ResolveFromRoots (&matches);
+  m_impl->Connect (matches, cb);
+}
+void
+CompiledPath::ConnectWithoutContext (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  NS_ASSERT (m_impl != 0);
+  CompiledPathImpl::Matches matches (false);
+  m_impl->ResolveFromRoots (&matches);
+  m_impl->ConnectWithoutContext (matches, cb);
+}
+void
+CompiledPath::Disconnect (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  NS_ASSERT (m_impl != 0);
+  CompiledPathImpl::Matches matches (true);
+  m_impl->ResolveFromRoots (&matches);
+  m_impl->Disconnect (matches, cb);
+}
+void
+CompiledPath::DisconnectWithoutContext (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  NS_ASSERT (m_impl != 0);
+  CompiledPathImpl::Matches matches (false);
+  m_impl->ResolveFromRoots (&matches);
+  m_impl->DisconnectWithoutContext (matches, cb);
+}
+void
+CompiledPath::Set (Ptr<Object> root, const AttributeValue &value) const
+{
+  NS_LOG_FUNCTION (this << root << &value);
+  NS_ASSERT (m_impl != 0);
+  CompiledPathImpl::Matches matches (false);
+  m_impl->ResolveFrom (root, "", &matches);
+  m_impl->Set (matches, value);
+}
+void
+CompiledPath::Connect (Ptr<Object> root, std::string rootPath, const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << root << rootPath << &cb);
+  NS_ASSERT (m_impl != 0);
+  CompiledPathImpl::Matches matches (true);
+  m_impl->ResolveFrom (root, rootPath, &matches);
+  m_impl->Connect (matches, cb);
+}
+void
+CompiledPath::ConnectWithoutContext (Ptr<Object> root, const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << root << &cb);
+  NS_ASSERT (m_impl != 0);
+  CompiledPathImpl::Matches matches (false);
+  m_impl->ResolveFrom (root, "", &matches);
+  m_impl->ConnectWithoutContext (matches, cb);
+}
+
 } // namespace Config
 
 } // namespace ns3
@@ -250,6 +250,120 @@ private:
   std::string m_path;
 };
 
+class CompiledPathImpl;
+
+/**
+ * \ingroup config
+ * \brief a Config path parsed once, for repeated or large bulk operations.
+ *
+ * Config::Set and Config::Connect parse their path string on every call
+ * and look up every $ns3::TypeId segment and every attribute by name on
+ * every object they walk through. A CompiledPath splits the path and
+ * looks up the TypeIds once when it is constructed, and remembers the
+ * attribute and trace source lookups done for each TypeId it meets.
+ * A plain numeric index into an object vector attribute (such as
+ * "/NodeList/12") fetches that single element instead of building the
+ * whole container.
+ *
+ * The path has the same syntax and matches the same objects as with
+ * Config::Connect: the last segment is the attribute or trace source
+ * name, the segments before it select the objects. The methods taking
+ * a root object resolve the path starting at that object instead of at
+ * the root namespace objects, which allows one compiled path such as
+ * "/DeviceList/0/Phy/PhyTxBegin" to be connected on many nodes.
+ *
+ * Copies of a CompiledPath share the same compiled state.
+ */
+class CompiledPath
+{
+public:
+  CompiledPath ();
+  /**
+   * \param [in] path The Config path to compile.
+   */
+  CompiledPath (std::string path);
+  /** Copy constructor. */
+  CompiledPath (const CompiledPath &o);
+  /**
+   * Assignment operator.
+   * \param [in] o The CompiledPath to copy.
+   * \returns This CompiledPath.
+   */
+  CompiledPath &operator = (const CompiledPath &o);
+  ~CompiledPath ();
+
+  /**
+   * \returns The path this object was compiled from.
+   */
+  std::string GetPath (void) const;
+  /**
+   * \returns The last segment of the path, i.e., the name of the
+   *          attribute or trace source.
+   */
+  std::string GetLeaf (void) const;
+
+  /**
+   * \returns The objects which own the attribute or trace source named
+   *          by the path.
+   */
+  MatchContainer LookupMatches (void) const;
+  /**
+   * \param [in] root The object to start the resolution from.
+   * \param [in] rootPath The path of \p root, used to build the contexts.
+   * \returns The objects below \p root which own the attribute or trace
+   *          source named by the path.
+   */
+  MatchContainer LookupMatches (Ptr<Object> root, std::string rootPath) const;
+
+  /**
+   * \param [in] value The value to set in all matching attributes.
+   * \sa Config::Set
+   */
+  void Set (const AttributeValue &value) const;
+  /**
+   * \param [in] cb The callback to connect to the matching trace sources.
+   * \sa Config::Connect
+   */
+  void Connect (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The callback to connect to the matching trace sources.
+   * \sa Config::ConnectWithoutContext
+   */
+  void ConnectWithoutContext (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The callback to disconnect from the matching trace sources.
+   * \sa Config::Disconnect
+   */
+  void Disconnect (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The callback to disconnect from the matching trace sources.
+   * \sa Config::DisconnectWithoutContext
+   */
+  void DisconnectWithoutContext (const CallbackBase &cb) const;
+
+  /**
+   * \param [in] root The object to start the resolution from.
+   * \param [in] value The value to set in all matching attributes.
+   */
+  void Set (Ptr<Object> root, const AttributeValue &value) const;
+  /**
+   * \param [in] root The object to start the resolution from.
+   * \param [in] rootPath The path of \p root, used to build the context
+   *             given to \p cb.
+   * \param [in] cb The callback to connect to the matching trace sources.
+   */
+  void Connect (Ptr<Object> root, std::string rootPath, const CallbackBase &cb) const;
+  /**
+   * \param [in] root The object to start the resolution from.
+   * \param [in] cb The callback to connect to the matching trace sources.
+   */
+  void ConnectWithoutContext (Ptr<Object> root, const CallbackBase &cb) const;
+
+private:
+  /** The compiled path, shared between copies. */
+  Ptr<CompiledPathImpl> m_impl;
+};
+
 /**
  * \ingroup config
  * \param [in] path The path to perform a match against
@@ -82,6 +82,11 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
   // loop over the inheritance tree back to the Object base class.
   NS_LOG_FUNCTION (this << &attributes);
   TypeId tid = GetInstanceTypeId ();
+#ifdef HAVE_GETENV
+  // read once per object rather than once per attribute: objects are
+  // created by the thousands when setting up large topologies.
+  char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
+#endif /* HAVE_GETENV */
   do {
       // loop over all attributes in object type
       NS_LOG_DEBUG ("construct tid="<<tid.GetName ()<<", params="<<tid.GetAttributeN ());
@@ -128,7 +133,6 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
             {
               // No matching attribute value so we try to look at the env var.
 #ifdef HAVE_GETENV
-              char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
               if (envVar != 0)
                 {
                   std::string env = std::string (envVar);
@@ -123,7 +123,8 @@ ObjectPtrContainerAccessor::Get (const ObjectBase * object, AttributeValue &valu
     {
       uint32_t index;
       Ptr<Object> o = DoGet (object, i, &index);
-      v->m_objects.insert (std::pair <uint32_t, Ptr<Object> > (index, o));
+      // indexes usually come in increasing order: hint the insertion at the end
+      v->m_objects.insert (v->m_objects.end (), std::pair <uint32_t, Ptr<Object> > (index, o));
     }
   return true;
 }
@@ -139,5 +140,17 @@ ObjectPtrContainerAccessor::HasSetter (void) const
   NS_LOG_FUNCTION (this);
   return false;
 }
+bool
+ObjectPtrContainerAccessor::GetN (const ObjectBase *object, uint32_t *n) const
+{
+  NS_LOG_FUNCTION (this << object << n);
+  return DoGetN (object, n);
+}
+Ptr<Object>
+ObjectPtrContainerAccessor::Get (const ObjectBase *object, uint32_t i, uint32_t *index) const
+{
+  NS_LOG_FUNCTION (this << object << i << index);
+  return DoGet (object, i, index);
+}
 
 } // name
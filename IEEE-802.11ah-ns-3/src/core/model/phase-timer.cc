@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "phase-timer.h"
+#include "assert.h"
+#include "log.h"
+
+#include <iomanip>
+#include <algorithm>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/**
+ * \file
+ * \ingroup system
+ * ns3::PhaseTimer implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PhaseTimer");
+
+PhaseTimer::PhaseTimer ()
+  : m_heap (0),
+    m_running (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+PhaseTimer::Start (std::string name)
+{
+  NS_LOG_FUNCTION (this << name);
+  Stop ();
+  m_current = name;
+  m_running = true;
+  m_heap = GetHeapUsage ();
+  m_clock.Start ();
+}
+
+void
+PhaseTimer::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_running)
+    {
+      return;
+    }
+  Phase phase;
+  phase.name = m_current;
+  phase.elapsed = m_clock.End ();
+  phase.heap = GetHeapUsage () - m_heap;
+  m_phases.push_back (phase);
+  m_running = false;
+  NS_LOG_INFO (phase.name << ": " << phase.elapsed << " ms, " << phase.heap << " bytes");
+}
+
+uint32_t
+PhaseTimer::GetN (void) const
+{
+  return m_phases.size ();
+}
+
+std::string
+PhaseTimer::GetName (uint32_t i) const
+{
+  NS_ASSERT (i < m_phases.size ());
+  return m_phases[i].name;
+}
+
+int64_t
+PhaseTimer::GetElapsedReal (uint32_t i) const
+{
+  NS_ASSERT (i < m_phases.size ());
+  return m_phases[i].elapsed;
+}
+
+int64_t
+PhaseTimer::GetHeapGrowth (uint32_t i) const
+{
+  NS_ASSERT (i < m_phases.size ());
+  return m_phases[i].heap;
+}
+
+int64_t
+PhaseTimer::GetTotalElapsedReal (void) const
+{
+  int64_t total = 0;
+  for (std::vector<Phase>::const_iterator i = m_phases.begin (); i != m_phases.end (); ++i)
+    {
+      total += i->elapsed;
+    }
+  return total;
+}
+
+void
+PhaseTimer::Report (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this << &os);
+  std::string::size_type width = 5;
+  for (std::vector<Phase>::const_iterator i = m_phases.begin (); i != m_phases.end (); ++i)
+    {
+      width = std::max (width, i->name.size ());
+    }
+  int64_t heap = 0;
+  for (std::vector<Phase>::const_iterator i = m_phases.begin (); i != m_phases.end (); ++i)
+    {
+      os << std::left << std::setw (width) << i->name << std::right
+         << std::setw (10) << i->elapsed << " ms";
+      if (HasHeapUsage ())
+        {
+          os << std::setw (14) << i->heap / 1024 << " KiB";
+        }
+      os << std::endl;
+      heap += i->heap;
+    }
+  os << std::left << std::setw (width) << "total" << std::right
+     << std::setw (10) << GetTotalElapsedReal () << " ms";
+  if (HasHeapUsage ())
+    {
+      os << std::setw (14) << heap / 1024 << " KiB";
+    }
+  os << std::endl;
+}
+
+bool
+PhaseTimer::HasHeapUsage (void)
+{
+#ifdef __GLIBC__
+  return true;
+#else
+  return false;
+#endif
+}
+
+int64_t
+PhaseTimer::GetHeapUsage (void)
+{
+#if defined (__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  struct mallinfo2 info = mallinfo2 ();
+  return static_cast<int64_t> (info.uordblks) + static_cast<int64_t> (info.hblkhd);
+#elif defined (__GLIBC__)
+  // older versions only have int fields, read as unsigned to reach 4 GiB
+  struct mallinfo info = mallinfo ();
+  return static_cast<int64_t> (static_cast<uint32_t> (info.uordblks))
+         + static_cast<int64_t> (static_cast<uint32_t> (info.hblkhd));
+#else
+  return 0;
+#endif
+}
+
+} // namespace ns3
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PHASE_TIMER_H
+#define PHASE_TIMER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <ostream>
+#include "system-wall-clock-ms.h"
+#include "non-copyable.h"
+
+/**
+ * \file
+ * \ingroup system
+ * ns3::PhaseTimer declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup system
+ * \brief Measure the wall clock time and the heap growth of the
+ * consecutive phases of a program.
+ *
+ * This is meant to find out where the setup of a large scenario spends
+ * its time before the first event is run:
+ *
+ * \code
+ *   PhaseTimer timer;
+ *   timer.Start ("create nodes");
+ *   ...
+ *   timer.Start ("install devices"); // ends "create nodes"
+ *   ...
+ *   timer.Stop ();
+ *   timer.Report (std::cout);
+ * \endcode
+ *
+ * The heap growth is the change in the number of bytes allocated from
+ * the C library allocator during the phase. It is only available with
+ * the GNU C library; elsewhere it is reported as zero.
+ */
+class PhaseTimer : private NonCopyable
+{
+public:
+  PhaseTimer ();
+
+  /**
+   * End the current phase, if any, and start a new one.
+   *
+   * \param [in] name The name of the new phase.
+   */
+  void Start (std::string name);
+  /**
+   * End the current phase, if any.
+   */
+  void Stop (void);
+
+  /**
+   * \returns The number of phases ended so far.
+   */
+  uint32_t GetN (void) const;
+  /**
+   * \param [in] i The index of an ended phase.
+   * \returns The name of the phase.
+   */
+  std::string GetName (uint32_t i) const;
+  /**
+   * \param [in] i The index of an ended phase.
+   * \returns The wall clock time spent in the phase, in milliseconds.
+   */
+  int64_t GetElapsedReal (uint32_t i) const;
+  /**
+   * \param [in] i The index of an ended phase.
+   * \returns The number of bytes allocated during the phase, minus the
+   *          number of bytes freed.
+   */
+  int64_t GetHeapGrowth (uint32_t i) const;
+  /**
+   * \returns The total wall clock time of the ended phases, in milliseconds.
+   */
+  int64_t GetTotalElapsedReal (void) const;
+
+  /**
+   * Print one line per ended phase, and the total.
+   *
+   * \param [in] os The output stream.
+   */
+  void Report (std::ostream &os) const;
+
+  /**
+   * \returns Whether the heap usage can be measured on this system.
+   */
+  static bool HasHeapUsage (void);
+
+private:
+  /**
+   * \returns The number of bytes currently allocated from the heap.
+   */
+  static int64_t GetHeapUsage (void);
+
+  /** An ended phase. */
+  struct Phase
+  {
+    std::string name;   //!< The name of the phase.
+    int64_t elapsed;    //!< The wall clock time, in milliseconds.
+    int64_t heap;       //!< The heap growth, in bytes.
+  };
+
+  std::vector<Phase> m_phases;  //!< The ended phases.
+  SystemWallClockMs m_clock;    //!< The clock of the current phase.
+  std::string m_current;        //!< The name of the current phase.
+  int64_t m_heap;               //!< The heap usage at the start of the current phase.
+  bool m_running;               //!< Whether a phase is in progress.
+};
+
+} // namespace ns3
+
+#endif /* PHASE_TIMER_H */
@@ -123,6 +123,16 @@ RandomVariableStream::SetStream (int64_t stream)
     }
   m_stream = stream;
 }
+void
+RandomVariableStream::SetSplitStream (int64_t stream, uint64_t child)
+{
+  NS_LOG_FUNCTION (this << stream << child);
+  NS_ASSERT (stream >= 0);
+  SetStream (stream);
+  RngStream *parent = m_rng;
+  m_rng = new RngStream (parent->Split (child));
+  delete parent;
+}
 int64_t
 RandomVariableStream::GetStream(void) const
 {
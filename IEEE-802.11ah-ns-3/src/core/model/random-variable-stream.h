@@ -118,6 +118,20 @@ public:
    */
   void SetStream (int64_t stream);
 
+  /**
+   * \brief Use a child of a fixed stream number for this RNG stream.
+   *
+   * The child is split from the start of the stream by jumping ahead,
+   * see RngStream::Split, so the objects sharing a stream number, for
+   * example one from RngSeedManager::GetStreamIndex, each get their own
+   * numbers whatever order they are created and drawn in.
+   *
+   * \param [in] stream The fixed stream number to split, which must not
+   *            be -1.
+   * \param [in] child The index of the child.
+   */
+  void SetSplitStream (int64_t stream, uint64_t child);
+
   /**
    * \brief Returns the stream number for this RNG stream.
    * \return The stream number for this RNG stream.
@@ -31,10 +31,17 @@
 #include "system-mutex.h"
 #include "boolean.h"
 #include "enum.h"
+#include "nstime.h"
+#include "uinteger.h"
+#include "integer.h"
 
 
 #include <cmath>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 
 /**
  * \file
@@ -69,6 +76,23 @@ RealtimeSimulatorImpl::GetTypeId (void)
                    TimeValue (Seconds (0.1)),
                    MakeTimeAccessor (&RealtimeSimulatorImpl::m_hardLimit),
                    MakeTimeChecker ())
+    .AddAttribute ("JitterBinWidth",
+                   "The width of the bins of the histogram returned by GetJitterHistogram.",
+                   TimeValue (MicroSeconds (10)),
+                   MakeTimeAccessor (&RealtimeSimulatorImpl::m_jitterBinWidth),
+                   MakeTimeChecker (TimeStep (1)))
+    .AddAttribute ("JitterBinCount",
+                   "The number of bins of the histogram returned by GetJitterHistogram, "
+                   "or zero not to measure the jitter of every event.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&RealtimeSimulatorImpl::m_jitterBinCount),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("CpuAffinity",
+                   "The processor to which the thread calling Run is pinned, "
+                   "or -1 to let the system choose. Only supported on Linux.",
+                   IntegerValue (-1),
+                   MakeIntegerAccessor (&RealtimeSimulatorImpl::m_cpuAffinity),
+                   MakeIntegerChecker<int32_t> (-1))
   ;
   return tid;
 }
@@ -90,6 +114,8 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
+  m_jitterBinCount = 0;
+  m_cpuAffinity = -1;
 
   m_main = SystemThread::Self();
 
@@ -359,7 +385,7 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
     // We check the simulation time against the current real time to make this
     // judgement.
     //
-    if (m_synchronizationMode == SYNC_HARD_LIMIT)
+    if (m_synchronizationMode == SYNC_HARD_LIMIT || !m_jitterHistogram.empty ())
       {
         uint64_t tsFinal = m_synchronizer->GetCurrentRealtime ();
         uint64_t tsJitter;
@@ -373,7 +399,19 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
             tsJitter = m_currentTs - tsFinal;
           }
 
-        if (tsJitter > static_cast<uint64_t>(m_hardLimit.GetTimeStep ()))
+        // still under m_mutex, as GetJitterHistogram reads the bins
+        if (!m_jitterHistogram.empty ())
+          {
+            uint64_t bin = tsJitter / m_jitterBinWidth.GetTimeStep ();
+            if (bin >= m_jitterHistogram.size ())
+              {
+                bin = m_jitterHistogram.size () - 1;
+              }
+            m_jitterHistogram[bin]++;
+          }
+
+        if (m_synchronizationMode == SYNC_HARD_LIMIT
+            && tsJitter > static_cast<uint64_t>(m_hardLimit.GetTimeStep ()))
           {
             NS_FATAL_ERROR ("RealtimeSimulatorImpl::ProcessOneEvent (): "
                             "Hard real-time limit exceeded (jitter = " << tsJitter << ")");
@@ -430,6 +468,35 @@ RealtimeSimulatorImpl::Run (void)
 
   m_stop = false;
   m_running = true;
+  {
+    // GetJitterHistogram may be called from another thread
+    CriticalSection cs (m_mutex);
+    m_jitterHistogram.resize (m_jitterBinCount, 0);
+  }
+
+  if (m_cpuAffinity >= 0)
+    {
+#ifdef __linux__
+      if (m_cpuAffinity >= CPU_SETSIZE)
+        {
+          NS_LOG_WARN ("Processor " << m_cpuAffinity << " is beyond the " << CPU_SETSIZE
+                                    << " processors of a cpu_set_t, the simulation is not pinned");
+        }
+      else
+        {
+          cpu_set_t cpus;
+          CPU_ZERO (&cpus);
+          CPU_SET (m_cpuAffinity, &cpus);
+          if (sched_setaffinity (0, sizeof (cpus), &cpus) != 0)
+            {
+              NS_LOG_WARN ("Could not pin the simulation to processor " << m_cpuAffinity);
+            }
+        }
+#else
+      NS_LOG_WARN ("CpuAffinity is not supported on this system");
+#endif
+    }
+
   m_synchronizer->SetOrigin (m_currentTs);
 
   // Sleep until signalled
@@ -848,4 +915,12 @@ RealtimeSimulatorImpl::GetHardLimit (void) const
   return m_hardLimit;
 }
 
+std::vector<uint64_t>
+RealtimeSimulatorImpl::GetJitterHistogram (void) const
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_mutex);
+  return m_jitterHistogram;
+}
+
 } // namespace ns3
@@ -32,6 +32,7 @@
 #include "system-mutex.h"
 
 #include <list>
+#include <vector>
 
 /**
  * \file
@@ -154,6 +155,18 @@ public:
    */
   Time GetHardLimit (void) const;
 
+  /**
+   * Get the histogram of the distance between the real time at which the
+   * events were run and their simulation time, counted since the start.
+   *
+   * Bin \c i counts the events with a jitter in [i, i+1) times the
+   * JitterBinWidth attribute, and the last bin also counts the larger
+   * ones. It has JitterBinCount bins, none if the attribute is zero.
+   *
+   * \returns The number of events in each bin.
+   */
+  std::vector<uint64_t> GetJitterHistogram (void) const;
+
 private:
   /**
    * Is the simulator running?
@@ -216,6 +229,15 @@ private:
   /** The maximum allowable drift from real-time in SYNC_HARD_LIMIT mode. */
   Time m_hardLimit;
 
+  /** The width of the bins of #m_jitterHistogram. */
+  Time m_jitterBinWidth;
+  /** The number of bins of #m_jitterHistogram, zero to disable it. */
+  uint32_t m_jitterBinCount;
+  /** The jitter histogram, see GetJitterHistogram. Protected by #m_mutex. */
+  std::vector<uint64_t> m_jitterHistogram;
+  /** The processor to run Run on, or -1 to let the system choose. */
+  int32_t m_cpuAffinity;
+
   /** Main SystemThread. */
   SystemThread::ThreadId m_main;
 };
@@ -23,6 +23,9 @@
 #include "integer.h"
 #include "config.h"
 #include "log.h"
+#include "hash.h"
+
+#include <sstream>
 
 /**
  * \file
@@ -40,6 +43,12 @@ NS_LOG_COMPONENT_DEFINE ("RngSeedManager");
  * for automatic assignment.
  */
 static uint64_t g_nextStreamIndex = 0;
+/**
+ * \relates RngSeedManager
+ * The log2 of the number of streams reserved for each key
+ * of RngSeedManager::GetStreamIndex.
+ */
+static const int g_streamBlockBits = 16;
 /**
  * \relates RngSeedManager
  * The random number generator seed number global value.
@@ -99,4 +108,21 @@ uint64_t RngSeedManager::GetNextStreamIndex (void)
   return next;
 }
 
+int64_t
+RngSeedManager::GetStreamIndex (uint32_t nodeId, std::string path)
+{
+  NS_LOG_FUNCTION (nodeId << path);
+  std::ostringstream oss;
+  oss << "/NodeList/" << nodeId << path;
+  // the deterministic streams are added to 2^63, keep the block below it
+  uint64_t block = Hash64 (oss.str ()) >> (g_streamBlockBits + 1);
+  return static_cast<int64_t> (block << g_streamBlockBits);
+}
+
+int64_t
+RngSeedManager::GetStreamBlockSize (void)
+{
+  return static_cast<int64_t> (1) << g_streamBlockBits;
+}
+
 } // namespace ns3
@@ -21,6 +21,7 @@
 #define RNG_SEED_MANAGER_H
 
 #include <stdint.h>
+#include <string>
 
 /**
  * \file
@@ -105,6 +106,36 @@ public:
    */
   static uint64_t GetNextStreamIndex(void);
 
+  /**
+   * Get a fixed stream index derived from a node and an object path.
+   *
+   * Unlike the stream numbers handed out in installation order, the
+   * index only depends on its key, so the objects of a node get the
+   * same streams whatever was installed before them, and a simulation
+   * can be split across processes without changing its results:
+   *
+   * \code
+   *   int64_t stream = RngSeedManager::GetStreamIndex (node->GetId (), "/DeviceList/0");
+   *   device->AssignStreams (stream);
+   * \endcode
+   *
+   * The index is the first of a block of GetStreamBlockSize() streams,
+   * for the objects which use consecutive streams from it. Together
+   * with the run number, which selects the substream, the random
+   * numbers are keyed by (run, node, path).
+   *
+   * \param [in] nodeId The id of the node.
+   * \param [in] path The path of the object in the node, for example
+   *            "/DeviceList/0".
+   * \returns A stream index to pass to AssignStreams().
+   */
+  static int64_t GetStreamIndex (uint32_t nodeId, std::string path);
+  /**
+   * \returns The number of consecutive streams reserved for each key
+   *          of GetStreamIndex().
+   */
+  static int64_t GetStreamBlockSize (void);
+
 };
 
 /** Alias for compatibility. */
@@ -25,6 +25,7 @@
 #include "rng-stream.h"
 #include "fatal-error.h"
 #include "log.h"
+#include "assert.h"
 
 /// \file
 /// \ingroup rngimpl
@@ -388,6 +389,15 @@ RngStream::RngStream(const RngStream& r)
     }
 }
 
+RngStream
+RngStream::Split (uint64_t child) const
+{
+  NS_ASSERT_MSG (child < (1ULL << 26) - 1, "child " << child << " overlaps the next substream");
+  RngStream r (*this);
+  r.AdvanceNthBy (child + 1, 50, r.m_currentState);
+  return r;
+}
+
 void 
 RngStream::AdvanceNthBy (uint64_t nth, int by, double state[6])
 {
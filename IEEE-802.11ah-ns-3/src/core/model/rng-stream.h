@@ -71,6 +71,22 @@ public:
    */
   double RandU01 (void);
 
+  /**
+   * Get a child of this stream.
+   *
+   * Child \p child starts \f$(child + 1) \cdot 2^{50}\f$ numbers ahead of
+   * the current state, by jumping ahead, so the children neither overlap
+   * each other nor the first \f$2^{50}\f$ numbers of this stream, and a
+   * child only depends on this stream and on its index, not on the other
+   * children drawn before it. This lets independent parts of a simulation
+   * draw from the same stream in any order and still get the same numbers.
+   * There is room for \f$2^{26} - 1\f$ children in a substream.
+   *
+   * \param [in] child The index of the child.
+   * \returns The child stream.
+   */
+  RngStream Split (uint64_t child) const;
+
 private:
   /**
    * Advance \p state of the RNG by leaps and bounds.
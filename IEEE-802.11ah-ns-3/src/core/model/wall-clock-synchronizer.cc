@@ -22,6 +22,7 @@
                        // clock_getres: glibc < 2.17, link with librt
 
 #include "log.h"
+#include "boolean.h"
 #include "system-condition.h"
 
 #include "wall-clock-synchronizer.h"
@@ -44,11 +45,18 @@ WallClockSynchronizer::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::WallClockSynchronizer")
     .SetParent<Synchronizer> ()
     .SetGroupName ("Core")
+    .AddAttribute ("BusyWait",
+                   "Spin until the next event is due instead of sleeping for most of the delay. "
+                   "This removes the jitter of the system scheduler at the cost of a busy core.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&WallClockSynchronizer::m_busyWait),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 WallClockSynchronizer::WallClockSynchronizer ()
+  : m_busyWait (false)
 {
   NS_LOG_FUNCTION (this);
 //
@@ -225,7 +233,7 @@ WallClockSynchronizer::DoSynchronize (uint64_t nsCurrent, uint64_t nsDelay)
 //
 // \todo Hardcoded tunable parameter below.
 //
-  if (numberJiffies > 3)
+  if (!m_busyWait && numberJiffies > 3)
     {
       NS_LOG_INFO ("SleepWait for " << numberJiffies * m_jiffy << " ns");
       NS_LOG_INFO ("SleepWait until " << nsCurrent + numberJiffies * m_jiffy 
@@ -191,6 +191,8 @@ protected:
 
   /** Size of the system clock tick, as reported by @c clock_getres, in ns. */
   uint64_t m_jiffy;
+  /** Whether to spin for the whole delay instead of sleeping first. */
+  bool m_busyWait;
   /** Time recorded by DoEventStart. */
   uint64_t m_nsEventStart;
 
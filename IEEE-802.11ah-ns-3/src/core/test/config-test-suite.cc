@@ -721,6 +721,224 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+// ===========================================================================
+// Test that a compiled path matches the same objects as the string path
+// functions, and that it can be resolved from any object.
+// ===========================================================================
+class CompiledPathConfigTestCase : public TestCase
+{
+public:
+  CompiledPathConfigTestCase ();
+  virtual ~CompiledPathConfigTestCase () {}
+
+  void TraceWithPath (std::string path, int16_t old, int16_t newValue) { m_newValue = newValue; m_path = path; }
+
+private:
+  virtual void DoRun (void);
+
+  int16_t m_newValue;
+  std::string m_path;
+};
+
+CompiledPathConfigTestCase::CompiledPathConfigTestCase ()
+  : TestCase ("Check that a compiled path matches the same objects as a Config path")
+{
+}
+
+void
+CompiledPathConfigTestCase::DoRun (void)
+{
+  IntegerValue iv;
+
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+  root->SetNodeA (a);
+  Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject> ();
+  a->SetNodeB (b);
+  std::vector<Ptr<ConfigTestObject> > objects;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      objects.push_back (CreateObject<ConfigTestObject> ());
+      b->AddNodeB (objects[i]);
+    }
+
+  //
+  // The matches of a compiled path, in order and with their contexts, are
+  // the ones of Config::LookupMatches on the path without its leaf.
+  //
+  const char *paths[] = { "/NodeA/NodeB/NodesB/[0-1]|3/Source", "/NodeA/NodeB/NodesB/2/Source",
+                          "/NodeA/NodeB/NodesB/*/Source", "/NodeA/NodeB/NodesB/7/Source",
+                          "/NodeA/*/NodesB/0|2/Source", "/NodeA/NodeB/Source" };
+  for (uint32_t i = 0; i < sizeof (paths) / sizeof (paths[0]); i++)
+    {
+      Config::CompiledPath path (paths[i]);
+      NS_TEST_ASSERT_MSG_EQ (path.GetLeaf (), "Source", "Unexpected leaf for " << paths[i]);
+      Config::MatchContainer compiled = path.LookupMatches ();
+      std::string objectPath = paths[i];
+      Config::MatchContainer expected = Config::LookupMatches (objectPath.substr (0, objectPath.find_last_of ("/")));
+      NS_TEST_ASSERT_MSG_EQ (compiled.GetN (), expected.GetN (), "Unexpected number of matches for " << paths[i]);
+      for (uint32_t j = 0; j < compiled.GetN () && j < expected.GetN (); j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (compiled.Get (j), expected.Get (j), "Unexpected match for " << paths[i]);
+          NS_TEST_ASSERT_MSG_EQ (compiled.GetMatchedPath (j), expected.GetMatchedPath (j),
+                                 "Unexpected context for " << paths[i]);
+        }
+    }
+
+  //
+  // Resolving from an object only finds the objects below it.
+  //
+  Config::CompiledPath single ("/NodeB/NodesB/2/Source");
+  Config::MatchContainer matches = single.LookupMatches (a, "/NodeA");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 1, "Single index did not match one object");
+  NS_TEST_ASSERT_MSG_EQ (matches.Get (0), objects[2], "Single index did not match the expected object");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetMatchedPath (0), "/NodeA/NodeB/NodesB/2/", "Unexpected context");
+
+  //
+  // Connect with context from an object.
+  //
+  Config::CompiledPath traced ("/NodesB/[1-2]/Source");
+  traced.Connect (b, "/NodeA/NodeB", MakeCallback (&CompiledPathConfigTestCase::TraceWithPath, this));
+  m_newValue = 0;
+  m_path = "";
+  objects[2]->SetAttribute ("Source", IntegerValue (-3));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -3, "Trace 2 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodeA/NodeB/NodesB/2/Source", "Trace 2 did not provide expected context");
+  m_newValue = 0;
+  objects[3]->SetAttribute ("Source", IntegerValue (-4));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, 0, "Trace 3 fired unexpectedly");
+
+  //
+  // Set from an object.
+  //
+  Config::CompiledPath attribute ("/NodeA/NodeB/NodesB/*/A");
+  attribute.Set (root, IntegerValue (3));
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      objects[i]->GetAttribute ("A", iv);
+      NS_TEST_ASSERT_MSG_EQ (iv.Get (), 3, "Object Attribute \"A\" not set as expected");
+    }
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
+// ===========================================================================
+// Test that a compiled path with wildcard segments resolves to the same
+// targets as the string path functions, including the attributes found
+// in the parent classes and the objects found through the name service.
+// ===========================================================================
+class CompiledPathWildcardConfigTestCase : public TestCase
+{
+public:
+  CompiledPathWildcardConfigTestCase ();
+  virtual ~CompiledPathWildcardConfigTestCase () {}
+
+  void TraceWithPath (std::string path, int16_t old, int16_t newValue) { m_paths.push_back (path); }
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Change the traced value of every object of the tree.
+   */
+  void Fire (void);
+
+  std::vector<Ptr<ConfigTestObject> > m_objects;
+  std::vector<std::string> m_paths;
+  int16_t m_value;
+};
+
+CompiledPathWildcardConfigTestCase::CompiledPathWildcardConfigTestCase ()
+  : TestCase ("Check that a compiled path with wildcards has the same targets as a Config path"),
+    m_value (0)
+{
+}
+
+void
+CompiledPathWildcardConfigTestCase::Fire (void)
+{
+  for (uint32_t i = 0; i < m_objects.size (); i++)
+    {
+      // a traced value only fires when it changes
+      m_objects[i]->SetAttribute ("Source", IntegerValue (++m_value));
+    }
+}
+
+void
+CompiledPathWildcardConfigTestCase::DoRun (void)
+{
+  //
+  // The root and NodeA are derived objects, whose attributes are all in
+  // their parent class.
+  //
+  Ptr<DerivedConfigTestObject> root = CreateObject<DerivedConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  Ptr<DerivedConfigTestObject> a = CreateObject<DerivedConfigTestObject> ();
+  root->SetNodeA (a);
+  Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject> ();
+  root->SetNodeB (b);
+  Ptr<ConfigTestObject> c = CreateObject<ConfigTestObject> ();
+  a->SetNodeB (c);
+  m_objects.push_back (root);
+  m_objects.push_back (a);
+  m_objects.push_back (b);
+  m_objects.push_back (c);
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<ConfigTestObject> object = CreateObject<ConfigTestObject> ();
+      a->AddNodeA (object);
+      m_objects.push_back (object);
+      object = CreateObject<DerivedConfigTestObject> ();
+      b->AddNodeB (object);
+      m_objects.push_back (object);
+    }
+  Names::Add ("WildcardA", a);
+
+  const char *paths[] = { "/*/Source", "/*/*/Source", "/*/*/*/Source", "/*/*/*/*/Source",
+                          "/NodeA/*/*/Source", "/*/NodesA/*/Source", "/*/NodesB/1/Source",
+                          "/Names/WildcardA/*/Source", "/Names/WildcardA/*/*/Source",
+                          "/Names/*/Source", "/NodeA/$DerivedConfigTestObject/*/Source" };
+  for (uint32_t i = 0; i < sizeof (paths) / sizeof (paths[0]); i++)
+    {
+      Config::CompiledPath path (paths[i]);
+      Config::MatchContainer compiled = path.LookupMatches ();
+      std::string objectPath = paths[i];
+      Config::MatchContainer expected = Config::LookupMatches (objectPath.substr (0, objectPath.find_last_of ("/")));
+      NS_TEST_ASSERT_MSG_EQ (compiled.GetN (), expected.GetN (), "Unexpected number of matches for " << paths[i]);
+      for (uint32_t j = 0; j < compiled.GetN (); j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (compiled.Get (j), expected.Get (j), "Unexpected match for " << paths[i]);
+          NS_TEST_ASSERT_MSG_EQ (compiled.GetMatchedPath (j), expected.GetMatchedPath (j),
+                                 "Unexpected context for " << paths[i]);
+        }
+
+      //
+      // The trace sources connected are the same, with the same contexts.
+      //
+      Config::Connect (paths[i], MakeCallback (&CompiledPathWildcardConfigTestCase::TraceWithPath, this));
+      m_paths.clear ();
+      Fire ();
+      std::vector<std::string> connected = m_paths;
+      Config::Disconnect (paths[i], MakeCallback (&CompiledPathWildcardConfigTestCase::TraceWithPath, this));
+      path.Connect (MakeCallback (&CompiledPathWildcardConfigTestCase::TraceWithPath, this));
+      m_paths.clear ();
+      Fire ();
+      path.Disconnect (MakeCallback (&CompiledPathWildcardConfigTestCase::TraceWithPath, this));
+      NS_TEST_ASSERT_MSG_EQ (m_paths.size (), connected.size (), "Unexpected number of traces for " << paths[i]);
+      for (uint32_t j = 0; j < m_paths.size (); j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (m_paths[j], connected[j], "Unexpected trace context for " << paths[i]);
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (Config::CompiledPath ("/*/NodesA/*/Source").LookupMatches ().GetN (), 2,
+                         "The parent attributes of a derived object were not searched");
+
+  Names::Clear ();
+  Config::UnregisterRootNamespaceObject (root);
+  m_objects.clear ();
+}
+
 // ===========================================================================
 // The Test Suite that glues all of the Test Cases together.
 // ===========================================================================
@@ -737,6 +955,8 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase, TestCase::QUICK);
   AddTestCase (new ObjectVectorConfigTestCase, TestCase::QUICK);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase, TestCase::QUICK);
+  AddTestCase (new CompiledPathConfigTestCase, TestCase::QUICK);
+  AddTestCase (new CompiledPathWildcardConfigTestCase, TestCase::QUICK);
 }
 
 static ConfigTestSuite configTestSuite;
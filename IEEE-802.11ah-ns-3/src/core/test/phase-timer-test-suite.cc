@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/phase-timer.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+using namespace ns3;
+
+/** Keeps the compiler from removing the allocation of the test. */
+static char * volatile g_buffer;
+
+class PhaseTimerTestCase : public TestCase
+{
+public:
+  PhaseTimerTestCase ();
+  virtual void DoRun (void);
+};
+
+PhaseTimerTestCase::PhaseTimerTestCase ()
+  : TestCase ("Check that the phases and their heap growth are recorded")
+{
+}
+
+void
+PhaseTimerTestCase::DoRun (void)
+{
+  PhaseTimer timer;
+  timer.Stop ();
+  NS_TEST_ASSERT_MSG_EQ (timer.GetN (), 0, "Stop without a phase recorded one");
+
+  const uint32_t size = 4 * 1024 * 1024;
+  timer.Start ("allocate");
+  g_buffer = new char[size];
+  timer.Start ("free");
+  delete [] g_buffer;
+  timer.Stop ();
+  timer.Stop ();
+
+  NS_TEST_ASSERT_MSG_EQ (timer.GetN (), 2, "Unexpected number of phases");
+  NS_TEST_ASSERT_MSG_EQ (timer.GetName (0), "allocate", "Unexpected phase name");
+  NS_TEST_ASSERT_MSG_EQ (timer.GetName (1), "free", "Unexpected phase name");
+  NS_TEST_ASSERT_MSG_EQ ((timer.GetElapsedReal (0) >= 0), true, "Negative elapsed time");
+  NS_TEST_ASSERT_MSG_EQ (timer.GetTotalElapsedReal (), timer.GetElapsedReal (0) + timer.GetElapsedReal (1),
+                         "Total is not the sum of the phases");
+  if (PhaseTimer::HasHeapUsage ())
+    {
+      NS_TEST_ASSERT_MSG_EQ ((timer.GetHeapGrowth (0) >= size), true, "Allocation not measured");
+      NS_TEST_ASSERT_MSG_EQ ((timer.GetHeapGrowth (1) <= -static_cast<int64_t> (size)), true, "Free not measured");
+    }
+
+  std::ostringstream oss;
+  timer.Report (oss);
+  NS_TEST_ASSERT_MSG_NE (oss.str ().find ("allocate"), std::string::npos, "Phase missing from the report");
+  NS_TEST_ASSERT_MSG_NE (oss.str ().find ("total"), std::string::npos, "Total missing from the report");
+}
+
+static class PhaseTimerTestSuite : public TestSuite
+{
+public:
+  PhaseTimerTestSuite ()
+    : TestSuite ("phase-timer", UNIT)
+  {
+    AddTestCase (new PhaseTimerTestCase (), TestCase::QUICK);
+  }
+} g_phaseTimerTestSuite;
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/realtime-simulator-impl.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+class RealtimeJitterTestCase : public TestCase
+{
+public:
+  RealtimeJitterTestCase ();
+  virtual void DoRun (void);
+private:
+  void Event (void);
+
+  uint32_t m_events; //!< Number of events run
+};
+
+RealtimeJitterTestCase::RealtimeJitterTestCase ()
+  : TestCase ("Check that the jitter of every realtime event is counted")
+{
+}
+
+void
+RealtimeJitterTestCase::Event (void)
+{
+  m_events++;
+}
+
+void
+RealtimeJitterTestCase::DoRun (void)
+{
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::WallClockSynchronizer::BusyWait", BooleanValue (true));
+  Ptr<RealtimeSimulatorImpl> impl = CreateObject<RealtimeSimulatorImpl> ();
+  Config::SetDefault ("ns3::WallClockSynchronizer::BusyWait", BooleanValue (false));
+  impl->SetAttribute ("JitterBinCount", UintegerValue (4));
+  Simulator::SetImplementation (impl);
+
+  m_events = 0;
+  for (uint32_t i = 1; i <= 10; i++)
+    {
+      Simulator::Schedule (MilliSeconds (i), &RealtimeJitterTestCase::Event, this);
+    }
+  Simulator::Stop (MilliSeconds (20));
+  Simulator::Run ();
+
+  std::vector<uint64_t> histogram = impl->GetJitterHistogram ();
+  NS_TEST_ASSERT_MSG_EQ (histogram.size (), 4, "Unexpected number of bins");
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < histogram.size (); i++)
+    {
+      total += histogram[i];
+    }
+  // the events and the stop event
+  NS_TEST_ASSERT_MSG_EQ (m_events, 10, "Events were not run");
+  NS_TEST_ASSERT_MSG_EQ (total, 11, "Events missing from the histogram");
+
+  Simulator::Destroy ();
+}
+
+static class RealtimeSimulatorTestSuite : public TestSuite
+{
+public:
+  RealtimeSimulatorTestSuite ()
+    : TestSuite ("realtime-simulator", UNIT)
+  {
+    AddTestCase (new RealtimeJitterTestCase (), TestCase::QUICK);
+  }
+} g_realtimeSimulatorTestSuite;
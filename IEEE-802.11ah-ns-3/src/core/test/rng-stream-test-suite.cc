@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/rng-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+class RngStreamSplitTestCase : public TestCase
+{
+public:
+  RngStreamSplitTestCase ();
+  virtual void DoRun (void);
+};
+
+RngStreamSplitTestCase::RngStreamSplitTestCase ()
+  : TestCase ("Check that the children of a stream do not depend on the order they are split")
+{
+}
+
+void
+RngStreamSplitTestCase::DoRun (void)
+{
+  RngStream parent (1, 2, 3);
+
+  RngStream child3 = parent.Split (3);
+  double first = child3.RandU01 ();
+  RngStream child0 = parent.Split (0);
+  RngStream child1 = parent.Split (1);
+  NS_TEST_ASSERT_MSG_EQ (parent.Split (3).RandU01 (), first, "The child depends on the other children");
+
+  RngStream copy (parent);
+  uint32_t same = 0;
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      if (copy.RandU01 () == child0.RandU01 ())
+        {
+          same++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (same, 0, "The first child draws the numbers of the parent");
+
+  // the children are 2^50 numbers apart
+  NS_TEST_ASSERT_MSG_EQ (parent.Split (0).Split (2).RandU01 (), first, "The children are not evenly spaced");
+  double second = child1.RandU01 ();
+  NS_TEST_ASSERT_MSG_NE (second, parent.Split (0).RandU01 (), "Two children are the same");
+  NS_TEST_ASSERT_MSG_NE (second, first, "Two children are the same");
+
+  Ptr<UniformRandomVariable> secondChild = CreateObject<UniformRandomVariable> ();
+  Ptr<UniformRandomVariable> firstChild = CreateObject<UniformRandomVariable> ();
+  secondChild->SetSplitStream (5, 1);
+  double value = secondChild->GetValue ();
+  firstChild->SetSplitStream (5, 0);
+  secondChild->SetSplitStream (5, 1);
+  NS_TEST_ASSERT_MSG_EQ (secondChild->GetValue (), value, "The child depends on the other children");
+  NS_TEST_ASSERT_MSG_NE (firstChild->GetValue (), value, "Two children are the same");
+  Ptr<UniformRandomVariable> whole = CreateObject<UniformRandomVariable> ();
+  whole->SetStream (5);
+  firstChild->SetSplitStream (5, 0);
+  NS_TEST_ASSERT_MSG_NE (whole->GetValue (), firstChild->GetValue (), "The first child is the stream");
+}
+
+class RngStreamIndexTestCase : public TestCase
+{
+public:
+  RngStreamIndexTestCase ();
+  virtual void DoRun (void);
+};
+
+RngStreamIndexTestCase::RngStreamIndexTestCase ()
+  : TestCase ("Check that the stream indexes only depend on their key")
+{
+}
+
+void
+RngStreamIndexTestCase::DoRun (void)
+{
+  int64_t a = RngSeedManager::GetStreamIndex (3, "/DeviceList/0");
+  int64_t b = RngSeedManager::GetStreamIndex (4, "/DeviceList/0");
+  int64_t c = RngSeedManager::GetStreamIndex (3, "/DeviceList/1");
+  NS_TEST_ASSERT_MSG_EQ (RngSeedManager::GetStreamIndex (3, "/DeviceList/0"), a, "The index is not deterministic");
+  NS_TEST_ASSERT_MSG_NE (a, b, "Two nodes got the same index");
+  NS_TEST_ASSERT_MSG_NE (a, c, "Two paths got the same index");
+  NS_TEST_ASSERT_MSG_EQ ((a >= 0 && b >= 0 && c >= 0), true, "Negative stream index");
+  NS_TEST_ASSERT_MSG_EQ (a % RngSeedManager::GetStreamBlockSize (), 0, "The index is not at the start of a block");
+
+  uint64_t run = RngSeedManager::GetRun ();
+  Ptr<UniformRandomVariable> later = CreateObject<UniformRandomVariable> ();
+  Ptr<UniformRandomVariable> earlier = CreateObject<UniformRandomVariable> ();
+  earlier->SetStream (b);
+  later->SetStream (a);
+  double value = later->GetValue ();
+
+  Ptr<UniformRandomVariable> alone = CreateObject<UniformRandomVariable> ();
+  alone->SetStream (RngSeedManager::GetStreamIndex (3, "/DeviceList/0"));
+  NS_TEST_ASSERT_MSG_EQ (alone->GetValue (), value, "The stream depends on the other streams");
+
+  RngSeedManager::SetRun (run + 1);
+  alone->SetStream (a);
+  NS_TEST_ASSERT_MSG_NE (alone->GetValue (), value, "The stream does not depend on the run");
+  RngSeedManager::SetRun (run);
+}
+
+static class RngStreamTestSuite : public TestSuite
+{
+public:
+  RngStreamTestSuite ()
+    : TestSuite ("rng-stream", UNIT)
+  {
+    AddTestCase (new RngStreamSplitTestCase (), TestCase::QUICK);
+    AddTestCase (new RngStreamIndexTestCase (), TestCase::QUICK);
+  }
+} g_rngStreamTestSuite;
@@ -22,8 +22,10 @@
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/simulator.h"
+#include <cmath>
 
 namespace ns3 {
 
@@ -66,6 +68,13 @@ BasicEnergySource::GetTypeId (void)
                    MakeTimeAccessor (&BasicEnergySource::SetEnergyUpdateInterval,
                                      &BasicEnergySource::GetEnergyUpdateInterval),
                    MakeTimeChecker ())
+    .AddAttribute ("LazyEnergyUpdate",
+                   "Replace the periodic energy update by a single event at the "
+                   "predicted battery threshold crossing time.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&BasicEnergySource::SetLazyEnergyUpdate,
+                                        &BasicEnergySource::GetLazyEnergyUpdate),
+                   MakeBooleanChecker ())
     .AddTraceSource ("RemainingEnergy",
                      "Remaining energy at BasicEnergySource.",
                      MakeTraceSourceAccessor (&BasicEnergySource::m_remainingEnergyJ),
@@ -79,6 +88,7 @@ BasicEnergySource::BasicEnergySource ()
   NS_LOG_FUNCTION (this);
   m_lastUpdateTime = Seconds (0.0);
   m_depleted = false;
+  m_lazyEnergyUpdate = false;
 }
 
 BasicEnergySource::~BasicEnergySource ()
@@ -116,6 +126,20 @@ BasicEnergySource::GetEnergyUpdateInterval (void) const
   return m_energyUpdateInterval;
 }
 
+void
+BasicEnergySource::SetLazyEnergyUpdate (bool lazy)
+{
+  NS_LOG_FUNCTION (this << lazy);
+  m_lazyEnergyUpdate = lazy;
+}
+
+bool
+BasicEnergySource::GetLazyEnergyUpdate (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_lazyEnergyUpdate;
+}
+
 double
 BasicEnergySource::GetSupplyVoltage (void) const
 {
@@ -178,6 +202,18 @@ BasicEnergySource::UpdateEnergySource (void)
       HandleEnergyRechargedEvent ();
     }
 
+  if (m_lazyEnergyUpdate)
+    {
+      // the device models switch to their new state after this update,
+      // predict once they are done
+      if (!m_predictionEvent.IsRunning ())
+        {
+          m_predictionEvent = Simulator::ScheduleNow (&BasicEnergySource::PredictThresholdCrossing,
+                                                      this);
+        }
+      return;
+    }
+
   m_energyUpdateEvent = Simulator::Schedule (m_energyUpdateInterval,
                                              &BasicEnergySource::UpdateEnergySource,
                                              this);
@@ -198,6 +234,8 @@ void
 BasicEnergySource::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
+  m_energyUpdateEvent.Cancel ();
+  m_predictionEvent.Cancel ();
   BreakDeviceEnergyModelRefCycle ();  // break reference cycle
 }
 
@@ -234,4 +272,47 @@ BasicEnergySource::CalculateRemainingEnergy (void)
   NS_LOG_DEBUG ("BasicEnergySource:Remaining energy = " << m_remainingEnergyJ);
 }
 
+void
+BasicEnergySource::PredictThresholdCrossing (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_energyUpdateEvent.Cancel ();
+  if (Simulator::IsFinished ())
+    {
+      return;
+    }
+  CalculateRemainingEnergy ();
+  m_lastUpdateTime = Simulator::Now ();
+
+  double powerW = CalculateTotalCurrent () * m_supplyVoltageV;
+  double energyToThresholdJ;
+  if (!m_depleted && powerW > 0)
+    {
+      energyToThresholdJ = m_remainingEnergyJ - m_lowBatteryTh * m_initialEnergyJ;
+    }
+  else if (m_depleted && powerW < 0)
+    {
+      energyToThresholdJ = m_highBatteryTh * m_initialEnergyJ - m_remainingEnergyJ;
+      powerW = -powerW;
+    }
+  else
+    {
+      // the remaining energy moves away from the threshold, nothing happens
+      // until the next state change
+      return;
+    }
+
+  double delayS = energyToThresholdJ / powerW;
+  if (delayS >= (Simulator::GetMaximumSimulationTime () - Simulator::Now ()).GetSeconds ())
+    {
+      return;
+    }
+  // round up to the next time step so the threshold is crossed when the
+  // update runs; if rounding errors still leave it short, the update predicts
+  // again from there
+  Time delay = TimeStep (static_cast<int64_t> (std::ceil (delayS / TimeStep (1).GetSeconds ())) + 1);
+  NS_LOG_DEBUG ("BasicEnergySource:Threshold crossing predicted in " << delay);
+  m_energyUpdateEvent = Simulator::Schedule (delay, &BasicEnergySource::UpdateEnergySource, this);
+}
+
 } // namespace ns3
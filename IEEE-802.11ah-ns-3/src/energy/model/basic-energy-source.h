@@ -33,6 +33,13 @@ namespace ns3 {
  * BasicEnergySource decreases/increases remaining energy stored in itself in
  * linearly.
  *
+ * By default the remaining energy is updated at every device state change and
+ * every PeriodicEnergyUpdateInterval. When LazyEnergyUpdate is set, the
+ * periodic update is replaced by a single event scheduled at the time the
+ * remaining energy is predicted to cross the low (or, when harvesting, the
+ * high) battery threshold. Since the total current only changes on device
+ * state changes, the remaining energy is exact whenever it is queried, and the
+ * RemainingEnergy trace only fires on state changes and threshold crossings.
  */
 class BasicEnergySource : public EnergySource
 {
@@ -102,6 +109,18 @@ public:
    */
   Time GetEnergyUpdateInterval (void) const;
 
+  /**
+   * \param lazy whether the periodic update is replaced by a predicted
+   * threshold crossing event.
+   */
+  void SetLazyEnergyUpdate (bool lazy);
+
+  /**
+   * \returns whether the periodic update is replaced by a predicted threshold
+   * crossing event.
+   */
+  bool GetLazyEnergyUpdate (void) const;
+
 
 private:
   /// Defined in ns3::Object
@@ -135,6 +154,14 @@ private:
    */
   void CalculateRemainingEnergy (void);
 
+  /**
+   * Schedules the next energy update at the time the remaining energy will
+   * cross the low battery threshold (or the high one, if depleted and
+   * recharging), assuming the total current stays the same. Runs after the
+   * device energy models have switched to their new state.
+   */
+  void PredictThresholdCrossing (void);
+
 private:
   double m_initialEnergyJ;                // initial energy, in Joules
   double m_supplyVoltageV;                // supply voltage, in Volts
@@ -146,6 +173,8 @@ private:
   EventId m_energyUpdateEvent;            // energy update event
   Time m_lastUpdateTime;                  // last update time
   Time m_energyUpdateInterval;            // energy update interval
+  bool m_lazyEnergyUpdate;                // replace periodic updates with predicted threshold crossings
+  EventId m_predictionEvent;              // pending threshold crossing prediction
 
 };
 
@@ -370,6 +370,116 @@ BasicEnergyDepletionTest::DepletionTestCase (double simTimeS,
 
 // -------------------------------------------------------------------------- //
 
+/**
+ * Test case comparing the lazy update mode of BasicEnergySource with the
+ * periodic one, and checking the predicted depletion time.
+ */
+class BasicEnergyLazyUpdateTest : public TestCase
+{
+public:
+  BasicEnergyLazyUpdateTest ();
+  virtual ~BasicEnergyLazyUpdateTest ();
+
+private:
+  void DoRun (void);
+
+  /**
+   * \param lazy Whether the source uses the lazy update mode.
+   * \param initialEnergyJ Initial energy of the source, in Joules.
+   * \param energies Remaining energy sampled at each state change.
+   *
+   * Switches the radio through a few states, sampling the remaining energy.
+   */
+  void RunScenario (bool lazy, double initialEnergyJ, std::vector<double> &energies);
+
+  /**
+   * \param source Energy source to sample.
+   * \param energies Vector the remaining energy is appended to.
+   */
+  void Sample (Ptr<BasicEnergySource> source, std::vector<double> *energies);
+
+  /**
+   * Callback invoked when energy is drained from source.
+   */
+  void DepletionHandler (void);
+
+  double m_tolerance;   // tolerance on the remaining energy
+  Time m_depletionTime; // time the depletion callback was invoked
+};
+
+BasicEnergyLazyUpdateTest::BasicEnergyLazyUpdateTest ()
+  : TestCase ("Basic energy source lazy update test case")
+{
+  m_tolerance = 1.0e-12;
+}
+
+BasicEnergyLazyUpdateTest::~BasicEnergyLazyUpdateTest ()
+{
+}
+
+void
+BasicEnergyLazyUpdateTest::Sample (Ptr<BasicEnergySource> source, std::vector<double> *energies)
+{
+  energies->push_back (source->GetRemainingEnergy ());
+}
+
+void
+BasicEnergyLazyUpdateTest::DepletionHandler (void)
+{
+  m_depletionTime = Simulator::Now ();
+}
+
+void
+BasicEnergyLazyUpdateTest::RunScenario (bool lazy, double initialEnergyJ, std::vector<double> &energies)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<BasicEnergySource> source = CreateObject<BasicEnergySource> ();
+  source->SetInitialEnergy (initialEnergyJ);
+  source->SetLazyEnergyUpdate (lazy);
+  node->AggregateObject (source);
+  Ptr<WifiRadioEnergyModel> model = CreateObject<WifiRadioEnergyModel> ();
+  model->SetEnergySource (source);
+  model->SetEnergyDepletionCallback (MakeCallback (&BasicEnergyLazyUpdateTest::DepletionHandler, this));
+  source->AppendDeviceEnergyModel (model);
+
+  m_depletionTime = Seconds (-1);
+  Simulator::Schedule (Seconds (1.25), &WifiRadioEnergyModel::ChangeState, model, WifiPhy::TX);
+  Simulator::Schedule (Seconds (1.25), &BasicEnergyLazyUpdateTest::Sample, this, source, &energies);
+  Simulator::Schedule (Seconds (2.5), &WifiRadioEnergyModel::ChangeState, model, WifiPhy::SLEEP);
+  Simulator::Schedule (Seconds (2.5), &BasicEnergyLazyUpdateTest::Sample, this, source, &energies);
+  Simulator::Schedule (Seconds (7.75), &WifiRadioEnergyModel::ChangeState, model, WifiPhy::RX);
+  Simulator::Schedule (Seconds (7.75), &BasicEnergyLazyUpdateTest::Sample, this, source, &energies);
+  Simulator::Schedule (Seconds (9), &BasicEnergyLazyUpdateTest::Sample, this, source, &energies);
+  Simulator::Stop (Seconds (10));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+BasicEnergyLazyUpdateTest::DoRun (void)
+{
+  std::vector<double> periodic;
+  std::vector<double> lazy;
+  RunScenario (false, 10.0, periodic);
+  RunScenario (true, 10.0, lazy);
+  NS_TEST_ASSERT_MSG_EQ (lazy.size (), periodic.size (), "Missing samples");
+  for (uint32_t i = 0; i < lazy.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (lazy[i], periodic[i], m_tolerance, "Lazy and periodic modes differ");
+    }
+
+  // idle until the low battery threshold is crossed before the first state change
+  Ptr<WifiRadioEnergyModel> model = CreateObject<WifiRadioEnergyModel> ();
+  double initialEnergyJ = 1.0;
+  double powerW = model->GetIdleCurrentA () * 3.0;
+  double expectedS = initialEnergyJ * (1 - 0.10) / powerW;
+  lazy.clear ();
+  RunScenario (true, initialEnergyJ, lazy);
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_depletionTime.GetSeconds (), expectedS, 1.0e-8, "Wrong depletion time");
+}
+
+// -------------------------------------------------------------------------- //
+
 /**
  * Unit test suite for energy model. Although the test suite involves 2 modules
  * it is still considered a unit test. Because a DeviceEnergyModel cannot live
@@ -386,6 +496,7 @@ BasicEnergyModelTestSuite::BasicEnergyModelTestSuite ()
 {
   AddTestCase (new BasicEnergyUpdateTest, TestCase::QUICK);
   AddTestCase (new BasicEnergyDepletionTest, TestCase::QUICK);
+  AddTestCase (new BasicEnergyLazyUpdateTest, TestCase::QUICK);
 }
 
 // create an instance of the test suite
@@ -102,15 +102,23 @@ FlowMonitor::DoDispose (void)
       m_flowProbes[i]->Dispose ();
       m_flowProbes[i] = 0;
     }
+  m_csvEvent.Cancel ();
+  if (m_csvFile.is_open ())
+    {
+      m_csvFile.close ();
+    }
+  m_flowStatsIndex.clear ();
   Object::DoDispose ();
 }
 
 inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow (FlowId flowId)
 {
-  FlowStatsContainerI iter;
-  iter = m_flowStats.find (flowId);
-  if (iter == m_flowStats.end ())
+  if (flowId < m_flowStatsIndex.size () && m_flowStatsIndex[flowId] != 0)
+    {
+      return *m_flowStatsIndex[flowId];
+    }
+  else
     {
       FlowMonitor::FlowStats &ref = m_flowStats[flowId];
       ref.delaySum = Seconds (0);
@@ -126,15 +134,41 @@ FlowMonitor::GetStatsForFlow (FlowId flowId)
       ref.jitterHistogram.SetDefaultBinWidth (m_jitterBinWidth);
       ref.packetSizeHistogram.SetDefaultBinWidth (m_packetSizeBinWidth);
       ref.flowInterruptionsHistogram.SetDefaultBinWidth (m_flowInterruptionsBinWidth);
+      // the elements of a std::map are never moved, so their address can be kept
+      if (flowId >= m_flowStatsIndex.size ())
+        {
+          m_flowStatsIndex.resize (flowId + 1, 0);
+        }
+      m_flowStatsIndex[flowId] = &ref;
       return ref;
     }
-  else
-    {
-      return iter->second;
-    }
 }
 
 
+uint64_t
+FlowMonitor::GetTrackedPacketKey (FlowId flowId, FlowPacketId packetId)
+{
+  return (static_cast<uint64_t> (flowId) << 32) | packetId;
+}
+
+void
+FlowMonitor::QueueTrackedPacket (uint32_t index)
+{
+  ExpiryEntry entry;
+  entry.index = index;
+  entry.generation = m_trackedPacketPool[index].generation;
+  m_expiryQueue.push_back (entry);
+}
+
+void
+FlowMonitor::ReleaseTrackedPacket (TrackedPacketMap::iterator tracked)
+{
+  // the entries of the packet left in the expiry queue become stale
+  m_trackedPacketPool[tracked->second].generation++;
+  m_freeTrackedPackets.push_back (tracked->second);
+  m_trackedPackets.erase (tracked);
+}
+
 void
 FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetId, uint32_t packetSize)
 {
@@ -143,10 +177,33 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       return;
     }
   Time now = Simulator::Now ();
-  TrackedPacket &tracked = m_trackedPackets[std::make_pair (flowId, packetId)];
+  std::pair<TrackedPacketMap::iterator, bool> insert
+    = m_trackedPackets.insert (std::make_pair (GetTrackedPacketKey (flowId, packetId), 0));
+  if (insert.second)
+    {
+      if (m_freeTrackedPackets.empty ())
+        {
+          insert.first->second = m_trackedPacketPool.size ();
+          m_trackedPacketPool.push_back (TrackedPacket ());
+          m_trackedPacketPool.back ().generation = 0;
+        }
+      else
+        {
+          insert.first->second = m_freeTrackedPackets.back ();
+          m_freeTrackedPackets.pop_back ();
+        }
+    }
+  else
+    {
+      m_trackedPacketPool[insert.first->second].generation++;
+    }
+  TrackedPacket &tracked = m_trackedPacketPool[insert.first->second];
   tracked.firstSeenTime = now;
   tracked.lastSeenTime = tracked.firstSeenTime;
   tracked.timesForwarded = 0;
+  tracked.flowId = flowId;
+  tracked.packetId = packetId;
+  QueueTrackedPacket (insert.first->second);
   NS_LOG_DEBUG ("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId=" << packetId
                                                                 << ").");
 
@@ -170,8 +227,7 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
     {
       return;
     }
-  std::pair<FlowId, FlowPacketId> key (flowId, packetId);
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (key);
+  TrackedPacketMap::iterator tracked = m_trackedPackets.find (GetTrackedPacketKey (flowId, packetId));
   if (tracked == m_trackedPackets.end ())
     {
       NS_LOG_WARN ("Received packet forward report (flowId=" << flowId << ", packetId=" << packetId
@@ -179,10 +235,14 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
       return;
     }
 
-  tracked->second.timesForwarded++;
-  tracked->second.lastSeenTime = Simulator::Now ();
+  TrackedPacket &record = m_trackedPacketPool[tracked->second];
+  record.timesForwarded++;
+  record.lastSeenTime = Simulator::Now ();
+  // move the packet to the back of the expiry queue
+  record.generation++;
+  QueueTrackedPacket (tracked->second);
 
-  Time delay = (Simulator::Now () - tracked->second.firstSeenTime);
+  Time delay = (Simulator::Now () - record.firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
 }
 
@@ -194,16 +254,17 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
     {
       return;
     }
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
+  TrackedPacketMap::iterator tracked = m_trackedPackets.find (GetTrackedPacketKey (flowId, packetId));
   if (tracked == m_trackedPackets.end ())
     {
       NS_LOG_WARN ("Received packet last-tx report (flowId=" << flowId << ", packetId=" << packetId
                                                              << ") but not known to be transmitted.");
       return;
     }
+  const TrackedPacket &record = m_trackedPacketPool[tracked->second];
 
   Time now = Simulator::Now ();
-  Time delay = (now - tracked->second.firstSeenTime);
+  Time delay = (now - record.firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
 
   FlowStats &stats = GetStatsForFlow (flowId);
@@ -242,12 +303,12 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
         }
     }
   stats.timeLastRxPacket = now;
-  stats.timesForwarded += tracked->second.timesForwarded;
+  stats.timesForwarded += record.timesForwarded;
 
   NS_LOG_DEBUG ("ReportLastTx: removing tracked packet (flowId="
                 << flowId << ", packetId=" << packetId << ").");
 
-  m_trackedPackets.erase (tracked); // we don't need to track this packet anymore
+  ReleaseTrackedPacket (tracked); // we don't need to track this packet anymore
 }
 
 void
@@ -272,14 +333,14 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
   stats.bytesDropped[reasonCode] += packetSize;
   NS_LOG_DEBUG ("++stats.packetsDropped[" << reasonCode<< "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
+  TrackedPacketMap::iterator tracked = m_trackedPackets.find (GetTrackedPacketKey (flowId, packetId));
   if (tracked != m_trackedPackets.end ())
     {
       // we don't need to track this packet anymore
       // FIXME: this will not necessarily be true with broadcast/multicast
       NS_LOG_DEBUG ("ReportDrop: removing tracked packet (flowId="
                     << flowId << ", packetId=" << packetId << ").");
-      m_trackedPackets.erase (tracked);
+      ReleaseTrackedPacket (tracked);
     }
 }
 
@@ -295,23 +356,33 @@ FlowMonitor::CheckForLostPackets (Time maxDelay)
 {
   Time now = Simulator::Now ();
 
-  for (TrackedPacketMap::iterator iter = m_trackedPackets.begin ();
-       iter != m_trackedPackets.end (); )
+  // The queue is ordered by the time the packets were last seen, so
+  // only its head, up to the first packet seen too recently to be
+  // lost, needs to be looked at.
+  while (!m_expiryQueue.empty ())
     {
-      if (now - iter->second.lastSeenTime >= maxDelay)
+      const ExpiryEntry &entry = m_expiryQueue.front ();
+      const TrackedPacket &record = m_trackedPacketPool[entry.index];
+      if (record.generation != entry.generation)
         {
-          // packet is considered lost, add it to the loss statistics
-          FlowStatsContainerI flow = m_flowStats.find (iter->first.first);
-          NS_ASSERT (flow != m_flowStats.end ());
-          flow->second.lostPackets++;
-
-          // we won't track it anymore
-          m_trackedPackets.erase (iter++);
+          // the packet was seen again, received or dropped since then
+          m_expiryQueue.pop_front ();
+          continue;
         }
-      else
+      if (now - record.lastSeenTime < maxDelay)
         {
-          iter++;
+          break;
         }
+
+      // packet is considered lost, add it to the loss statistics
+      NS_ASSERT (record.flowId < m_flowStatsIndex.size () && m_flowStatsIndex[record.flowId] != 0);
+      m_flowStatsIndex[record.flowId]->lostPackets++;
+
+      // we won't track it anymore
+      TrackedPacketMap::iterator tracked = m_trackedPackets.find (GetTrackedPacketKey (record.flowId, record.packetId));
+      NS_ASSERT (tracked != m_trackedPackets.end ());
+      m_expiryQueue.pop_front ();
+      ReleaseTrackedPacket (tracked);
     }
 }
 
@@ -380,6 +451,10 @@ FlowMonitor::StartRightNow ()
       return;
     }
   m_enabled = true;
+  if (m_csvFile.is_open () && !m_csvEvent.IsRunning ())
+    {
+      m_csvEvent = Simulator::Schedule (m_csvInterval, &FlowMonitor::PeriodicExportCsv, this);
+    }
 }
 
 
@@ -392,6 +467,12 @@ FlowMonitor::StopRightNow ()
     }
   m_enabled = false;
   CheckForLostPackets ();
+  if (m_csvFile.is_open ())
+    {
+      ExportCsv ();
+    }
+  // StartRightNow resumes the periodic export
+  m_csvEvent.Cancel ();
 }
 
 void
@@ -505,5 +586,78 @@ FlowMonitor::SerializeToXmlFile (std::string fileName, bool enableHistograms, bo
 }
 
 
-} // namespace ns3
+void
+FlowMonitor::StartCsvExport (std::string fileName, Time interval)
+{
+  NS_LOG_FUNCTION (this << fileName << interval);
+  NS_ASSERT_MSG (interval.IsStrictlyPositive (), "The CSV export interval must be positive");
+  if (m_csvFile.is_open ())
+    {
+      m_csvFile.close ();
+    }
+  m_csvFile.open (fileName.c_str (), std::ios::out | std::ios::trunc);
+  if (!m_csvFile.is_open ())
+    {
+      NS_FATAL_ERROR ("Can't open file " << fileName);
+    }
+  m_csvFile << "time,flowId,txPackets,rxPackets,txBytes,rxBytes,lostPackets,delaySum,jitterSum\n";
+  m_csvExported.clear ();
+  m_csvInterval = interval;
+  m_csvEvent.Cancel ();
+  if (m_enabled)
+    {
+      m_csvEvent = Simulator::Schedule (m_csvInterval, &FlowMonitor::PeriodicExportCsv, this);
+    }
+}
 
+void
+FlowMonitor::ExportCsv ()
+{
+  NS_LOG_FUNCTION (this);
+  double now = Simulator::Now ().GetSeconds ();
+  if (m_csvExported.size () < m_flowStatsIndex.size ())
+    {
+      ExportedStats zero = { 0, 0, 0, 0, 0, Seconds (0), Seconds (0) };
+      m_csvExported.resize (m_flowStatsIndex.size (), zero);
+    }
+  for (FlowId flowId = 0; flowId < m_flowStatsIndex.size (); flowId++)
+    {
+      const FlowStats *stats = m_flowStatsIndex[flowId];
+      if (stats == 0)
+        {
+          continue;
+        }
+      ExportedStats &last = m_csvExported[flowId];
+      if (stats->txPackets == last.txPackets && stats->rxPackets == last.rxPackets
+          && stats->lostPackets == last.lostPackets)
+        {
+          continue;
+        }
+      m_csvFile << now << ',' << flowId
+                << ',' << stats->txPackets - last.txPackets
+                << ',' << stats->rxPackets - last.rxPackets
+                << ',' << stats->txBytes - last.txBytes
+                << ',' << stats->rxBytes - last.rxBytes
+                << ',' << stats->lostPackets - last.lostPackets
+                << ',' << (stats->delaySum - last.delaySum).GetSeconds ()
+                << ',' << (stats->jitterSum - last.jitterSum).GetSeconds ()
+                << '\n';
+      last.txBytes = stats->txBytes;
+      last.rxBytes = stats->rxBytes;
+      last.txPackets = stats->txPackets;
+      last.rxPackets = stats->rxPackets;
+      last.lostPackets = stats->lostPackets;
+      last.delaySum = stats->delaySum;
+      last.jitterSum = stats->jitterSum;
+    }
+  m_csvFile.flush ();
+}
+
+void
+FlowMonitor::PeriodicExportCsv ()
+{
+  ExportCsv ();
+  m_csvEvent = Simulator::Schedule (m_csvInterval, &FlowMonitor::PeriodicExportCsv, this);
+}
+
+} // namespace ns3
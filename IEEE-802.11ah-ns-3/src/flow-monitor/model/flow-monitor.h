@@ -23,6 +23,9 @@
 
 #include <vector>
 #include <map>
+#include <deque>
+#include <unordered_map>
+#include <fstream>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
@@ -256,6 +259,21 @@ public:
   /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
   void SerializeToXmlFile (std::string fileName, bool enableHistograms, bool enableProbes);
 
+  /// Periodically append the changes of the flow statistics to a CSV
+  /// file while the simulation runs, so that the results of a long
+  /// simulation are available before it ends and without building a
+  /// whole XML document.
+  ///
+  /// Every interval, one line is written for each flow whose statistics
+  /// changed since the previous export: the time, the flow id, and the
+  /// increase of txPackets, rxPackets, txBytes, rxBytes, lostPackets,
+  /// delaySum and jitterSum (in seconds).  The sum of the lines of a
+  /// flow gives its totals.  The exports only run while the monitoring is
+  /// enabled, and a last export is made when the monitoring stops.
+  /// \param fileName name or path of the output file that will be created
+  /// \param interval time between two exports
+  void StartCsvExport (std::string fileName, Time interval);
+
 
 protected:
 
@@ -270,14 +288,32 @@ private:
     Time firstSeenTime; //!< absolute time when the packet was first seen by a probe
     Time lastSeenTime; //!< absolute time when the packet was last seen by a probe
     uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
+    FlowId flowId; //!< flow of the packet
+    FlowPacketId packetId; //!< identifier of the packet in its flow
+    uint32_t generation; //!< changed each time the packet is seen or the record released
+  };
+
+  /// A tracked packet in the expiry queue.  The entry is stale, and
+  /// ignored, once the generation of the record has changed.
+  struct ExpiryEntry
+  {
+    uint32_t index; //!< index of the record in m_trackedPacketPool
+    uint32_t generation; //!< generation of the record when the entry was queued
   };
 
   /// FlowId --> FlowStats
   FlowStatsContainer m_flowStats;
+  /// FlowId --> FlowStats, indexed directly by the FlowId to avoid a
+  /// lookup in m_flowStats for each packet (0 if the flow has no stats)
+  std::vector<FlowStats *> m_flowStatsIndex;
 
-  /// (FlowId,PacketId) --> TrackedPacket
-  typedef std::map< std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+  /// (FlowId,PacketId) --> index of the TrackedPacket in m_trackedPacketPool
+  typedef std::unordered_map<uint64_t, uint32_t> TrackedPacketMap;
   TrackedPacketMap m_trackedPackets; //!< Tracked packets
+  std::vector<TrackedPacket> m_trackedPacketPool; //!< Records of the tracked packets, reused once released
+  std::vector<uint32_t> m_freeTrackedPackets; //!< Indexes of the released records
+  /// Tracked packets in the order they were last seen, the oldest first
+  std::deque<ExpiryEntry> m_expiryQueue;
   Time m_maxPerHopDelay; //!< Minimum per-hop delay
   FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
@@ -293,6 +329,23 @@ private:
   double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
   Time m_flowInterruptionsMinTime; //!< Flow interruptions minimum time
 
+  /// The counters of a flow written by the last CSV export
+  struct ExportedStats
+  {
+    uint64_t txBytes;       //!< Transmitted bytes
+    uint64_t rxBytes;       //!< Received bytes
+    uint32_t txPackets;     //!< Transmitted packets
+    uint32_t rxPackets;     //!< Received packets
+    uint32_t lostPackets;   //!< Lost packets
+    Time delaySum;          //!< Sum of the delays
+    Time jitterSum;         //!< Sum of the jitters
+  };
+
+  std::ofstream m_csvFile;                  //!< CSV output file
+  Time m_csvInterval;                       //!< Time between two CSV exports
+  EventId m_csvEvent;                       //!< Next CSV export
+  std::vector<ExportedStats> m_csvExported; //!< Exported counters, indexed by FlowId
+
   /// Get the stats for a given flow
   /// \param flowId the Flow identification
   /// \returns the stats of the flow
@@ -300,6 +353,22 @@ private:
 
   /// Periodic function to check for lost packets and prune statistics
   void PeriodicCheckForLostPackets ();
+
+  /// \param flowId the Flow identification
+  /// \param packetId the Packet identification
+  /// \returns the key of the packet in m_trackedPackets
+  static uint64_t GetTrackedPacketKey (FlowId flowId, FlowPacketId packetId);
+  /// Queue a tracked packet for the loss check, from the current time
+  /// \param index the index of its record in m_trackedPacketPool
+  void QueueTrackedPacket (uint32_t index);
+  /// Stop tracking a packet and release its record
+  /// \param tracked the packet in m_trackedPackets
+  void ReleaseTrackedPacket (TrackedPacketMap::iterator tracked);
+
+  /// Append the changes of the flow statistics since the last export to the CSV file
+  void ExportCsv ();
+  /// Periodic function to export the flow statistics to the CSV file
+  void PeriodicExportCsv ();
 };
 
 
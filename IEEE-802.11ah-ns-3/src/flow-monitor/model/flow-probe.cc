@@ -50,13 +50,31 @@ void
 FlowProbe::DoDispose (void)
 {
   m_flowMonitor = 0;
+  m_statsIndex.clear ();
   Object::DoDispose ();
 }
 
+FlowProbe::FlowStats&
+FlowProbe::GetFlowStats (FlowId flowId)
+{
+  if (flowId < m_statsIndex.size () && m_statsIndex[flowId] != 0)
+    {
+      return *m_statsIndex[flowId];
+    }
+  // the elements of a std::map are never moved, so their address can be kept
+  FlowStats &flow = m_stats[flowId];
+  if (flowId >= m_statsIndex.size ())
+    {
+      m_statsIndex.resize (flowId + 1, 0);
+    }
+  m_statsIndex[flowId] = &flow;
+  return flow;
+}
+
 void
 FlowProbe::AddPacketStats (FlowId flowId, uint32_t packetSize, Time delayFromFirstProbe)
 {
-  FlowStats &flow = m_stats[flowId];
+  FlowStats &flow = GetFlowStats (flowId);
   flow.delayFromFirstProbeSum += delayFromFirstProbe;
   flow.bytes += packetSize;
   ++flow.packets;
@@ -65,7 +83,7 @@ FlowProbe::AddPacketStats (FlowId flowId, uint32_t packetSize, Time delayFromFir
 void
 FlowProbe::AddPacketDropStats (FlowId flowId, uint32_t packetSize, uint32_t reasonCode)
 {
-  FlowStats &flow = m_stats[flowId];
+  FlowStats &flow = GetFlowStats (flowId);
 
   if (flow.packetsDropped.size () < reasonCode + 1)
     {
@@ -106,6 +106,15 @@ protected:
   Ptr<FlowMonitor> m_flowMonitor; //!< the FlowMonitor instance
   Stats m_stats; //!< The flow stats
 
+private:
+  /// Get the stats of a flow, creating them if needed
+  /// \param flowId the flow Identifier
+  /// \returns the stats of the flow
+  FlowStats& GetFlowStats (FlowId flowId);
+
+  /// FlowId -> FlowStats in m_stats, to find the stats of a packet
+  /// without a lookup in m_stats (0 if the flow was not seen yet)
+  std::vector<FlowStats *> m_statsIndex;
 };
 
 
@@ -23,6 +23,8 @@
 #include "ipv4-flow-classifier.h"
 #include "ns3/udp-header.h"
 #include "ns3/tcp-header.h"
+#include "ns3/hash.h"
+#include <cstring>
 
 namespace ns3 {
 
@@ -99,6 +101,18 @@ Ipv4FlowClassifier::Ipv4FlowClassifier ()
 {
 }
 
+size_t
+Ipv4FlowClassifier::FiveTupleHash::operator() (const FiveTuple &tuple) const
+{
+  uint8_t buf[13];
+  tuple.sourceAddress.Serialize (buf);
+  tuple.destinationAddress.Serialize (buf + 4);
+  buf[8] = tuple.protocol;
+  std::memcpy (buf + 9, &tuple.sourcePort, 2);
+  std::memcpy (buf + 11, &tuple.destinationPort, 2);
+  return Hash32 (reinterpret_cast<const char *> (buf), sizeof (buf));
+}
+
 bool
 Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPayload,
                               uint32_t *out_flowId, uint32_t *out_packetId)
@@ -147,23 +161,25 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
   tuple.destinationPort = dstPort;
 
   // try to insert the tuple, but check if it already exists
-  std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
+  std::pair<FlowMap::iterator, bool> insert
     = m_flowMap.insert (std::pair<FiveTuple, FlowId> (tuple, 0));
 
   // if the insertion succeeded, we need to assign this tuple a new flow identifier
   if (insert.second)
     {
       FlowId newFlowId = GetNewFlowId ();
+      NS_ASSERT (newFlowId == m_flowTuples.size () + 1);
       insert.first->second = newFlowId;
-      m_flowPktIdMap[newFlowId] = 0;
+      m_flowTuples.push_back (tuple);
+      m_flowPktIds.push_back (0);
     }
   else
     {
-      m_flowPktIdMap[insert.first->second] ++;
+      m_flowPktIds[insert.first->second - 1] ++;
     }
 
   *out_flowId = insert.first->second;
-  *out_packetId = m_flowPktIdMap[*out_flowId];
+  *out_packetId = m_flowPktIds[*out_flowId - 1];
 
   return true;
 }
@@ -172,17 +188,11 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
 Ipv4FlowClassifier::FiveTuple
 Ipv4FlowClassifier::FindFlow (FlowId flowId) const
 {
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  if (flowId == 0 || flowId > m_flowTuples.size ())
     {
-      if (iter->second == flowId)
-        {
-          return iter->first;
-        }
+      NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
-  NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
-  FiveTuple retval = { Ipv4Address::GetZero (), Ipv4Address::GetZero (), 0, 0, 0 };
-  return retval;
+  return m_flowTuples[flowId - 1];
 }
 
 void
@@ -193,16 +203,15 @@ Ipv4FlowClassifier::SerializeToXmlStream (std::ostream &os, int indent) const
   INDENT (indent); os << "<Ipv4FlowClassifier>\n";
 
   indent += 2;
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  for (uint32_t i = 0; i < m_flowTuples.size (); i++)
     {
       INDENT (indent);
-      os << "<Flow flowId=\"" << iter->second << "\""
-         << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-         << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-         << " protocol=\"" << int(iter->first.protocol) << "\""
-         << " sourcePort=\"" << iter->first.sourcePort << "\""
-         << " destinationPort=\"" << iter->first.destinationPort << "\""
+      os << "<Flow flowId=\"" << i + 1 << "\""
+         << " sourceAddress=\"" << m_flowTuples[i].sourceAddress << "\""
+         << " destinationAddress=\"" << m_flowTuples[i].destinationAddress << "\""
+         << " protocol=\"" << int(m_flowTuples[i].protocol) << "\""
+         << " sourcePort=\"" << m_flowTuples[i].sourcePort << "\""
+         << " destinationPort=\"" << m_flowTuples[i].destinationPort << "\""
          << " />\n";
     }
 
@@ -24,9 +24,11 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
 
 #include "ns3/ipv6-header.h"
 #include "ns3/flow-classifier.h"
+#include "ns3/sgi-hashmap.h"
 
 namespace ns3 {
 
@@ -74,10 +76,23 @@ public:
 
 private:
 
+  /// Hash function of a FiveTuple, to look the flows up in a hash table
+  struct FiveTupleHash
+  {
+    /// \param tuple the FiveTuple to hash
+    /// \returns the hash of the tuple
+    size_t operator() (const FiveTuple &tuple) const;
+  };
+
+  /// Hash table of the FlowIds, indexed by FiveTuple
+  typedef sgi::hash_map<FiveTuple, FlowId, FiveTupleHash> FlowMap;
+
   /// Map to Flows Identifiers to FlowIds
-  std::map<FiveTuple, FlowId> m_flowMap;
-  /// Map to FlowIds to FlowPacketId
-  std::map<FlowId, FlowPacketId> m_flowPktIdMap;
+  FlowMap m_flowMap;
+  /// The FiveTuple of each flow, indexed by FlowId - 1
+  std::vector<FiveTuple> m_flowTuples;
+  /// The last FlowPacketId of each flow, indexed by FlowId - 1
+  std::vector<FlowPacketId> m_flowPktIds;
 
 };
 
@@ -0,0 +1,235 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/udp-header.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+class Ipv4FlowClassifierTestCase : public TestCase
+{
+public:
+  Ipv4FlowClassifierTestCase ();
+  virtual void DoRun (void);
+
+private:
+  bool Classify (Ptr<Ipv4FlowClassifier> classifier, Ipv4Address src, Ipv4Address dst,
+                 uint16_t srcPort, uint16_t dstPort, uint32_t *flowId, uint32_t *packetId);
+};
+
+Ipv4FlowClassifierTestCase::Ipv4FlowClassifierTestCase ()
+  : TestCase ("Check the flow and packet identifiers given by the Ipv4FlowClassifier")
+{
+}
+
+bool
+Ipv4FlowClassifierTestCase::Classify (Ptr<Ipv4FlowClassifier> classifier, Ipv4Address src, Ipv4Address dst,
+                                      uint16_t srcPort, uint16_t dstPort, uint32_t *flowId, uint32_t *packetId)
+{
+  Ipv4Header ipHeader;
+  ipHeader.SetSource (src);
+  ipHeader.SetDestination (dst);
+  ipHeader.SetProtocol (17);
+  UdpHeader udpHeader;
+  udpHeader.SetSourcePort (srcPort);
+  udpHeader.SetDestinationPort (dstPort);
+  Ptr<Packet> packet = Create<Packet> (100);
+  packet->AddHeader (udpHeader);
+  return classifier->Classify (ipHeader, packet, flowId, packetId);
+}
+
+void
+Ipv4FlowClassifierTestCase::DoRun (void)
+{
+  Ptr<Ipv4FlowClassifier> classifier = Create<Ipv4FlowClassifier> ();
+  Ipv4Address a ("10.0.0.1");
+  Ipv4Address b ("10.0.0.2");
+  uint32_t flowId, packetId;
+
+  NS_TEST_ASSERT_MSG_EQ (Classify (classifier, a, b, 49153, 9, &flowId, &packetId), true, "Packet not classified");
+  NS_TEST_ASSERT_MSG_EQ (flowId, 1, "Unexpected flow id");
+  NS_TEST_ASSERT_MSG_EQ (packetId, 0, "Unexpected packet id");
+  Classify (classifier, b, a, 9, 49153, &flowId, &packetId);
+  NS_TEST_ASSERT_MSG_EQ (flowId, 2, "The reverse direction is not a new flow");
+  NS_TEST_ASSERT_MSG_EQ (packetId, 0, "Unexpected packet id");
+  Classify (classifier, a, b, 49153, 9, &flowId, &packetId);
+  NS_TEST_ASSERT_MSG_EQ (flowId, 1, "A known flow got a new id");
+  NS_TEST_ASSERT_MSG_EQ (packetId, 1, "Unexpected packet id");
+  Classify (classifier, a, b, 49154, 9, &flowId, &packetId);
+  NS_TEST_ASSERT_MSG_EQ (flowId, 3, "Another source port is not a new flow");
+  Classify (classifier, a, b, 49153, 9, &flowId, &packetId);
+  NS_TEST_ASSERT_MSG_EQ (packetId, 2, "Unexpected packet id");
+
+  Ipv4FlowClassifier::FiveTuple tuple = classifier->FindFlow (2);
+  NS_TEST_ASSERT_MSG_EQ (tuple.sourceAddress, b, "Unexpected source address");
+  NS_TEST_ASSERT_MSG_EQ (tuple.destinationAddress, a, "Unexpected destination address");
+  NS_TEST_ASSERT_MSG_EQ (tuple.sourcePort, 9, "Unexpected source port");
+  NS_TEST_ASSERT_MSG_EQ (tuple.destinationPort, 49153, "Unexpected destination port");
+  NS_TEST_ASSERT_MSG_EQ (int (tuple.protocol), 17, "Unexpected protocol");
+}
+
+
+/**
+ * A probe which does not listen to anything, the packets are reported
+ * to the FlowMonitor by the test itself.
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+public:
+  FlowMonitorTestProbe (Ptr<FlowMonitor> monitor)
+    : FlowProbe (monitor)
+  {
+  }
+};
+
+class FlowMonitorCsvExportTestCase : public TestCase
+{
+public:
+  FlowMonitorCsvExportTestCase ();
+  virtual void DoRun (void);
+};
+
+FlowMonitorCsvExportTestCase::FlowMonitorCsvExportTestCase ()
+  : TestCase ("Check the changes of the flow statistics exported to a CSV file")
+{
+}
+
+void
+FlowMonitorCsvExportTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("flow-monitor.csv");
+  Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+  monitor->SetAttribute ("MaxPerHopDelay", TimeValue (Seconds (1.8)));
+  Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartCsvExport (fileName, Seconds (1));
+  monitor->StartRightNow ();
+
+  Simulator::Schedule (Seconds (0.5), &FlowMonitor::ReportFirstTx, monitor, probe, 1, 0, 100);
+  Simulator::Schedule (Seconds (0.5), &FlowMonitor::ReportFirstTx, monitor, probe, 2, 0, 50);
+  Simulator::Schedule (Seconds (0.7), &FlowMonitor::ReportLastRx, monitor, probe, 1, 0, 100);
+  Simulator::Schedule (Seconds (1.5), &FlowMonitor::ReportFirstTx, monitor, probe, 1, 1, 100);
+  Simulator::Schedule (Seconds (1.6), &FlowMonitor::ReportLastRx, monitor, probe, 1, 1, 100);
+  // the packet of flow 2 is only considered lost when the monitoring stops
+  Simulator::Schedule (Seconds (2.5), &FlowMonitor::StopRightNow, monitor);
+  Simulator::Stop (Seconds (3.5));
+  Simulator::Run ();
+  monitor->Dispose ();
+  Simulator::Destroy ();
+
+  std::vector<std::string> expected;
+  expected.push_back ("time,flowId,txPackets,rxPackets,txBytes,rxBytes,lostPackets,delaySum,jitterSum");
+  expected.push_back ("1,1,1,1,100,100,0,0.2,0");
+  expected.push_back ("1,2,1,0,50,0,0,0,0");
+  expected.push_back ("2,1,1,1,100,100,0,0.1,0.1");
+  expected.push_back ("2.5,2,0,0,0,0,1,0,0");
+
+  std::ifstream file (fileName.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (file.is_open (), true, "The CSV file was not created");
+  std::string line;
+  uint32_t n = 0;
+  while (std::getline (file, line))
+    {
+      NS_TEST_ASSERT_MSG_LT (n, expected.size (), "Unexpected line " << line);
+      NS_TEST_ASSERT_MSG_EQ (line, expected[n], "Unexpected line " << n);
+      n++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (n, expected.size (), "Missing lines");
+}
+
+
+class FlowMonitorLostPacketsTestCase : public TestCase
+{
+public:
+  FlowMonitorLostPacketsTestCase ();
+  virtual void DoRun (void);
+
+private:
+  void CheckLost (Ptr<FlowMonitor> monitor, Time maxDelay, uint32_t lost1, uint32_t lost2);
+};
+
+FlowMonitorLostPacketsTestCase::FlowMonitorLostPacketsTestCase ()
+  : TestCase ("Check that a packet is lost when not seen for longer than the maximum delay")
+{
+}
+
+void
+FlowMonitorLostPacketsTestCase::CheckLost (Ptr<FlowMonitor> monitor, Time maxDelay, uint32_t lost1, uint32_t lost2)
+{
+  monitor->CheckForLostPackets (maxDelay);
+  const FlowMonitor::FlowStatsContainer &stats = monitor->GetFlowStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.find (1)->second.lostPackets, lost1,
+                         "Unexpected lost packets of flow 1 at " << Simulator::Now ().GetSeconds ());
+  NS_TEST_ASSERT_MSG_EQ (stats.find (2)->second.lostPackets, lost2,
+                         "Unexpected lost packets of flow 2 at " << Simulator::Now ().GetSeconds ());
+}
+
+void
+FlowMonitorLostPacketsTestCase::DoRun (void)
+{
+  Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+  Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+
+  // flow 1: packet 0 is forwarded at 1.5 s and never received, packet 1 is received
+  Simulator::Schedule (Seconds (0.1), &FlowMonitor::ReportFirstTx, monitor, probe, 1, 0, 100);
+  Simulator::Schedule (Seconds (0.2), &FlowMonitor::ReportFirstTx, monitor, probe, 1, 1, 100);
+  Simulator::Schedule (Seconds (0.3), &FlowMonitor::ReportLastRx, monitor, probe, 1, 1, 100);
+  Simulator::Schedule (Seconds (1.5), &FlowMonitor::ReportForwarding, monitor, probe, 1, 0, 100);
+  // flow 2: two packets never seen again, one of them sent later
+  Simulator::Schedule (Seconds (0.4), &FlowMonitor::ReportFirstTx, monitor, probe, 2, 0, 100);
+  Simulator::Schedule (Seconds (1.2), &FlowMonitor::ReportFirstTx, monitor, probe, 2, 1, 100);
+
+  Simulator::Schedule (Seconds (1.0), &FlowMonitorLostPacketsTestCase::CheckLost, this, monitor, Seconds (1), 0, 0);
+  Simulator::Schedule (Seconds (2.0), &FlowMonitorLostPacketsTestCase::CheckLost, this, monitor, Seconds (1), 0, 1);
+  Simulator::Schedule (Seconds (2.3), &FlowMonitorLostPacketsTestCase::CheckLost, this, monitor, Seconds (1), 0, 2);
+  Simulator::Schedule (Seconds (2.6), &FlowMonitorLostPacketsTestCase::CheckLost, this, monitor, Seconds (1), 1, 2);
+  // the flows send again, reusing the records of the lost packets
+  Simulator::Schedule (Seconds (3.0), &FlowMonitor::ReportFirstTx, monitor, probe, 1, 2, 100);
+  Simulator::Schedule (Seconds (3.0), &FlowMonitor::ReportFirstTx, monitor, probe, 2, 2, 100);
+  Simulator::Schedule (Seconds (3.1), &FlowMonitor::ReportLastRx, monitor, probe, 1, 2, 100);
+  Simulator::Schedule (Seconds (3.5), &FlowMonitorLostPacketsTestCase::CheckLost, this, monitor, Seconds (1), 1, 2);
+  Simulator::Schedule (Seconds (4.0), &FlowMonitorLostPacketsTestCase::CheckLost, this, monitor, Seconds (1), 1, 3);
+  Simulator::Stop (Seconds (5));
+  Simulator::Run ();
+  monitor->Dispose ();
+  Simulator::Destroy ();
+
+  const FlowMonitor::FlowStatsContainer &stats = monitor->GetFlowStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.find (1)->second.rxPackets, 2, "Unexpected received packets of flow 1");
+}
+
+
+static class FlowMonitorTestSuite : public TestSuite
+{
+public:
+  FlowMonitorTestSuite ()
+    : TestSuite ("flow-monitor", UNIT)
+  {
+    AddTestCase (new Ipv4FlowClassifierTestCase (), TestCase::QUICK);
+    AddTestCase (new FlowMonitorCsvExportTestCase (), TestCase::QUICK);
+    AddTestCase (new FlowMonitorLostPacketsTestCase (), TestCase::QUICK);
+  }
+} g_flowMonitorTestSuite;
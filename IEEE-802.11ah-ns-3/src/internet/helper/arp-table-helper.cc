@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "arp-table-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/arp-cache.h"
+#include "ns3/net-device.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ArpTableHelper");
+
+ArpTableHelper::ArpTableHelper ()
+{
+}
+
+Ptr<SharedArpTable>
+ArpTableHelper::Install (NodeContainer c) const
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<SharedArpTable> table = Create<SharedArpTable> ();
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Ptr<Ipv4L3Protocol> ipv4 = (*i)->GetObject<Ipv4L3Protocol> ();
+      NS_ASSERT_MSG (ipv4 != 0, "ArpTableHelper: node " << (*i)->GetId () << " has no Internet stack");
+      for (uint32_t j = 0; j < ipv4->GetNInterfaces (); j++)
+        {
+          Ptr<Ipv4Interface> interface = ipv4->GetInterface (j);
+          if (interface->GetArpCache () == 0)
+            {
+              // loopback and devices which do not need ARP
+              continue;
+            }
+          Address macAddress = interface->GetDevice ()->GetAddress ();
+          for (uint32_t k = 0; k < interface->GetNAddresses (); k++)
+            {
+              Ipv4Address address = interface->GetAddress (k).GetLocal ();
+              NS_LOG_LOGIC ("Adding the pair (" << address << ", " << macAddress << ")");
+              table->Add (address, macAddress);
+            }
+          interface->GetArpCache ()->SetSharedTable (table);
+        }
+    }
+  return table;
+}
+
+Ptr<SharedArpTable>
+ArpTableHelper::InstallAll (void) const
+{
+  return Install (NodeContainer::GetGlobal ());
+}
+
+void
+ArpTableHelper::AddOverride (Ptr<Node> node, Ipv4Address ipv4Address, Address macAddress)
+{
+  NS_LOG_FUNCTION (node << ipv4Address << macAddress);
+  Ptr<Ipv4L3Protocol> ipv4 = node->GetObject<Ipv4L3Protocol> ();
+  NS_ASSERT_MSG (ipv4 != 0, "ArpTableHelper: node " << node->GetId () << " has no Internet stack");
+  for (uint32_t j = 0; j < ipv4->GetNInterfaces (); j++)
+    {
+      Ptr<ArpCache> cache = ipv4->GetInterface (j)->GetArpCache ();
+      if (cache == 0)
+        {
+          continue;
+        }
+      ArpCache::Entry *entry = cache->Lookup (ipv4Address);
+      if (entry == 0)
+        {
+          entry = cache->Add (ipv4Address);
+        }
+      entry->SetMacAddresss (macAddress);
+      entry->MarkPermanent ();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ARP_TABLE_HELPER_H
+#define ARP_TABLE_HELPER_H
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/address.h"
+#include "ns3/shared-arp-table.h"
+
+namespace ns3 {
+
+/**
+ * \brief Helper class that fills the ARP caches of a set of nodes before
+ * the simulation starts, so that no ARP request is ever sent.
+ *
+ * The IPv4 addresses of the nodes and the MAC addresses of their devices
+ * are collected into a single ns3::SharedArpTable, which every ARP cache
+ * of the nodes then refers to. Both the setup time and the memory are
+ * linear in the number of nodes.
+ *
+ * The nodes must have an Internet stack and their addresses assigned.
+ * The nodes given to Install should be on the same link: the table does
+ * not know which device an address can be reached from.
+ */
+class ArpTableHelper
+{
+public:
+  ArpTableHelper ();
+
+  /**
+   * \brief Collect the addresses of the nodes and make their ARP caches
+   * use them.
+   * \param c the nodes
+   * \return the table shared by the ARP caches of the nodes
+   */
+  Ptr<SharedArpTable> Install (NodeContainer c) const;
+  /**
+   * \brief Collect the addresses of all the nodes of the simulation and
+   * make their ARP caches use them.
+   * \return the table shared by all the ARP caches
+   */
+  Ptr<SharedArpTable> InstallAll (void) const;
+
+  /**
+   * \brief Add a permanent entry to the ARP caches of a single node.
+   *
+   * The entry takes precedence over the shared table of the node.
+   *
+   * \param node the node
+   * \param ipv4Address the IPv4 address
+   * \param macAddress the MAC address it resolves to
+   */
+  static void AddOverride (Ptr<Node> node, Ipv4Address ipv4Address, Address macAddress);
+};
+
+} // namespace ns3
+
+#endif /* ARP_TABLE_HELPER_H */
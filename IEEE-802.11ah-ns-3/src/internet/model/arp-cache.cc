@@ -102,6 +102,7 @@ ArpCache::DoDispose (void)
   Flush ();
   m_device = 0;
   m_interface = 0;
+  m_sharedTable = 0;
   if (!m_waitReplyTimer.IsRunning ())
     {
       Simulator::Remove (m_waitReplyTimer);
@@ -150,6 +151,20 @@ ArpCache::SetWaitReplyTimeout (Time waitReplyTimeout)
   m_waitReplyTimeout = waitReplyTimeout;
 }
 
+void
+ArpCache::SetSharedTable (Ptr<SharedArpTable> table)
+{
+  NS_LOG_FUNCTION (this << table);
+  m_sharedTable = table;
+}
+
+Ptr<SharedArpTable>
+ArpCache::GetSharedTable (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_sharedTable;
+}
+
 Time
 ArpCache::GetAliveTimeout (void) const
 {
@@ -299,9 +314,17 @@ ArpCache::Entry *
 ArpCache::Lookup (Ipv4Address to)
 {
   NS_LOG_FUNCTION (this << to);
-  if (m_arpCache.find (to) != m_arpCache.end ()) 
+  CacheI it = m_arpCache.find (to);
+  if (it != m_arpCache.end ()) 
+    {
+      return it->second;
+    }
+  Address macAddress;
+  if (m_sharedTable != 0 && m_sharedTable->Lookup (to, &macAddress))
     {
-      ArpCache::Entry *entry = m_arpCache[to];
+      ArpCache::Entry *entry = Add (to);
+      entry->SetMacAddresss (macAddress);
+      entry->MarkPermanent ();
       return entry;
     }
   return 0;
@@ -34,6 +34,7 @@
 #include "ns3/traced-callback.h"
 #include "ns3/sgi-hashmap.h"
 #include "ns3/output-stream-wrapper.h"
+#include "shared-arp-table.h"
 
 namespace ns3 {
 
@@ -108,6 +109,19 @@ public:
    * \param waitReplyTimeout the WAIT_REPLY state timeout
    */
   void SetWaitReplyTimeout (Time waitReplyTimeout);
+  /**
+   * \brief Set the table looked up when this cache misses an address.
+   *
+   * The addresses found in the table are kept as permanent entries.
+   * Entries added to this cache take precedence over the table.
+   *
+   * \param table the shared table, or 0 to stop using one
+   */
+  void SetSharedTable (Ptr<SharedArpTable> table);
+  /**
+   * \return the shared table of this cache, or 0
+   */
+  Ptr<SharedArpTable> GetSharedTable (void) const;
 
   /**
    * \brief Get the time the entry will be in ALIVE state (unless refreshed)
@@ -142,6 +156,10 @@ public:
   void StartWaitReplyTimer (void);
   /**
    * \brief Do lookup in the ARP cache against an IP address
+   *
+   * If the address is not in the cache but is in the shared table, a
+   * permanent entry is added for it.
+   *
    * \param destination The destination IPv4 address to lookup the MAC address
    * of
    * \return An ArpCache::Entry with info about layer 2
@@ -332,6 +350,7 @@ private:
   void HandleWaitReplyTimeout (void);
   uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
   Cache m_arpCache; //!< the ARP cache
+  Ptr<SharedArpTable> m_sharedTable; //!< table looked up on a miss
   TracedCallback<Ptr<const Packet> > m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
 
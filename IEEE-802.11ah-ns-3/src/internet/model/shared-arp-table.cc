@@ -0,0 +1,54 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/log.h"
+#include "shared-arp-table.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SharedArpTable");
+
+SharedArpTable::SharedArpTable ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SharedArpTable::Add (Ipv4Address ipv4Address, Address macAddress)
+{
+  NS_LOG_FUNCTION (this << ipv4Address << macAddress);
+  m_table[ipv4Address] = macAddress;
+}
+
+bool
+SharedArpTable::Lookup (Ipv4Address ipv4Address, Address *macAddress) const
+{
+  NS_LOG_FUNCTION (this << ipv4Address);
+  Table::const_iterator i = m_table.find (ipv4Address);
+  if (i == m_table.end ())
+    {
+      return false;
+    }
+  *macAddress = i->second;
+  return true;
+}
+
+uint32_t
+SharedArpTable::GetN (void) const
+{
+  return m_table.size ();
+}
+
+} // namespace ns3
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SHARED_ARP_TABLE_H
+#define SHARED_ARP_TABLE_H
+
+#include <stdint.h>
+#include "ns3/simple-ref-count.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/address.h"
+#include "ns3/sgi-hashmap.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup arp
+ * \brief A table of IPv4 to MAC address pairs shared by several ARP caches
+ *
+ * A single table holds the addresses of all the nodes of a subnet, and
+ * every ArpCache of the subnet refers to it. A cache that misses an
+ * address looks it up here and, on a hit, keeps a permanent entry for
+ * it. The memory used is thus linear in the number of nodes, instead of
+ * quadratic when every cache is filled with every pair.
+ *
+ * The table is meant to be filled once, before the simulation starts,
+ * by ns3::ArpTableHelper, and not changed afterwards: entries already
+ * copied to a cache are not updated.
+ */
+class SharedArpTable : public SimpleRefCount<SharedArpTable>
+{
+public:
+  SharedArpTable ();
+
+  /**
+   * \brief Add or replace an address pair.
+   * \param ipv4Address the IPv4 address
+   * \param macAddress the MAC address it resolves to
+   */
+  void Add (Ipv4Address ipv4Address, Address macAddress);
+  /**
+   * \brief Look up an IPv4 address.
+   * \param ipv4Address the IPv4 address
+   * \param macAddress set to the MAC address if found
+   * \return true if the address is in the table
+   */
+  bool Lookup (Ipv4Address ipv4Address, Address *macAddress) const;
+  /**
+   * \return the number of address pairs in the table
+   */
+  uint32_t GetN (void) const;
+
+private:
+  /**
+   * \brief Container of the address pairs
+   */
+  typedef sgi::hash_map<Ipv4Address, Address, Ipv4AddressHash> Table;
+
+  Table m_table; //!< the address pairs
+};
+
+} // namespace ns3
+
+#endif /* SHARED_ARP_TABLE_H */
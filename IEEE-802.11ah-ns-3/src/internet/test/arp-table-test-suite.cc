@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/arp-table-helper.h"
+#include "ns3/arp-cache.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/mac48-address.h"
+#include "ns3/socket.h"
+
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that the ARP caches filled by the ArpTableHelper resolve
+ * the addresses of the subnet without any ARP exchange.
+ */
+class ArpTableTest : public TestCase
+{
+public:
+  ArpTableTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Receive a packet.
+   * \param socket the receiving socket
+   */
+  void ReceivePkt (Ptr<Socket> socket);
+  /**
+   * \brief Send a packet.
+   * \param socket the sending socket
+   * \param to the destination address
+   */
+  void SendPkt (Ptr<Socket> socket, Ipv4Address to);
+
+  Time m_rxTime; //!< the reception time of the last packet
+};
+
+ArpTableTest::ArpTableTest ()
+  : TestCase ("Shared ARP table")
+{
+}
+
+void
+ArpTableTest::ReceivePkt (Ptr<Socket> socket)
+{
+  socket->Recv (std::numeric_limits<uint32_t>::max (), 0);
+  m_rxTime = Simulator::Now ();
+}
+
+void
+ArpTableTest::SendPkt (Ptr<Socket> socket, Ipv4Address to)
+{
+  socket->SendTo (Create<Packet> (100), 0, InetSocketAddress (to, 1234));
+}
+
+void
+ArpTableTest::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (3);
+  SimpleNetDeviceHelper simple;
+  NetDeviceContainer devices = simple.Install (nodes);
+  InternetStackHelper internet;
+  internet.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  ArpTableHelper arp;
+  Ptr<SharedArpTable> table = arp.Install (nodes);
+  NS_TEST_ASSERT_MSG_EQ (table->GetN (), 3, "One address per node is expected");
+
+  Ptr<ArpCache> cache = nodes.Get (0)->GetObject<Ipv4L3Protocol> ()->GetInterface (1)->GetArpCache ();
+  NS_TEST_ASSERT_MSG_EQ (cache->GetSharedTable (), table, "The cache does not use the shared table");
+  ArpCache::Entry *entry = cache->Lookup (interfaces.GetAddress (2));
+  NS_TEST_ASSERT_MSG_NE (entry, 0, "The address of node 2 is not resolved");
+  NS_TEST_EXPECT_MSG_EQ (entry->IsPermanent (), true, "The entry should be permanent");
+  NS_TEST_EXPECT_MSG_EQ (entry->GetMacAddress (), devices.Get (2)->GetAddress (), "Wrong MAC address");
+  NS_TEST_EXPECT_MSG_EQ (cache->Lookup (Ipv4Address ("10.0.0.100")), 0, "Unknown address resolved");
+
+  // an override only applies to the node it is added to
+  Mac48Address other = Mac48Address ("00:00:00:00:00:aa");
+  ArpTableHelper::AddOverride (nodes.Get (1), interfaces.GetAddress (2), other);
+  Ptr<ArpCache> cache1 = nodes.Get (1)->GetObject<Ipv4L3Protocol> ()->GetInterface (1)->GetArpCache ();
+  NS_TEST_EXPECT_MSG_EQ (cache1->Lookup (interfaces.GetAddress (2))->GetMacAddress (), Address (other), "Override not used");
+  NS_TEST_EXPECT_MSG_EQ (cache->Lookup (interfaces.GetAddress (2))->GetMacAddress (), devices.Get (2)->GetAddress (),
+                         "Override leaked to another node");
+
+  // with no ARP request, the packet is received as soon as it is sent
+  Ptr<Socket> rxSocket = nodes.Get (0)->GetObject<UdpSocketFactory> ()->CreateSocket ();
+  rxSocket->Bind (InetSocketAddress (Ipv4Address::GetAny (), 1234));
+  rxSocket->SetRecvCallback (MakeCallback (&ArpTableTest::ReceivePkt, this));
+  Ptr<Socket> txSocket = nodes.Get (2)->GetObject<UdpSocketFactory> ()->CreateSocket ();
+  m_rxTime = Seconds (-1);
+  Simulator::ScheduleWithContext (nodes.Get (2)->GetId (), Seconds (1),
+                                  &ArpTableTest::SendPkt, this, txSocket, interfaces.GetAddress (0));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_rxTime, Seconds (1), "The packet was delayed by an ARP exchange");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Shared ARP table TestSuite
+ */
+class ArpTableTestSuite : public TestSuite
+{
+public:
+  ArpTableTestSuite () : TestSuite ("arp-table", UNIT)
+  {
+    AddTestCase (new ArpTableTest, TestCase::QUICK);
+  }
+};
+
+static ArpTableTestSuite g_arpTableTestSuite; //!< Static variable for test initialization
@@ -18,6 +18,16 @@
  */
 #define __STDC_LIMIT_MACROS
 #include "ns3/test.h"
+#include "ns3/tcp-socket.h"
+#include "ns3/tcp-tx-buffer.h"
+#include "ns3/tcp-rx-buffer.h"
+#include "ns3/rtt-estimator.h"
+#include "ns3/tcp-option.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv6-header.h"
+#define private protected
+#include "ns3/tcp-socket-base.h"
+#undef private
 #include "ns3/node-container.h"
 #include "ns3/tcp-socket-base.h"
 #include "ns3/simple-net-device-helper.h"
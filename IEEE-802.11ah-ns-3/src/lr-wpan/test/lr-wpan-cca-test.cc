@@ -164,7 +164,7 @@ LrWpanCcaTestCase::DoRun (void)
   // Each device must be attached to the same channel
   Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel> ();
   Ptr<LogDistancePropagationLossModel> propModel = CreateObject<LogDistancePropagationLossModel> ();
-  propModel->SetReference (1.0, 40.0641); // Reference loss at 1m distance for 2405 MHz (channel 11)
+  propModel->SetReference (1.0, 40.0641, 2405e6); // Reference loss at 1m distance for 2405 MHz (channel 11)
   propModel->SetPathLossExponent (2); // Free space path loss exponent
   Ptr<ConstantSpeedPropagationDelayModel> delayModel = CreateObject<ConstantSpeedPropagationDelayModel> ();
   channel->AddPropagationLossModel (propModel);
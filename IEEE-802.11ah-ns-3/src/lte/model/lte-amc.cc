@@ -359,10 +359,17 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
          {
             uint8_t mcs = 0;
             TbStats_t tbStats;
+            HarqProcessInfoList_t harqInfoList;
+            // the mmib only depends on the modulation, compute it once
+            // for each of QPSK, 16-QAM and 64-QAM
+            double mib = 0;
             while (mcs <= 28)
               {
-                HarqProcessInfoList_t harqInfoList;
-                tbStats = LteMiErrorModel::GetTbDecodificationStats (sinr, rbgMap, (uint16_t)GetTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
+                if (mcs == 0 || mcs == MI_QPSK_MAX_ID + 1 || mcs == MI_16QAM_MAX_ID + 1)
+                  {
+                    mib = LteMiErrorModel::Mib (sinr, rbgMap, mcs);
+                  }
+                tbStats = LteMiErrorModel::GetTbDecodificationStats (mib, (uint16_t)GetTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
                 if (tbStats.tbler > 0.1)
                   {
                     break;
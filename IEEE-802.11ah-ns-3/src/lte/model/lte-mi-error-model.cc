@@ -37,6 +37,7 @@
 #include <stdint.h>
 #include <cmath>
 #include <stdint.h>
+#include <algorithm>
 #include "stdlib.h"
 #include <ns3/lte-mi-error-model.h>
 
@@ -327,79 +328,65 @@ double
 LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
-  
+
+  // since the values in the MI map axes are uniformly spaced, we have
+  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+  // the scaling coefficient is always the same, so we use a static const
+  // to speed up the calculation
+  static const double scalingCoeffQpsk =
+    (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
+  static const double scalingCoeff16qam =
+    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]);
+  static const double scalingCoeff64qam =
+    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]);
+
+  // the modulation is the same for all the RBs, select its map once
+  const double *miMap;
+  const double *miMapAxis;
+  uint16_t miMapSize;
+  double scalingCoeff;
+  if (mcs <= MI_QPSK_MAX_ID) // QPSK
+    {
+      miMap = MI_map_qpsk;
+      miMapAxis = MI_map_qpsk_axis;
+      miMapSize = MI_MAP_QPSK_SIZE;
+      scalingCoeff = scalingCoeffQpsk;
+    }
+  else if (mcs <= MI_16QAM_MAX_ID) // 16-QAM
+    {
+      miMap = MI_map_16qam;
+      miMapAxis = MI_map_16qam_axis;
+      miMapSize = MI_MAP_16QAM_SIZE;
+      scalingCoeff = scalingCoeff16qam;
+    }
+  else // 64-QAM
+    {
+      miMap = MI_map_64qam;
+      miMapAxis = MI_map_64qam_axis;
+      miMapSize = MI_MAP_64QAM_SIZE;
+      scalingCoeff = scalingCoeff64qam;
+    }
+  const double sinrMax = miMapAxis[miMapSize - 1];
+
   double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  
+  Values::const_iterator sinrValues = sinr.ConstValuesBegin ();
   for (uint32_t i = 0; i < map.size (); i++)
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MI_QPSK_MAX_ID) // QPSK
+      NS_ASSERT (sinrValues + map[i] < sinr.ConstValuesEnd ());
+      double sinrLin = sinrValues[map[i]];
+      if (sinrLin > sinrMax)
         {
-
-          if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-            {
-              MI = 1;
-            }
-          else 
-            { 
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk = 
-                (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
-            }
+          MI = 1;
         }
       else
         {
-          if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
-            {
-              if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else 
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam = 
-                    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
-            }
-          else // 64-QAM
-            {
-              if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam = 
-                    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
-            }
+          double sinrIndexDouble = (sinrLin - miMapAxis[0]) * scalingCoeff + 1;
+          uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
+          NS_ASSERT_MSG (sinrIndex < miMapSize, "MI map out of data");
+          MI = miMap[sinrIndex];
         }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
+      NS_LOG_LOGIC (" RB " << map[i] << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
       MIsum += MI;
     }
   MI = MIsum / map.size ();
@@ -460,11 +447,10 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
   NS_LOG_FUNCTION (sinr);
   double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  Values::iterator sinrIt = sinrCopy.ValuesBegin ();
+  Values::const_iterator sinrIt = sinr.ConstValuesBegin ();
   uint16_t rb = 0;
-  NS_ASSERT (sinrIt!=sinrCopy.ValuesEnd ());
-  while (sinrIt!=sinrCopy.ValuesEnd ())
+  NS_ASSERT (sinrIt!=sinr.ConstValuesEnd ());
+  while (sinrIt!=sinr.ConstValuesEnd ())
     {
       double sinrLin = *sinrIt;
       if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
@@ -489,13 +475,10 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
       rb++;
     }
   MI = MIsum / rb;
-  // return to the effective SINR value
-  int j = 0;
+  // return to the effective SINR value: the MI map is sorted, find the
+  // first entry not below MI
+  int j = std::lower_bound (MI_map_qpsk, MI_map_qpsk + MI_MAP_QPSK_SIZE, MI) - MI_map_qpsk;
   double esinr = 0.0;
-  while ((j<MI_MAP_QPSK_SIZE)&&(MI_map_qpsk[j] < MI))
-    {
-      j++;
-    }
   if (MI > MI_map_qpsk[MI_MAP_QPSK_SIZE-1])
     {
       esinr = MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1];
@@ -523,12 +506,9 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
   double esirnDb = 10*log10 (esinr); 
 //   NS_LOG_DEBUG ("Effective SINR " << esirnDb << " max " << 10*log10 (MI_map_qpsk [MI_MAP_QPSK_SIZE-1]));
-  uint16_t i = 0;
+  uint16_t i = std::lower_bound (PdcchPcfichBlerCurveXaxis, PdcchPcfichBlerCurveXaxis + PDCCH_PCFICH_CURVE_SIZE, esirnDb)
+    - PdcchPcfichBlerCurveXaxis;
   double errorRate = 0.0;
-  while ((i<PDCCH_PCFICH_CURVE_SIZE)&&(PdcchPcfichBlerCurveXaxis[i] < esirnDb))
-    {
-      i++;
-    }
   if (esirnDb > PdcchPcfichBlerCurveXaxis[PDCCH_PCFICH_CURVE_SIZE-1])
     {
       errorRate = 0.0;
@@ -546,11 +526,19 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
 
 TbStats_t
-LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory)
+LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
-  double tbMi = Mib(sinr, map, mcs);
+  return GetTbDecodificationStats (Mib (sinr, map, mcs), size, mcs, miHistory);
+}
+
+
+TbStats_t
+LteMiErrorModel::GetTbDecodificationStats (double tbMi, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
+{
+  NS_LOG_FUNCTION (tbMi << (uint32_t) size << (uint32_t) mcs);
+
   double MI = 0.0;
   double Reff = 0.0;
   NS_ASSERT (mcs < 29);
@@ -57,5 +57,10 @@ ConstantPositionMobilityModel::DoGetVelocity (void) const
 {
   return Vector (0.0, 0.0, 0.0);
 }
+bool
+ConstantPositionMobilityModel::DoIsStationary (void) const
+{
+  return true;
+}
 
 } // namespace ns3
@@ -47,6 +47,7 @@ private:
   virtual Vector DoGetPosition (void) const;
   virtual void DoSetPosition (const Vector &position);
   virtual Vector DoGetVelocity (void) const;
+  virtual bool DoIsStationary (void) const;
 
   Vector m_position; //!< the constant position
 };
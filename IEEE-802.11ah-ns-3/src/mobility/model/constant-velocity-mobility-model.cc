@@ -68,5 +68,12 @@ ConstantVelocityMobilityModel::DoGetVelocity (void) const
 {
   return m_helper.GetVelocity ();
 }
+bool
+ConstantVelocityMobilityModel::DoIsStationary (void) const
+{
+  // the course changes are notified when the node starts or stops moving
+  Vector velocity = m_helper.GetVelocity ();
+  return velocity.x == 0 && velocity.y == 0 && velocity.z == 0;
+}
 
 } // namespace ns3
@@ -58,6 +58,7 @@ private:
   virtual Vector DoGetPosition (void) const;
   virtual void DoSetPosition (const Vector &position);
   virtual Vector DoGetVelocity (void) const;
+  virtual bool DoIsStationary (void) const;
   ConstantVelocityHelper m_helper;  //!< helper object for this model
 };
 
@@ -22,6 +22,7 @@
 
 #include "mobility-model.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/simulator.h"
 
 namespace ns3 {
 
@@ -53,6 +54,8 @@ MobilityModel::GetTypeId (void)
 }
 
 MobilityModel::MobilityModel ()
+  : m_positionValid (false),
+    m_stationary (false)
 {
 }
 
@@ -60,10 +63,28 @@ MobilityModel::~MobilityModel ()
 {
 }
 
+void
+MobilityModel::UpdatePosition (void) const
+{
+  Time now = Simulator::Now ();
+  if (m_positionValid && (m_stationary || m_positionTime == now))
+    {
+      return;
+    }
+  // DoGetPosition may notify a course change, so only mark the
+  // position as valid once it returned
+  Vector position = DoGetPosition ();
+  m_position = position;
+  m_positionTime = now;
+  m_stationary = DoIsStationary ();
+  m_positionValid = true;
+}
+
 Vector
 MobilityModel::GetPosition (void) const
 {
-  return DoGetPosition ();
+  UpdatePosition ();
+  return m_position;
 }
 Vector
 MobilityModel::GetVelocity (void) const
@@ -71,17 +92,26 @@ MobilityModel::GetVelocity (void) const
   return DoGetVelocity ();
 }
 
+bool
+MobilityModel::IsStationary (void) const
+{
+  UpdatePosition ();
+  return m_stationary;
+}
+
 void 
 MobilityModel::SetPosition (const Vector &position)
 {
+  m_positionValid = false;
   DoSetPosition (position);
+  m_positionValid = false;
 }
 
 double 
 MobilityModel::GetDistanceFrom (Ptr<const MobilityModel> other) const
 {
-  Vector oPosition = other->DoGetPosition ();
-  Vector position = DoGetPosition ();
+  Vector oPosition = other->GetPosition ();
+  Vector position = GetPosition ();
   return CalculateDistance (position, oPosition);
 }
 
@@ -97,6 +127,7 @@ MobilityModel::GetRelativeSpeed (Ptr<const MobilityModel> other) const
 void
 MobilityModel::NotifyCourseChange (void) const
 {
+  m_positionValid = false;
   m_courseChangeTrace (this);
 }
 
@@ -113,5 +144,11 @@ MobilityModel::DoAssignStreams (int64_t start)
   return 0;
 }
 
+bool
+MobilityModel::DoIsStationary (void) const
+{
+  return false;
+}
+
 
 } // namespace ns3
@@ -22,6 +22,7 @@
 
 #include "ns3/vector.h"
 #include "ns3/object.h"
+#include "ns3/nstime.h"
 #include "ns3/traced-callback.h"
 
 namespace ns3 {
@@ -35,6 +36,12 @@ namespace ns3 {
  * metric international units.
  *
  * This is a base class for all specific mobility models.
+ *
+ * The position returned by GetPosition is kept until the simulation
+ * time advances, so that the channels, which look at the position of
+ * the sender once per receiver, only compute it once per event.  A
+ * model whose position does not move (see IsStationary) keeps it until
+ * its next course change.
  */
 class MobilityModel : public Object
 {
@@ -59,6 +66,13 @@ public:
    * \return the current velocity.
    */
   Vector GetVelocity (void) const;
+  /**
+   * \return true if the position will not change before the next
+   * course change notification.  The distance between two stationary
+   * models, and anything computed from it, can be kept until one of
+   * them fires its CourseChange trace.
+   */
+  bool IsStationary (void) const;
   /**
    * \param position a reference to another mobility model
    * \return the distance between the two objects. Unit is meters.
@@ -107,6 +121,14 @@ protected:
    */
   void NotifyCourseChange (void) const;
 private:
+  /**
+   * \return true if the position of the model cannot change until it
+   * calls NotifyCourseChange or SetPosition is called.
+   *
+   * The default implementation returns false, in which case the
+   * position is computed again at each simulation time it is asked for.
+   */
+  virtual bool DoIsStationary (void) const;
   /**
    * \return the current position.
    *
@@ -143,6 +165,16 @@ private:
    */
   ns3::TracedCallback<Ptr<const MobilityModel> > m_courseChangeTrace;
 
+  /**
+   * Compute the current position and keep it until it may change.
+   */
+  void UpdatePosition (void) const;
+
+  mutable Vector m_position;      //!< the last position returned by DoGetPosition
+  mutable Time m_positionTime;    //!< the time m_position was computed at
+  mutable bool m_positionValid;   //!< m_position was computed after the last course change
+  mutable bool m_stationary;      //!< m_position is valid until the next course change
+
 };
 
 } // namespace ns3
@@ -112,6 +112,13 @@ RandomWaypointMobilityModel::DoGetVelocity (void) const
 {
   return m_helper.GetVelocity ();
 }
+bool
+RandomWaypointMobilityModel::DoIsStationary (void) const
+{
+  // the course changes are notified when the node starts or stops moving
+  Vector velocity = m_helper.GetVelocity ();
+  return velocity.x == 0 && velocity.y == 0 && velocity.z == 0;
+}
 int64_t
 RandomWaypointMobilityModel::DoAssignStreams (int64_t stream)
 {
@@ -30,6 +30,8 @@
 #include "ns3/vector.h"
 #include "ns3/mobility-model.h"
 #include "ns3/waypoint-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/constant-position-mobility-model.h"
 #include "ns3/mobility-helper.h"
 
 using namespace ns3;
@@ -354,6 +356,66 @@ WaypointMobilityModelViaHelper::DoRun (void)
   Simulator::Destroy ();
 }
 
+// Test that the position kept by MobilityModel follows the course changes
+class MobilityModelPositionCache : public TestCase
+{
+public:
+  MobilityModelPositionCache ();
+  virtual ~MobilityModelPositionCache ();
+
+private:
+  void TestPosition (Ptr<const MobilityModel> mob, double expectedXPos, bool stationary);
+  void TestDistance (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, double expectedDistance);
+  virtual void DoRun (void);
+};
+
+MobilityModelPositionCache::MobilityModelPositionCache ()
+  : TestCase ("Test the position kept between course changes")
+{
+}
+
+MobilityModelPositionCache::~MobilityModelPositionCache ()
+{
+}
+
+void
+MobilityModelPositionCache::TestPosition (Ptr<const MobilityModel> mob, double expectedXPos, bool stationary)
+{
+  Vector pos = mob->GetPosition ();
+  NS_TEST_EXPECT_MSG_EQ_TOL_INTERNAL (pos.x, expectedXPos, 0.001, "Position not equal", __FILE__, __LINE__);
+  NS_TEST_EXPECT_MSG_EQ_INTERNAL (mob->IsStationary (), stationary, "Unexpected stationary state", __FILE__, __LINE__);
+}
+
+void
+MobilityModelPositionCache::TestDistance (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, double expectedDistance)
+{
+  NS_TEST_EXPECT_MSG_EQ_TOL_INTERNAL (a->GetDistanceFrom (b), expectedDistance, 0.001, "Distance not equal", __FILE__, __LINE__);
+}
+
+void
+MobilityModelPositionCache::DoRun (void)
+{
+  Ptr<ConstantVelocityMobilityModel> mob = CreateObject<ConstantVelocityMobilityModel> ();
+  mob->SetPosition (Vector (0.0, 0.0, 0.0));
+  mob->SetVelocity (Vector (1.0, 0.0, 0.0));
+  Ptr<ConstantPositionMobilityModel> fixed = CreateObject<ConstantPositionMobilityModel> ();
+  fixed->SetPosition (Vector (10.0, 0.0, 0.0));
+
+  Simulator::Schedule (Seconds (1), &MobilityModelPositionCache::TestPosition, this, mob, 1, false);
+  Simulator::Schedule (Seconds (1), &ConstantVelocityMobilityModel::SetVelocity, mob, Vector (0.0, 0.0, 0.0));
+  Simulator::Schedule (Seconds (1), &MobilityModelPositionCache::TestPosition, this, mob, 1, true);
+  Simulator::Schedule (Seconds (2), &MobilityModelPositionCache::TestPosition, this, mob, 1, true);
+  Simulator::Schedule (Seconds (2), &MobilityModel::SetPosition, mob, Vector (5.0, 0.0, 0.0));
+  Simulator::Schedule (Seconds (2), &MobilityModelPositionCache::TestPosition, this, mob, 5, true);
+  Simulator::Schedule (Seconds (3), &ConstantVelocityMobilityModel::SetVelocity, mob, Vector (2.0, 0.0, 0.0));
+  Simulator::Schedule (Seconds (3), &MobilityModelPositionCache::TestPosition, this, mob, 5, false);
+  Simulator::Schedule (Seconds (4), &MobilityModelPositionCache::TestPosition, this, mob, 7, false);
+  Simulator::Schedule (Seconds (4), &MobilityModelPositionCache::TestPosition, this, fixed, 10, true);
+  Simulator::Schedule (Seconds (4), &MobilityModelPositionCache::TestDistance, this, mob, fixed, 3);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
 class MobilityTestSuite : public TestSuite
 {
 public:
@@ -367,6 +429,7 @@ MobilityTestSuite::MobilityTestSuite ()
   AddTestCase (new WaypointLazyNotifyTrue, TestCase::QUICK);
   AddTestCase (new WaypointInitialPositionIsWaypoint, TestCase::QUICK);
   AddTestCase (new WaypointMobilityModelViaHelper, TestCase::QUICK);
+  AddTestCase (new MobilityModelPositionCache, TestCase::QUICK);
 }
 
 static MobilityTestSuite mobilityTestSuite;
@@ -20,16 +20,19 @@
 #include "distributed-simulator-impl.h"
 #include "granted-time-window-mpi-interface.h"
 #include "mpi-interface.h"
+#include "mpi-remote-channel.h"
 
 #include "ns3/simulator.h"
 #include "ns3/scheduler.h"
 #include "ns3/event-impl.h"
 #include "ns3/channel.h"
+#include "ns3/channel-list.h"
 #include "ns3/node-container.h"
 #include "ns3/ptr.h"
 #include "ns3/pointer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 
 #include <cmath>
 
@@ -229,6 +232,30 @@ DistributedSimulatorImpl::CalculateLookAhead (void)
                 }
             }
         }
+
+      // shared-medium channels spanning several tasks report their own
+      // minimum latency towards each remote task
+      for (ChannelList::Iterator iter = ChannelList::Begin (); iter != ChannelList::End (); ++iter)
+        {
+          MpiRemoteChannel *remoteChannel = dynamic_cast<MpiRemoteChannel *> (PeekPointer (*iter));
+          if (remoteChannel == 0)
+            {
+              continue;
+            }
+          for (uint32_t systemId = 0; systemId < MpiInterface::GetSize (); ++systemId)
+            {
+              if (systemId == MpiInterface::GetSystemId ())
+                {
+                  continue;
+                }
+              Time delay = remoteChannel->GetRemoteLookAhead (systemId);
+              NS_ABORT_MSG_IF (delay.IsZero (), "A remote channel has a zero lookahead towards task " << systemId);
+              if (delay.IsPositive () && delay < m_lookAhead)
+                {
+                  m_lookAhead = delay;
+                }
+            }
+        }
     }
 
   // m_lookAhead is now set
@@ -0,0 +1,56 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_MPI_REMOTE_CHANNEL_H
+#define NS3_MPI_REMOTE_CHANNEL_H
+
+#include <ns3/nstime.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup mpi
+ *
+ * \brief Interface for shared-medium channels whose devices may live on
+ * several MPI tasks.
+ *
+ * The distributed simulator implementations only know how to derive
+ * lookahead from the "Delay" attribute of remote point-to-point links.
+ * A broadcast channel (e.g. a wireless channel) connects a local device
+ * to devices on many ranks, each with a different minimum latency, so it
+ * implements this interface instead.  During CalculateLookAhead every
+ * channel in the ChannelList that implements it is asked for the minimum
+ * latency towards each remote task.
+ */
+class MpiRemoteChannel
+{
+public:
+  virtual ~MpiRemoteChannel ();
+
+  /**
+   * \param systemId the rank of a remote task
+   * \return the minimum time between a transmission started by a device of
+   * this channel on the local task and its first effect on a device of
+   * this channel on task systemId, or a negative time if the channel does
+   * not connect the two tasks. A zero lookahead would stop the tasks from
+   * ever advancing, so the simulator aborts on it.
+   */
+  virtual Time GetRemoteLookAhead (uint32_t systemId) const = 0;
+};
+
+} // namespace ns3
+
+#endif /* NS3_MPI_REMOTE_CHANNEL_H */
@@ -25,17 +25,20 @@
 #include "remote-channel-bundle-manager.h"
 #include "remote-channel-bundle.h"
 #include "mpi-interface.h"
+#include "mpi-remote-channel.h"
 
 #include <ns3/simulator.h>
 #include <ns3/scheduler.h>
 #include <ns3/event-impl.h>
 #include <ns3/channel.h>
+#include <ns3/channel-list.h>
 #include <ns3/node-container.h>
 #include <ns3/double.h>
 #include <ns3/ptr.h>
 #include <ns3/pointer.h>
 #include <ns3/assert.h>
 #include <ns3/log.h>
+#include <ns3/abort.h>
 
 #include <cmath>
 #include <iostream>
@@ -199,6 +202,36 @@ NullMessageSimulatorImpl::CalculateLookAhead (void)
               remoteChannelBundle->AddChannel (channel, delay.Get () );
             }
         }
+
+      // shared-medium channels spanning several tasks join the bundle of
+      // every remote task they reach, with their own minimum latency
+      for (ChannelList::Iterator iter = ChannelList::Begin (); iter != ChannelList::End (); ++iter)
+        {
+          MpiRemoteChannel *remoteChannel = dynamic_cast<MpiRemoteChannel *> (PeekPointer (*iter));
+          if (remoteChannel == 0)
+            {
+              continue;
+            }
+          for (uint32_t systemId = 0; systemId < MpiInterface::GetSize (); ++systemId)
+            {
+              if (systemId == MpiInterface::GetSystemId ())
+                {
+                  continue;
+                }
+              Time delay = remoteChannel->GetRemoteLookAhead (systemId);
+              NS_ABORT_MSG_IF (delay.IsZero (), "A remote channel has a zero lookahead towards task " << systemId);
+              if (delay.IsStrictlyNegative ())
+                {
+                  continue;
+                }
+              Ptr<RemoteChannelBundle> remoteChannelBundle = RemoteChannelBundleManager::Find (systemId);
+              if (!remoteChannelBundle)
+                {
+                  remoteChannelBundle = RemoteChannelBundleManager::Add (systemId);
+                }
+              remoteChannelBundle->AddChannel (*iter, delay);
+            }
+        }
     }
 
   // Completed setup of remote channel bundles.  Setup send and receive buffers.
@@ -51,6 +51,7 @@ NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 
 uint32_t Buffer::g_recommendedStart = 0;
+uint32_t Buffer::g_reservedHeadroom = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -244,7 +245,7 @@ void
 Buffer::Initialize (uint32_t zeroSize)
 {
   NS_LOG_FUNCTION (this << zeroSize);
-  m_data = Buffer::Create (0);
+  m_data = Buffer::Create (g_reservedHeadroom);
   m_start = std::min (m_data->m_size, g_recommendedStart);
   m_maxZeroAreaStart = m_start;
   m_zeroAreaStart = m_start;
@@ -292,6 +293,14 @@ Buffer::~Buffer ()
     }
 }
 
+void
+Buffer::ReserveHeadroom (uint32_t headroom)
+{
+  NS_LOG_FUNCTION (headroom);
+  g_reservedHeadroom = std::max (g_reservedHeadroom, headroom);
+  g_recommendedStart = std::max (g_recommendedStart, headroom);
+}
+
 uint32_t
 Buffer::GetInternalSize (void) const
 {
@@ -638,6 +638,25 @@ private:
    */
   Buffer (uint32_t dataSize, bool initialize);
   ~Buffer ();
+
+  /**
+   * \brief Reserve room for headers in front of the new buffers.
+   *
+   * The buffers created from now on have at least \p headroom bytes
+   * allocated in front of their data, so adding up to that many bytes
+   * of headers does not reallocate them. A NetDevice calls this with
+   * the size of the headers a packet gets on its way down to it, which
+   * the buffers would otherwise only learn from the first packets.
+   *
+   * The headroom is global to the process, not tied to the device
+   * which reserves it: it applies to every Buffer created afterwards,
+   * in every module, and it only grows, to the largest value ever
+   * reserved. Each Buffer thus costs up to \p headroom more bytes,
+   * including the buffers of packets which never reach the device.
+   *
+   * \param headroom the number of bytes to reserve
+   */
+  static void ReserveHeadroom (uint32_t headroom);
 private:
   /**
    * This data structure is variable-sized through its last member whose size
@@ -764,6 +783,11 @@ private:
    * value.
    */
   static uint32_t g_recommendedStart;
+  /**
+   * the smallest number of bytes allocated in front of the data of
+   * a new buffer, see ReserveHeadroom
+   */
+  static uint32_t g_reservedHeadroom;
 
   /**
    * offset to the start of the virtual zero area from the start
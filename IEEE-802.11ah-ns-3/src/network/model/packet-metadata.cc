@@ -31,6 +31,13 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketMetadata");
 
+/**
+ * Set to true when PacketMetadata::m_freeList has been destroyed by the
+ * static destructors, so that the data of the remaining packets is
+ * deallocated instead of recycled.
+ */
+static bool g_freeListDestroyed = false;
+
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
@@ -45,7 +52,9 @@ PacketMetadata::DataFreeList::~DataFreeList ()
     {
       PacketMetadata::Deallocate (*i);
     }
+  clear ();
   PacketMetadata::m_enable = false;
+  g_freeListDestroyed = true;
 }
 
 void 
@@ -597,7 +606,9 @@ void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  if (!m_enable)
+  // the data of every packet is recycled, even when the metadata is
+  // disabled: each packet still gets a small data block.
+  if (g_freeListDestroyed)
     {
       PacketMetadata::Deallocate (data);
       return;
@@ -29,11 +29,67 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 #include <cstring>
+#include <vector>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
+/**
+ * \brief Container of the nodes freed by PacketTagList::FreeTagData
+ *
+ * Internal use only.
+ */
+static class TagDataFreeList : public std::vector<struct PacketTagList::TagData *>
+{
+public:
+  ~TagDataFreeList ();
+} g_freeList; //!< Nodes ready to be reused by PacketTagList::CreateTagData
+/**
+ * Set to true when g_freeList has been destroyed by the static
+ * destructors, so that the nodes of the remaining packets are deleted.
+ */
+static bool g_freeListDestroyed = false;
+
+TagDataFreeList::~TagDataFreeList ()
+{
+  for (TagDataFreeList::iterator i = begin (); i != end (); i++)
+    {
+      delete *i;
+    }
+  clear ();
+  g_freeListDestroyed = true;
+}
+
+uint16_t
+PacketTagList::GetMaskBit (TypeId tid)
+{
+  return static_cast<uint16_t> (1 << (tid.GetUid () & 0xf));
+}
+
+struct PacketTagList::TagData *
+PacketTagList::CreateTagData (void)
+{
+  if (g_freeList.empty ())
+    {
+      return new struct TagData ();
+    }
+  struct TagData *data = g_freeList.back ();
+  g_freeList.pop_back ();
+  return data;
+}
+
+void
+PacketTagList::FreeTagData (struct TagData *data)
+{
+  if (g_freeListDestroyed || g_freeList.size () > 1000)
+    {
+      delete data;
+      return;
+    }
+  g_freeList.push_back (data);
+}
+
 bool
 PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
 {
@@ -41,8 +97,8 @@ PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
   NS_LOG_FUNCTION (this << tid);
   NS_LOG_INFO     ("looking for " << tid);
 
-  // trivial case when list is empty
-  if (m_next == 0)
+  // trivial case when list is empty or cannot hold tid
+  if (m_next == 0 || (m_next->mask & GetMaskBit (tid)) == 0)
     {
       return false;
     }
@@ -133,8 +189,9 @@ PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
       NS_ASSERT (cur != 0);
       NS_ASSERT (cur->count > 1);
       cur->count--;                       // unmerge cur
-      struct TagData * copy = new struct TagData ();
+      struct TagData * copy = CreateTagData ();
       copy->tid = cur->tid;
+      copy->mask = cur->mask;
       copy->count = 1;
       memcpy (copy->data, cur->data, TagData::MAX_SIZE);
       copy->next = cur->next;             // merge into tail
@@ -177,7 +234,7 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
   if (preMerge)
     {
       // found tid before first merge, so delete cur
-      delete cur;
+      FreeTagData (cur);
     }
   else
     {
@@ -225,8 +282,9 @@ PacketTagList::ReplaceWriter (Tag & tag, bool preMerge,
       // cur is always a merge at this point
       // need to copy, replace, and link past cur
       cur->count--;                     // unmerge cur
-      struct TagData * copy = new struct TagData ();
+      struct TagData * copy = CreateTagData ();
       copy->tid = tag.GetInstanceTypeId ();
+      copy->mask = cur->mask;
       copy->count = 1;
       tag.Serialize (TagBuffer (copy->data,
                                 copy->data + tag.GetSerializedSize ()));
@@ -249,11 +307,15 @@ PacketTagList::Add (const Tag &tag) const
     {
       NS_ASSERT_MSG (cur->tid != tag.GetInstanceTypeId (), "Error: cannot add the same kind of tag twice.");
     }
-  struct TagData * head = new struct TagData ();
+  struct TagData * head = CreateTagData ();
   head->count = 1;
-  head->next = 0;
   head->tid = tag.GetInstanceTypeId ();
+  head->mask = GetMaskBit (head->tid);
   head->next = m_next;
+  if (m_next != 0)
+    {
+      head->mask |= m_next->mask;
+    }
   NS_ASSERT (tag.GetSerializedSize () <= TagData::MAX_SIZE);
   tag.Serialize (TagBuffer (head->data, head->data + tag.GetSerializedSize ()));
 
@@ -265,6 +327,10 @@ PacketTagList::Peek (Tag &tag) const
 {
   NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
   TypeId tid = tag.GetInstanceTypeId ();
+  if (m_next == 0 || (m_next->mask & GetMaskBit (tid)) == 0)
+    {
+      return false;
+    }
   for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
     {
       if (cur->tid == tid) 
@@ -164,6 +164,7 @@ public:
     uint8_t data[MAX_SIZE];   /**< Serialization buffer */
     struct TagData * next;   /**< Pointer to next in list */
     TypeId tid;               /**< Type of the tag serialized into #data */
+    uint16_t mask;            /**< Union of the GetMaskBit of this tag and of the tags after it */
     uint32_t count;           /**< Number of incoming links */
   };  /* struct TagData */
 
@@ -287,6 +288,28 @@ private:
    */
   bool ReplaceWriter (Tag & tag, bool preMerge, struct TagData * cur, struct TagData ** prevNext);
 
+  /**
+   * The bit of a tag type in TagData::mask.
+   *
+   * The mask of the head of the list tells whether a tag type can be on
+   * the list without walking it. It may have bits of tags which have
+   * been removed since, but never misses the bit of a tag on the list.
+   *
+   * \param [in] tid The tag type.
+   * \returns The bit of the tag type.
+   */
+  static uint16_t GetMaskBit (TypeId tid);
+  /**
+   * \returns A new node, taken from the free list if possible.
+   */
+  static struct TagData * CreateTagData (void);
+  /**
+   * Return a node which is not referenced any more to the free list.
+   *
+   * \param [in] data The node.
+   */
+  static void FreeTagData (struct TagData *data);
+
   /**
    * Pointer to first \ref TagData on the list
    */
@@ -350,13 +373,13 @@ PacketTagList::RemoveAll (void)
         }
       if (prev != 0) 
         {
-	  delete prev;
+          FreeTagData (prev);
         }
       prev = cur;
     }
   if (prev != 0) 
     {
-      delete prev;
+      FreeTagData (prev);
     }
   m_next = 0;
 }
@@ -727,6 +727,23 @@ PacketTagListTest::DoRun (void)
     NS_TEST_EXPECT_MSG_EQ (ref.Peek (t10), false, "missing tag");
   }
 
+  { // Peek after Remove and Add
+    std::cout << GetName () << "check Peek after removing and adding back"
+              << std::endl;
+    PacketTagList ptl = ref;
+    ptl.Remove (t7);
+    ptl.Remove (t1);
+    CheckRef (ptl, t1, "removed last", true);
+    CheckRef (ptl, t7, "removed first", true);
+    ptl.Add (t1);
+    CheckRef (ptl, t1, "added back last");
+    ptl.Add (t7);
+    CheckRefList (ptl, "added back both");
+    ptl.RemoveAll ();
+    CheckRef (ptl, t4, "remove all", true);
+    CheckRefList (ref, "remove all orig");
+  }
+
   { // Copy ctor, assignment
     std::cout << GetName () << "check copy and assignment" << std::endl;
     { PacketTagList ptl (ref);
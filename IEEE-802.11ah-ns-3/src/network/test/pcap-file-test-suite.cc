@@ -1066,6 +1066,100 @@ ReadFileTestCase::DoRun (void)
   f.Close ();
 }
 
+// ===========================================================================
+// Test case to make sure that records written through the stream buffer
+// all reach the file, whether it is flushed or closed.
+// ===========================================================================
+class BufferedWriteTestCase : public TestCase
+{
+public:
+  BufferedWriteTestCase ();
+  virtual ~BufferedWriteTestCase ();
+
+private:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+
+  std::string m_testFilename;
+};
+
+BufferedWriteTestCase::BufferedWriteTestCase ()
+  : TestCase ("Check to see that buffered records are all written out")
+{
+}
+
+BufferedWriteTestCase::~BufferedWriteTestCase ()
+{
+}
+
+void
+BufferedWriteTestCase::DoSetup (void)
+{
+  std::stringstream filename;
+  uint32_t n = rand ();
+  filename << n;
+  m_testFilename = CreateTempDirFilename (filename.str () + ".pcap");
+}
+
+void
+BufferedWriteTestCase::DoTeardown (void)
+{
+  if (remove (m_testFilename.c_str ()))
+    {
+      NS_LOG_ERROR ("Failed to delete file " << m_testFilename);
+    }
+}
+
+void
+BufferedWriteTestCase::DoRun (void)
+{
+  PcapFile f;
+
+  f.Open (m_testFilename, std::ios::out);
+  NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << m_testFilename << 
+                         ", \"std::ios::out\") returns error");
+  f.Init (1, 100);
+
+  //
+  // Write several times the size of the stream buffer, with packets larger
+  // than the snap length so that they are truncated.
+  //
+  const uint32_t nPackets = 2000;
+  uint8_t bufferOut[128];
+  for (uint32_t i = 0; i < nPackets; ++i)
+    {
+      memset (bufferOut, i & 0xff, sizeof (bufferOut));
+      f.Write (i, 0, bufferOut, sizeof (bufferOut));
+    }
+  NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Write () returns error");
+
+  f.Flush ();
+  NS_TEST_ASSERT_MSG_EQ (CheckFileLength (m_testFilename, 24 + nPackets * (16 + 100)), true,
+                         "Flushed pcap file has the wrong length");
+
+  f.Write (nPackets, 0, bufferOut, 10);
+  f.Close ();
+  NS_TEST_ASSERT_MSG_EQ (CheckFileLength (m_testFilename, 24 + nPackets * (16 + 100) + 16 + 10), true,
+                         "Closed pcap file has the wrong length");
+
+  f.Open (m_testFilename, std::ios::in);
+  NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << m_testFilename << 
+                         ", \"std::ios::in\") returns error");
+
+  uint8_t data[128];
+  uint32_t tsSec, tsUsec, inclLen, origLen, readLen;
+  for (uint32_t i = 0; i <= nPackets; ++i)
+    {
+      f.Read (data, sizeof (data), tsSec, tsUsec, inclLen, origLen, readLen);
+      NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Read () returns error");
+      NS_TEST_ASSERT_MSG_EQ (tsSec, i, "Records read out of order");
+      NS_TEST_ASSERT_MSG_EQ (inclLen, (i < nPackets ? 100 : 10), "Wrong included length");
+      NS_TEST_ASSERT_MSG_EQ (data[0], (i < nPackets ? i & 0xff : (nPackets - 1) & 0xff), "Wrong packet data");
+    }
+  f.Close ();
+}
+
 // ===========================================================================
 // Test case to make sure that the Pcap::Diff method works as expected
 // ===========================================================================
@@ -1138,6 +1232,7 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new BufferedWriteTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite;
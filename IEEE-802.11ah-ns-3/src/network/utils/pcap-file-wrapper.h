@@ -82,6 +82,11 @@ public:
    */
   void Close (void);
 
+  /**
+   * Write the buffered packets to the underlying pcap file.
+   */
+  void Flush (void);
+
   /**
    * Initialize the pcap file associated with this wrapper.  This file must have
    * been previously opened with write permissions.
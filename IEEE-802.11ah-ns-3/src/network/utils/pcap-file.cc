@@ -28,7 +28,6 @@
 #include "ns3/buffer.h"
 #include "pcap-file.h"
 #include "ns3/log.h"
-#include "ns3/build-profile.h"
 //
 // This file is used as part of the ns-3 test framework, so please refrain from 
 // adding any ns-3 specific constructs such as Packet to this file.
@@ -48,11 +47,15 @@ const uint16_t VERSION_MAJOR = 2;             /**< Major version of supported pc
 const uint16_t VERSION_MINOR = 4;             /**< Minor version of supported pcap file format */
 
 PcapFile::PcapFile ()
-  : m_file (),
+  : m_buffer (BUFFER_SIZE),
+    m_file (),
     m_swapMode (false),
     m_nanosecMode (false)
 {
   NS_LOG_FUNCTION (this);
+  // must be done before the file is opened; the buffer is kept across
+  // Close and Open
+  m_file.rdbuf ()->pubsetbuf (&m_buffer[0], m_buffer.size ());
   FatalImpl::RegisterStream (&m_file); 
 }
 
@@ -91,6 +94,13 @@ PcapFile::Close (void)
   m_file.close ();
 }
 
+void
+PcapFile::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_file.flush ();
+}
+
 uint32_t
 PcapFile::GetMagic (void)
 {
@@ -419,14 +429,15 @@ PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
     }
 
   //
-  // Watch out for memory alignment differences between machines, so write
-  // them all individually.
+  // Watch out for memory alignment differences between machines, so copy
+  // the fields individually, then write the record header at once.
   //
-  m_file.write ((const char *)&header.m_tsSec, sizeof(header.m_tsSec));
-  m_file.write ((const char *)&header.m_tsUsec, sizeof(header.m_tsUsec));
-  m_file.write ((const char *)&header.m_inclLen, sizeof(header.m_inclLen));
-  m_file.write ((const char *)&header.m_origLen, sizeof(header.m_origLen));
-  NS_BUILD_DEBUG(m_file.flush());
+  uint32_t fields[4];
+  fields[0] = header.m_tsSec;
+  fields[1] = header.m_tsUsec;
+  fields[2] = header.m_inclLen;
+  fields[3] = header.m_origLen;
+  m_file.write ((const char *)fields, sizeof(fields));
   return inclLen;
 }
 
@@ -436,7 +447,6 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, ui
   NS_LOG_FUNCTION (this << tsSec << tsUsec << &data << totalLen);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalLen);
   m_file.write ((const char *)data, inclLen);
-  NS_BUILD_DEBUG(m_file.flush());
 }
 
 void 
@@ -445,7 +455,6 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
   NS_LOG_FUNCTION (this << tsSec << tsUsec << p);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, p->GetSize ());
   p->CopyData (&m_file, inclLen);
-  NS_BUILD_DEBUG(m_file.flush());
 }
 
 void 
@@ -23,6 +23,7 @@
 
 #include <string>
 #include <fstream>
+#include <vector>
 #include <stdint.h>
 #include "ns3/ptr.h"
 
@@ -85,6 +86,15 @@ public:
    */
   void Close (void);
 
+  /**
+   * Write the buffered records to the underlying file.
+   *
+   * Records are buffered in memory and only reach the file when the
+   * buffer is full, when the file is closed, or when this method is
+   * called.
+   */
+  void Flush (void);
+
   /**
    * Initialize the pcap file associated with this object.  This file must have
    * been previously opened with write permissions.
@@ -362,7 +372,10 @@ private:
    */
   void ReadAndVerifyFileHeader (void);
 
+  static const uint32_t BUFFER_SIZE = 64 * 1024; //!< size of the stream buffer
+
   std::string    m_filename;    //!< file name
+  std::vector<char> m_buffer;   //!< stream buffer of m_file
   std::fstream   m_file;        //!< file stream
   PcapFileHeader m_fileHeader;  //!< file header
   bool m_swapMode;              //!< swap mode
@@ -36,6 +36,7 @@
 #include <ns3/angles.h>
 #include <iostream>
 #include <utility>
+#include <algorithm>
 #include "multi-model-spectrum-channel.h"
 
 
@@ -82,6 +83,7 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
+  : m_numDevices (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -161,10 +163,11 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
        rxInfoIterator !=  m_rxSpectrumModelInfoMap.end ();
        ++rxInfoIterator)
     {
-      std::set<Ptr<SpectrumPhy> >::iterator phyIt = rxInfoIterator->second.m_rxPhySet.find (phy);
-      if (phyIt !=  rxInfoIterator->second.m_rxPhySet.end ())
+      std::vector<Ptr<SpectrumPhy> > &rxPhys = rxInfoIterator->second.m_rxPhys;
+      std::vector<Ptr<SpectrumPhy> >::iterator phyIt = std::find (rxPhys.begin (), rxPhys.end (), phy);
+      if (phyIt != rxPhys.end ())
         {
-          rxInfoIterator->second.m_rxPhySet.erase (phyIt);
+          rxPhys.erase (phyIt);
           --m_numDevices;
           break; // there should be at most one entry
         }       
@@ -180,9 +183,8 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
       std::pair<RxSpectrumModelInfoMap_t::iterator, bool> ret;
       ret = m_rxSpectrumModelInfoMap.insert (std::make_pair (rxSpectrumModelUid, RxSpectrumModelInfo (rxSpectrumModel)));
       NS_ASSERT (ret.second);
-      // also add the phy to the newly created set of SpectrumPhy for this RxSpectrumModel
-      std::pair<std::set<Ptr<SpectrumPhy> >::iterator, bool> ret2 = ret.first->second.m_rxPhySet.insert (phy);
-      NS_ASSERT (ret2.second);
+      // also add the phy to the newly created list of SpectrumPhy for this RxSpectrumModel
+      ret.first->second.m_rxPhys.push_back (phy);
 
       // and create the necessary converters for all the TX spectrum models that we know of
       for (TxSpectrumModelInfoMap_t::iterator txInfoIterator = m_txSpectrumModelInfoMap.begin ();
@@ -200,14 +202,13 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
   else
     {
       // spectrum model is already known, just add the device to the corresponding list
-      std::pair<std::set<Ptr<SpectrumPhy> >::iterator, bool> ret2 = rxInfoIterator->second.m_rxPhySet.insert (phy);
-      NS_ASSERT (ret2.second);
+      rxInfoIterator->second.m_rxPhys.push_back (phy);
     }
 
 }
 
 
-TxSpectrumModelInfoMap_t::const_iterator
+TxSpectrumModelInfoMap_t::iterator
 MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel)
 {
   NS_LOG_FUNCTION (this << txSpectrumModel);
@@ -249,7 +250,28 @@ MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel (Ptr<const Spectr
   return txInfoIterator;
 }
 
-    
+
+Ptr<SpectrumValue>
+MultiModelSpectrumChannel::ConvertTxPowerSpectrum (TxSpectrumModelInfo &txInfo,
+                                                   SpectrumModelUid_t rxSpectrumModelUid,
+                                                   Ptr<const SpectrumValue> txPsd)
+{
+  TxSpectrumModelInfo::ConvertedPsd &converted = txInfo.m_convertedPsdMap[rxSpectrumModelUid];
+  if (converted.txPsd != 0
+      && std::equal (txPsd->ConstValuesBegin (), txPsd->ConstValuesEnd (), converted.txPsd->ConstValuesBegin ()))
+    {
+      NS_LOG_LOGIC (" reusing the previous conversion to SpectrumModelUid " << rxSpectrumModelUid);
+      return converted.rxPsd;
+    }
+
+  NS_LOG_LOGIC (" converting txPowerSpectrum SpectrumModelUids" << txPsd->GetSpectrumModelUid () << " --> " << rxSpectrumModelUid);
+  SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfo.m_spectrumConverterMap.find (rxSpectrumModelUid);
+  NS_ASSERT (rxConverterIterator != txInfo.m_spectrumConverterMap.end ());
+  converted.txPsd = txPsd->Copy ();
+  converted.rxPsd = rxConverterIterator->second.Convert (txPsd);
+  return converted.rxPsd;
+}
+
 
 void
 MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
@@ -265,7 +287,7 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC (" txSpectrumModelUid " << txSpectrumModelUid);
 
   //
-  TxSpectrumModelInfoMap_t::const_iterator txInfoIteratorerator = FindAndEventuallyAddTxSpectrumModel (txParams->psd->GetSpectrumModel ());
+  TxSpectrumModelInfoMap_t::iterator txInfoIteratorerator = FindAndEventuallyAddTxSpectrumModel (txParams->psd->GetSpectrumModel ());
   NS_ASSERT (txInfoIteratorerator != m_txSpectrumModelInfoMap.end ());
 
   NS_LOG_LOGIC ("converter map for TX SpectrumModel with Uid " << txInfoIteratorerator->first);
@@ -279,97 +301,108 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
       SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid ();
       NS_LOG_LOGIC (" rxSpectrumModelUids " << rxSpectrumModelUid);
 
+      // converted only once a receiver in range is found
       Ptr <SpectrumValue> convertedTxPowerSpectrum;
-      if (txSpectrumModelUid == rxSpectrumModelUid)
-        {
-          NS_LOG_LOGIC ("no spectrum conversion needed");
-          convertedTxPowerSpectrum = txParams->psd;
-        }
-      else
-        {
-          NS_LOG_LOGIC (" converting txPowerSpectrum SpectrumModelUids" << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
-          SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIteratorerator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
-          NS_ASSERT (rxConverterIterator != txInfoIteratorerator->second.m_spectrumConverterMap.end ());
-          convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
-        }
-
 
-      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
-           rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
+      for (std::vector<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin ();
+           rxPhyIterator != rxInfoIterator->second.m_rxPhys.end ();
            ++rxPhyIterator)
         {
           NS_ASSERT_MSG ((*rxPhyIterator)->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
                          "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
 
-          if ((*rxPhyIterator) != txParams->txPhy)
+          if ((*rxPhyIterator) == txParams->txPhy)
             {
-              NS_LOG_LOGIC (" copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
-              Time delay = MicroSeconds (0);
+              continue;
+            }
 
-              Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
+          // the single-frequency loss is evaluated first, so that the
+          // receivers out of range cost neither a copy of the signal
+          // parameters nor the spectrum propagation loss
+          Time delay = MicroSeconds (0);
+          double pathGainLinear = 1;
+          Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
 
-              if (txMobility && receiverMobility)
+          if (txMobility && receiverMobility)
+            {
+              double pathLossDb = 0;
+              if (txParams->txAntenna != 0)
+                {
+                  Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
+                  double txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
+                  NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+                  pathLossDb -= txAntennaGain;
+                }
+              Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
+              if (rxAntenna != 0)
+                {
+                  Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
+                  double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+                  NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+                  pathLossDb -= rxAntennaGain;
+                }
+              if (m_propagationLoss)
+                {
+                  double propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
+                  NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+                  pathLossDb -= propagationGainDb;
+                }
+              NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+              m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
+              if ( pathLossDb > m_maxLossDb)
                 {
-                  double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
-                    {
-                      Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      double txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                      pathLossDb -= txAntennaGain;
-                    }
-                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-                  if (rxAntenna != 0)
-                    {
-                      Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
-                      double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                      pathLossDb -= rxAntennaGain;
-                    }
-                  if (m_propagationLoss)
-                    {
-                      double propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
-                      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                      pathLossDb -= propagationGainDb;
-                    }                    
-                  NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");    
-                  m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
-                  if ( pathLossDb > m_maxLossDb)
-                    {
-                      // beyond range
-                      continue;
-                    }
-                  double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-                  *(rxParams->psd) *= pathGainLinear;              
-
-                  if (m_spectrumPropagationLoss)
-                    {
-                      rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
-                    }
-
-                  if (m_propagationDelay)
-                    {
-                      delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
-                    }
+                  // beyond range
+                  continue;
                 }
+              pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
 
-              Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
-              if (netDev)
+              if (m_propagationDelay)
                 {
-                  // the receiver has a NetDevice, so we expect that it is attached to a Node
-                  uint32_t dstNode =  netDev->GetNode ()->GetId ();
-                  Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
-                                                  rxParams, *rxPhyIterator);
+                  delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
+                }
+            }
+
+          if (convertedTxPowerSpectrum == 0)
+            {
+              if (txSpectrumModelUid == rxSpectrumModelUid)
+                {
+                  NS_LOG_LOGIC ("no spectrum conversion needed");
+                  convertedTxPowerSpectrum = txParams->psd;
                 }
               else
                 {
-                  // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-                  Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
-                                       rxParams, *rxPhyIterator);
+                  convertedTxPowerSpectrum = ConvertTxPowerSpectrum (txInfoIteratorerator->second, rxSpectrumModelUid, txParams->psd);
                 }
             }
+
+          NS_LOG_LOGIC (" copying signal parameters " << txParams);
+          Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
+          rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+
+          if (txMobility && receiverMobility)
+            {
+              *(rxParams->psd) *= pathGainLinear;
+
+              if (m_spectrumPropagationLoss)
+                {
+                  rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
+                }
+            }
+
+          Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
+          if (netDev)
+            {
+              // the receiver has a NetDevice, so we expect that it is attached to a Node
+              uint32_t dstNode =  netDev->GetNode ()->GetId ();
+              Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
+                                              rxParams, *rxPhyIterator);
+            }
+          else
+            {
+              // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
+              Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
+                                   rxParams, *rxPhyIterator);
+            }
         }
 
     }
@@ -397,29 +430,18 @@ Ptr<NetDevice>
 MultiModelSpectrumChannel::GetDevice (uint32_t i) const
 {
   NS_ASSERT (i < m_numDevices);
-  // this method implementation is computationally intensive. This
-  // method would be faster if we actually used a std::vector for
-  // storing devices, which we don't due to the need to have fast 
-  // SpectrumModel conversions and to allow PHY devices to changea
-  // SpectrumModel at run time. Note that having this method slow is
-  // acceptable as it is not used much at run time (often not at all).
-  // On the other hand, having slow SpectrumModel conversion would be
-  // less acceptable. 
-  uint32_t j = 0;
+  // the devices are stored per SpectrumModel, to have fast SpectrumModel
+  // conversions and to allow PHY devices to change SpectrumModel at run
+  // time, so that the i-th one is found by skipping whole lists
   for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
        rxInfoIterator !=  m_rxSpectrumModelInfoMap.end ();
        ++rxInfoIterator)
     {
-      for (std::set<Ptr<SpectrumPhy> >::const_iterator phyIt = rxInfoIterator->second.m_rxPhySet.begin ();
-           phyIt != rxInfoIterator->second.m_rxPhySet.end ();
-           ++phyIt)        
+      if (i < rxInfoIterator->second.m_rxPhys.size ())
         {
-          if (j == i)
-            {
-              return (*phyIt)->GetDevice ();
-            }
-          j++;
+          return rxInfoIterator->second.m_rxPhys[i]->GetDevice ();
         }
+      i -= rxInfoIterator->second.m_rxPhys.size ();
     }
   NS_FATAL_ERROR ("m_numDevice > actual number of devices");
   return 0;
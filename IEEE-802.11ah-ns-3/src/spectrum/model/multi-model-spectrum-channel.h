@@ -28,7 +28,7 @@
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
 #include <map>
-#include <set>
+#include <vector>
 
 namespace ns3 {
 
@@ -53,8 +53,21 @@ public:
    */
   TxSpectrumModelInfo (Ptr<const SpectrumModel> txSpectrumModel);
 
+  /**
+   * The last PSD converted to a Rx spectrum model, and the result of
+   * the conversion. PHYs usually transmit the same PSD over and over,
+   * and comparing it with the last one is much cheaper than converting
+   * it again.
+   */
+  struct ConvertedPsd
+  {
+    Ptr<SpectrumValue> txPsd;  //!< A copy of the converted Tx PSD.
+    Ptr<SpectrumValue> rxPsd;  //!< The Tx PSD in the Rx spectrum model.
+  };
+
   Ptr<const SpectrumModel> m_txSpectrumModel;     //!< Tx Spectrum model.
   SpectrumConverterMap_t m_spectrumConverterMap;  //!< Spectrum converter.
+  std::map<SpectrumModelUid_t, ConvertedPsd> m_convertedPsdMap; //!< Last conversion to each Rx spectrum model.
 };
 
 
@@ -80,7 +93,7 @@ public:
   RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumModel);
 
   Ptr<const SpectrumModel> m_rxSpectrumModel;  //!< Rx Spectrum model.
-  std::set<Ptr<SpectrumPhy> > m_rxPhySet;      //!< Container of the Rx Spectrum phy objects.
+  std::vector<Ptr<SpectrumPhy> > m_rxPhys;     //!< Container of the Rx Spectrum phy objects.
 };
 
 /**
@@ -148,7 +161,21 @@ private:
    *
    * @return An iterator pointing to the corresponding entry in m_txSpectrumModelInfoMap
    */
-  TxSpectrumModelInfoMap_t::const_iterator FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel);
+  TxSpectrumModelInfoMap_t::iterator FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel);
+
+  /**
+   * Convert a TX PSD to a RX SpectrumModel, or reuse the result of the
+   * previous conversion if the PSD did not change since.
+   *
+   * @param txInfo The entry of the TX SpectrumModel in m_txSpectrumModelInfoMap
+   * @param rxSpectrumModelUid The RX SpectrumModel
+   * @param txPsd The TX PSD
+   *
+   * @return The TX PSD in the RX SpectrumModel, which must not be modified
+   */
+  Ptr<SpectrumValue> ConvertTxPowerSpectrum (TxSpectrumModelInfo &txInfo,
+                                             SpectrumModelUid_t rxSpectrumModelUid,
+                                             Ptr<const SpectrumValue> txPsd);
 
   /**
    * Used internally to reschedule transmission after the propagation delay.
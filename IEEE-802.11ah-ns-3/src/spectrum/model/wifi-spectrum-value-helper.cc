@@ -20,6 +20,8 @@
 
 
 #include "wifi-spectrum-value-helper.h"
+#include <ns3/assert.h>
+#include <cmath>
 
 namespace ns3 {
 
@@ -117,4 +119,121 @@ WifiSpectrumValue5MhzFactory::CreateRfFilter (uint32_t channel)
 }
 
 
+
+/// The S1G spectrum model
+static Ptr<SpectrumModel> g_WifiSpectrumModelS1g;
+
+/**
+ * Static class to initialize the values for the S1G spectrum model.
+ * The bands cover the 902-928 MHz band and the out-of-band emissions
+ * of a 16 MHz channel on both of its sides.
+ */
+static class WifiSpectrumModelS1gInitializer
+{
+public:
+  WifiSpectrumModelS1gInitializer ()
+  {
+    Bands bands;
+    for (int i = -240; i < 260 + 240; i++)
+      {
+        BandInfo bi;
+        bi.fl = 902.0e6 + i * 0.1e6;
+        bi.fh = 902.0e6 + (i + 1) * 0.1e6;
+        bi.fc = (bi.fl +  bi.fh) / 2;
+        bands.push_back (bi);
+      }
+    g_WifiSpectrumModelS1g = Create<SpectrumModel> (bands);
+  }
+} g_WifiSpectrumModelS1gInitializerInstance; //!< initialization instance for WifiSpectrumModelS1g
+
+
+WifiSpectrumValueS1gFactory::WifiSpectrumValueS1gFactory (uint32_t channelWidth)
+  : m_channelWidth (channelWidth)
+{
+  NS_ASSERT (channelWidth == 1 || channelWidth == 2 || channelWidth == 4
+             || channelWidth == 8 || channelWidth == 16);
+}
+
+WifiSpectrumValueS1gFactory::~WifiSpectrumValueS1gFactory ()
+{
+}
+
+double
+WifiSpectrumValueS1gFactory::GetCenterFrequency (uint32_t channel)
+{
+  NS_ASSERT (channel >= 1);
+  NS_ASSERT (channel <= 51);
+  return 902.0e6 + channel * 0.5e6;
+}
+
+Ptr<SpectrumValue>
+WifiSpectrumValueS1gFactory::CreateConstant (double v)
+{
+  Ptr<SpectrumValue> c = Create <SpectrumValue> (g_WifiSpectrumModelS1g);
+  (*c) = v;
+  return c;
+}
+
+
+Ptr<SpectrumValue>
+WifiSpectrumValueS1gFactory::CreateTxPowerSpectralDensity (double txPower, uint32_t channel)
+{
+  Ptr<SpectrumValue> txPsd = Create <SpectrumValue> (g_WifiSpectrumModelS1g);
+
+  // the mask is 0 dBr up to 0.45 W from the center frequency, -20 dBr
+  // at 0.5 W + 100 kHz, -28 dBr at W and -40 dBr from 1.5 W on, with a
+  // linear interpolation in dB in between
+  double fc = GetCenterFrequency (channel);
+  double width = m_channelWidth * 1e6;
+  double txPowerDensity = txPower / width;
+  const double offset[4] = { 0.45 * width, 0.5 * width + 0.1e6, width, 1.5 * width };
+  const double level[4] = { 0, -20, -28, -40 };
+
+  size_t index = 0;
+  for (Bands::const_iterator bit = txPsd->ConstBandsBegin (); bit != txPsd->ConstBandsEnd (); ++bit, ++index)
+    {
+      double df = std::fabs (bit->fc - fc);
+      double dBr = level[3];
+      if (df <= offset[0])
+        {
+          dBr = level[0];
+        }
+      else
+        {
+          for (int k = 1; k < 4; k++)
+            {
+              if (df <= offset[k])
+                {
+                  dBr = level[k - 1] + (level[k] - level[k - 1]) * (df - offset[k - 1]) / (offset[k] - offset[k - 1]);
+                  break;
+                }
+            }
+        }
+      (*txPsd)[index] = txPowerDensity * std::pow (10.0, dBr / 10.0);
+    }
+
+  return txPsd;
+}
+
+
+Ptr<SpectrumValue>
+WifiSpectrumValueS1gFactory::CreateRfFilter (uint32_t channel)
+{
+  Ptr<SpectrumValue> rf = Create <SpectrumValue> (g_WifiSpectrumModelS1g);
+
+  double fc = GetCenterFrequency (channel);
+  double halfWidth = m_channelWidth * 0.5e6;
+  size_t index = 0;
+  for (Bands::const_iterator bit = rf->ConstBandsBegin (); bit != rf->ConstBandsEnd (); ++bit, ++index)
+    {
+      if (std::fabs (bit->fc - fc) < halfWidth)
+        {
+          (*rf)[index] = 1;
+        }
+    }
+
+  return rf;
+}
+
+
 } // namespace ns3
@@ -95,6 +95,47 @@ public:
 
 
 
+/**
+ * \ingroup spectrum
+ *
+ * Implements WifiSpectrumValue for the 802.11ah (S1G) channels of the
+ * 902-928 MHz band, with a 100 kHz spectrum resolution. The channel
+ * center frequency is 902 MHz + 0.5 MHz * channel number, and the
+ * channel width (1, 2, 4, 8 or 16 MHz) is given to the constructor.
+ *
+ * All the instances share the same SpectrumModel, so that the values
+ * created for different channel widths can be combined with each other.
+ */
+class WifiSpectrumValueS1gFactory : public WifiSpectrumValueHelper
+{
+public:
+  /**
+   * \param channelWidth the channel width in MHz
+   */
+  WifiSpectrumValueS1gFactory (uint32_t channelWidth);
+  virtual ~WifiSpectrumValueS1gFactory ();
+  // inherited from WifiSpectrumValueHelper
+  virtual Ptr<SpectrumValue> CreateConstant (double psd);
+  /**
+   * The power is spread evenly over the channel width, and the power
+   * outside of it follows the S1G transmit spectrum mask, see IEEE
+   * Std. 802.11ah-2016, 24.3.17.1.
+   */
+  virtual Ptr<SpectrumValue> CreateTxPowerSpectralDensity (double txPower, uint32_t channel);
+  virtual Ptr<SpectrumValue> CreateRfFilter (uint32_t channel);
+
+private:
+  /**
+   * \param channel the number of the channel
+   * \return the center frequency of the channel in Hz
+   */
+  static double GetCenterFrequency (uint32_t channel);
+
+  uint32_t m_channelWidth; //!< the channel width in MHz
+};
+
+
+
 } // namespace ns3
 
 
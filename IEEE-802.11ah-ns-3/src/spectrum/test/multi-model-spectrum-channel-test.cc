@@ -0,0 +1,201 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/spectrum-model-ism2400MHz-res1MHz.h>
+#include <ns3/wifi-spectrum-value-helper.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/net-device.h>
+#include <ns3/antenna-model.h>
+
+using namespace ns3;
+
+/**
+ * A SpectrumPhy which only records the power of the signals it receives.
+ */
+class RecordingSpectrumPhy : public SpectrumPhy
+{
+public:
+  RecordingSpectrumPhy (Ptr<const SpectrumModel> rxSpectrumModel, Vector pos);
+
+  // inherited from SpectrumPhy
+  virtual void SetDevice (Ptr<NetDevice> d);
+  virtual Ptr<NetDevice> GetDevice () const;
+  virtual void SetMobility (Ptr<MobilityModel> m);
+  virtual Ptr<MobilityModel> GetMobility ();
+  virtual void SetChannel (Ptr<SpectrumChannel> c);
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const;
+  virtual Ptr<AntennaModel> GetRxAntenna ();
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params);
+
+  std::vector<double> m_rxPowers; //!< The power of each received signal
+
+private:
+  Ptr<const SpectrumModel> m_rxSpectrumModel;
+  Ptr<MobilityModel> m_mobility;
+};
+
+RecordingSpectrumPhy::RecordingSpectrumPhy (Ptr<const SpectrumModel> rxSpectrumModel, Vector pos)
+  : m_rxSpectrumModel (rxSpectrumModel)
+{
+  m_mobility = CreateObject<ConstantPositionMobilityModel> ();
+  m_mobility->SetPosition (pos);
+}
+
+void
+RecordingSpectrumPhy::SetDevice (Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+RecordingSpectrumPhy::GetDevice () const
+{
+  return 0;
+}
+
+void
+RecordingSpectrumPhy::SetMobility (Ptr<MobilityModel> m)
+{
+  m_mobility = m;
+}
+
+Ptr<MobilityModel>
+RecordingSpectrumPhy::GetMobility ()
+{
+  return m_mobility;
+}
+
+void
+RecordingSpectrumPhy::SetChannel (Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+RecordingSpectrumPhy::GetRxSpectrumModel () const
+{
+  return m_rxSpectrumModel;
+}
+
+Ptr<AntennaModel>
+RecordingSpectrumPhy::GetRxAntenna ()
+{
+  return 0;
+}
+
+void
+RecordingSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> params)
+{
+  m_rxPowers.push_back (Integral (*params->psd));
+}
+
+
+/**
+ * Check that a PSD changed in place between two transmissions is
+ * converted again, and that the receivers beyond MaxLossDb get nothing.
+ */
+class MultiModelSpectrumChannelTestCase : public TestCase
+{
+public:
+  MultiModelSpectrumChannelTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Transmit (Ptr<MultiModelSpectrumChannel> channel, Ptr<SpectrumPhy> txPhy, Ptr<SpectrumValue> psd);
+  void Scale (Ptr<SpectrumValue> psd, double factor);
+};
+
+MultiModelSpectrumChannelTestCase::MultiModelSpectrumChannelTestCase ()
+  : TestCase ("Convert the transmitted PSDs and cull the receivers out of range")
+{
+}
+
+void
+MultiModelSpectrumChannelTestCase::Transmit (Ptr<MultiModelSpectrumChannel> channel, Ptr<SpectrumPhy> txPhy, Ptr<SpectrumValue> psd)
+{
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->duration = MilliSeconds (1);
+  params->psd = psd;
+  params->txPhy = txPhy;
+  channel->StartTx (params);
+}
+
+void
+MultiModelSpectrumChannelTestCase::Scale (Ptr<SpectrumValue> psd, double factor)
+{
+  *psd *= factor;
+}
+
+void
+MultiModelSpectrumChannelTestCase::DoRun (void)
+{
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  channel->SetAttribute ("MaxLossDb", DoubleValue (100));
+
+  Ptr<RecordingSpectrumPhy> tx = Create<RecordingSpectrumPhy> (SpectrumModelIsm2400MhzRes1Mhz, Vector (0, 0, 0));
+  Ptr<RecordingSpectrumPhy> near = Create<RecordingSpectrumPhy> (SpectrumModelIsm2400MhzRes1Mhz, Vector (1, 0, 0));
+  Ptr<RecordingSpectrumPhy> far = Create<RecordingSpectrumPhy> (SpectrumModelIsm2400MhzRes1Mhz, Vector (1000, 0, 0));
+  channel->AddRx (tx);
+  channel->AddRx (near);
+  channel->AddRx (far);
+  NS_TEST_ASSERT_MSG_EQ (channel->GetNDevices (), 3, "Unexpected number of devices");
+  channel->AddRx (near);
+  NS_TEST_ASSERT_MSG_EQ (channel->GetNDevices (), 3, "A PHY added again was counted twice");
+
+  Ptr<MatrixPropagationLossModel> loss = CreateObject<MatrixPropagationLossModel> ();
+  loss->SetDefaultLoss (200);
+  loss->SetLoss (tx->GetMobility (), near->GetMobility (), 10);
+  channel->AddPropagationLossModel (loss);
+
+  WifiSpectrumValue5MhzFactory sf;
+  double txPowerW = 0.1;
+  Ptr<SpectrumValue> txPsd = sf.CreateTxPowerSpectralDensity (txPowerW, 1);
+  double txPower = Integral (*txPsd);
+
+  Simulator::Schedule (Seconds (1), &MultiModelSpectrumChannelTestCase::Transmit, this, channel, tx, txPsd);
+  Simulator::Schedule (Seconds (2), &MultiModelSpectrumChannelTestCase::Transmit, this, channel, tx, txPsd);
+  Simulator::Schedule (Seconds (2.5), &MultiModelSpectrumChannelTestCase::Scale, this, txPsd, 2.0);
+  Simulator::Schedule (Seconds (3), &MultiModelSpectrumChannelTestCase::Transmit, this, channel, tx, txPsd);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (tx->m_rxPowers.size (), 0, "The transmitter received its own signal");
+  NS_TEST_ASSERT_MSG_EQ (far->m_rxPowers.size (), 0, "A receiver beyond MaxLossDb received a signal");
+  NS_TEST_ASSERT_MSG_EQ (near->m_rxPowers.size (), 3, "Unexpected number of received signals");
+  NS_TEST_ASSERT_MSG_EQ_TOL (near->m_rxPowers[0], txPower * 0.1, txPower * 0.001, "Unexpected received power");
+  NS_TEST_ASSERT_MSG_EQ_TOL (near->m_rxPowers[1], near->m_rxPowers[0], txPower * 1e-9, "The same PSD was converted differently");
+  NS_TEST_ASSERT_MSG_EQ_TOL (near->m_rxPowers[2], 2 * near->m_rxPowers[0], txPower * 1e-9, "The changed PSD was not converted again");
+}
+
+
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+public:
+  MultiModelSpectrumChannelTestSuite ();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite ()
+  : TestSuite ("multi-model-spectrum-channel", UNIT)
+{
+  AddTestCase (new MultiModelSpectrumChannelTestCase, TestCase::QUICK);
+}
+
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite;
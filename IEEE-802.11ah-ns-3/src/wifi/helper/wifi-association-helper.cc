@@ -0,0 +1,57 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "wifi-association-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/sta-wifi-mac.h"
+#include "ns3/ap-wifi-mac.h"
+#include "ns3/mgt-headers.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WifiAssociationHelper");
+
+void
+WifiAssociationHelper::Associate (NetDeviceContainer staDevices, Ptr<NetDevice> apDevice) const
+{
+  NS_LOG_FUNCTION (this << staDevices.GetN () << apDevice);
+  Ptr<WifiNetDevice> ap = DynamicCast<WifiNetDevice> (apDevice);
+  NS_ASSERT_MSG (ap != 0, "The AP is not a WifiNetDevice");
+  Ptr<ApWifiMac> apMac = DynamicCast<ApWifiMac> (ap->GetMac ());
+  NS_ASSERT_MSG (apMac != 0, "The AP does not have an ApWifiMac");
+  Mac48Address bssid = Mac48Address::ConvertFrom (ap->GetAddress ());
+
+  for (NetDeviceContainer::Iterator i = staDevices.Begin (); i != staDevices.End (); ++i)
+    {
+      Ptr<WifiNetDevice> sta = DynamicCast<WifiNetDevice> (*i);
+      NS_ASSERT_MSG (sta != 0, "A station is not a WifiNetDevice");
+      Ptr<StaWifiMac> staMac = DynamicCast<StaWifiMac> (sta->GetMac ());
+      NS_ASSERT_MSG (staMac != 0, "A station does not have a StaWifiMac");
+      Mac48Address address = Mac48Address::ConvertFrom (sta->GetAddress ());
+
+      MgtAssocResponseHeader assocResp = apMac->Associate (address, staMac->GetAssocRequest ());
+      if (!assocResp.GetStatusCode ().IsSuccess ())
+        {
+          NS_LOG_WARN ("the AP refused the association of " << address);
+          continue;
+        }
+      staMac->SetAssociated (bssid, assocResp);
+    }
+}
+
+} //namespace ns3
@@ -0,0 +1,57 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_ASSOCIATION_HELPER_H
+#define WIFI_ASSOCIATION_HELPER_H
+
+#include "ns3/net-device-container.h"
+
+namespace ns3 {
+
+/**
+ * \brief Associate stations with their AP without the association frames.
+ *
+ * With thousands of stations the probe and association exchanges, made
+ * slower by the RAW restrictions and the authentication control of the
+ * AP, can take hundreds of simulated seconds before any measurement
+ * starts. When the association is not studied, this helper makes every
+ * station associated right away: the AP accepts the association request
+ * the station would send, records its AID and capabilities, and the
+ * station takes the response as if it had been received. The AID, hence
+ * the RAW group and slot of the station, is the one the frames would
+ * have given it.
+ *
+ * The Assoc trace source of the stations is fired as usual, so a
+ * scenario can start its traffic from it in both cases. Without this
+ * helper the stations still associate through the frames, which is the
+ * way to study an association storm.
+ */
+class WifiAssociationHelper
+{
+public:
+  /**
+   * Associate stations with an AP. This can be called before the
+   * simulation starts, once the devices are installed.
+   *
+   * \param staDevices the WifiNetDevices of the stations, with a StaWifiMac
+   * \param apDevice the WifiNetDevice of the AP, with an ApWifiMac
+   */
+  void Associate (NetDeviceContainer staDevices, Ptr<NetDevice> apDevice) const;
+};
+
+} //namespace ns3
+
+#endif /* WIFI_ASSOCIATION_HELPER_H */
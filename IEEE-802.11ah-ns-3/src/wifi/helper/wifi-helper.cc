@@ -40,6 +40,8 @@
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/names.h"
+#include "ns3/rng-seed-manager.h"
+#include <sstream>
 
 namespace ns3 {
 
@@ -234,4 +236,20 @@ WifiHelper::AssignStreams (NetDeviceContainer c, int64_t stream)
   return (currentStream - stream);
 }
 
+int64_t
+WifiHelper::AssignStreams (NetDeviceContainer c)
+{
+  int64_t assigned = 0;
+  for (NetDeviceContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      std::ostringstream oss;
+      oss << "/DeviceList/" << (*i)->GetIfIndex ();
+      int64_t stream = RngSeedManager::GetStreamIndex ((*i)->GetNode ()->GetId (), oss.str ());
+      int64_t n = AssignStreams (NetDeviceContainer (*i), stream);
+      NS_ASSERT (n <= RngSeedManager::GetStreamBlockSize ());
+      assigned += n;
+    }
+  return assigned;
+}
+
 } //namespace ns3
@@ -214,6 +214,18 @@ public:
   * \return the number of stream indices assigned by this helper
   */
   int64_t AssignStreams (NetDeviceContainer c, int64_t stream);
+  /**
+  * Assign fixed random variable stream numbers to the Phy and Mac of
+  * each device in container c, derived from the node and the device
+  * index with RngSeedManager::GetStreamIndex. Unlike the method above,
+  * the streams of a device do not depend on the other devices in the
+  * container nor on their order.
+  *
+  * \param c NetDeviceContainer of the set of net devices for which the
+  *          WifiNetDevice should be modified to use fixed streams
+  * \return the number of stream indices assigned by this helper
+  */
+  int64_t AssignStreams (NetDeviceContainer c);
 
 
 protected:
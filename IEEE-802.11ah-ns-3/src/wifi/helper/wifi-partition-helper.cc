@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include "wifi-partition-helper.h"
+#include "ns3/node.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WifiPartitionHelper");
+
+namespace {
+
+/**
+ * Orders AP indexes by one coordinate of their position.
+ */
+class CoordinateLess
+{
+public:
+  CoordinateLess (const std::vector<Vector> &positions, bool alongX)
+    : m_positions (positions),
+      m_alongX (alongX)
+  {
+  }
+  bool operator () (uint32_t a, uint32_t b) const
+  {
+    return m_alongX ? m_positions[a].x < m_positions[b].x
+                    : m_positions[a].y < m_positions[b].y;
+  }
+private:
+  const std::vector<Vector> &m_positions;
+  bool m_alongX;
+};
+
+} // anonymous namespace
+
+WifiPartitionHelper::WifiPartitionHelper ()
+  : m_systemCount (1)
+{
+}
+
+void
+WifiPartitionHelper::SetSystemCount (uint32_t systemCount)
+{
+  NS_ASSERT (systemCount > 0);
+  m_systemCount = systemCount;
+}
+
+void
+WifiPartitionHelper::Partition (const std::vector<Vector> &apPositions, const std::vector<Vector> &staPositions)
+{
+  NS_LOG_FUNCTION (this << apPositions.size () << staPositions.size ());
+  NS_ASSERT (!apPositions.empty ());
+  m_apPositions = apPositions;
+  m_apWeight.assign (apPositions.size (), 1);
+  m_apSystemId.assign (apPositions.size (), 0);
+  m_staAp.resize (staPositions.size ());
+
+  for (uint32_t sta = 0; sta < staPositions.size (); sta++)
+    {
+      uint32_t nearest = 0;
+      double nearestDistance = CalculateDistance (staPositions[sta], apPositions[0]);
+      for (uint32_t ap = 1; ap < apPositions.size (); ap++)
+        {
+          double distance = CalculateDistance (staPositions[sta], apPositions[ap]);
+          if (distance < nearestDistance)
+            {
+              nearest = ap;
+              nearestDistance = distance;
+            }
+        }
+      m_staAp[sta] = nearest;
+      m_apWeight[nearest]++;
+    }
+
+  std::vector<uint32_t> aps (apPositions.size ());
+  for (uint32_t ap = 0; ap < aps.size (); ap++)
+    {
+      aps[ap] = ap;
+    }
+  Bisect (aps, 0, m_systemCount);
+}
+
+void
+WifiPartitionHelper::Bisect (std::vector<uint32_t> aps, uint32_t firstSystemId, uint32_t systemCount)
+{
+  if (systemCount == 1 || aps.size () == 1)
+    {
+      for (std::vector<uint32_t>::const_iterator i = aps.begin (); i != aps.end (); ++i)
+        {
+          m_apSystemId[*i] = firstSystemId;
+          NS_LOG_DEBUG ("AP " << *i << " at " << m_apPositions[*i] << " on system " << firstSystemId);
+        }
+      return;
+    }
+
+  //cut along the longest side of the bounding box
+  Vector min = m_apPositions[aps[0]];
+  Vector max = min;
+  uint32_t weight = 0;
+  for (std::vector<uint32_t>::const_iterator i = aps.begin (); i != aps.end (); ++i)
+    {
+      min.x = std::min (min.x, m_apPositions[*i].x);
+      min.y = std::min (min.y, m_apPositions[*i].y);
+      max.x = std::max (max.x, m_apPositions[*i].x);
+      max.y = std::max (max.y, m_apPositions[*i].y);
+      weight += m_apWeight[*i];
+    }
+  std::sort (aps.begin (), aps.end (), CoordinateLess (m_apPositions, max.x - min.x >= max.y - min.y));
+
+  uint32_t lowCount = systemCount / 2;
+  double target = static_cast<double> (weight) * lowCount / systemCount;
+  uint32_t cut = 0;
+  uint32_t lowWeight = 0;
+  while (cut < aps.size () - 1 && lowWeight + m_apWeight[aps[cut]] / 2.0 < target)
+    {
+      lowWeight += m_apWeight[aps[cut]];
+      cut++;
+    }
+  cut = std::max (cut, 1u);
+
+  Bisect (std::vector<uint32_t> (aps.begin (), aps.begin () + cut), firstSystemId, lowCount);
+  Bisect (std::vector<uint32_t> (aps.begin () + cut, aps.end ()), firstSystemId + lowCount, systemCount - lowCount);
+}
+
+uint32_t
+WifiPartitionHelper::GetApSystemId (uint32_t ap) const
+{
+  NS_ASSERT (ap < m_apSystemId.size ());
+  return m_apSystemId[ap];
+}
+
+uint32_t
+WifiPartitionHelper::GetStaSystemId (uint32_t sta) const
+{
+  return m_apSystemId[GetStaAp (sta)];
+}
+
+uint32_t
+WifiPartitionHelper::GetStaAp (uint32_t sta) const
+{
+  NS_ASSERT (sta < m_staAp.size ());
+  return m_staAp[sta];
+}
+
+NodeContainer
+WifiPartitionHelper::CreateApNodes (void) const
+{
+  NodeContainer nodes;
+  for (uint32_t ap = 0; ap < m_apSystemId.size (); ap++)
+    {
+      nodes.Add (CreateObject<Node> (GetApSystemId (ap)));
+    }
+  return nodes;
+}
+
+NodeContainer
+WifiPartitionHelper::CreateStaNodes (void) const
+{
+  NodeContainer nodes;
+  for (uint32_t sta = 0; sta < m_staAp.size (); sta++)
+    {
+      nodes.Add (CreateObject<Node> (GetStaSystemId (sta)));
+    }
+  return nodes;
+}
+
+} //namespace ns3
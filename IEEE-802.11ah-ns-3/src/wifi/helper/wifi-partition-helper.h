@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_PARTITION_HELPER_H
+#define WIFI_PARTITION_HELPER_H
+
+#include <vector>
+#include "ns3/vector.h"
+#include "ns3/node-container.h"
+
+namespace ns3 {
+
+/**
+ * \brief Split a multi-BSS topology over several MPI tasks by geography.
+ *
+ * Every station is attached to its nearest AP, and a BSS (the AP with its
+ * stations) is never split. The APs are distributed by recursive
+ * coordinate bisection: the set of APs is cut along the longest side of
+ * its bounding box so that both halves carry a share of the stations
+ * proportional to the number of tasks they receive. Neighbouring BSSs
+ * thus end up on the same task, which keeps most of the traffic of a
+ * YansWifiRemoteChannel local and the lookahead between tasks large.
+ *
+ * The system id of a node can only be set when it is created, so the
+ * partition has to be computed from the planned positions before the
+ * nodes are created with CreateApNodes and CreateStaNodes.
+ */
+class WifiPartitionHelper
+{
+public:
+  WifiPartitionHelper ();
+
+  /**
+   * \param systemCount number of MPI tasks to spread the BSSs on
+   */
+  void SetSystemCount (uint32_t systemCount);
+
+  /**
+   * Compute the partition.
+   *
+   * \param apPositions the position of every AP
+   * \param staPositions the position of every station
+   */
+  void Partition (const std::vector<Vector> &apPositions, const std::vector<Vector> &staPositions);
+
+  /**
+   * \param ap index of an AP in the positions given to Partition
+   * \return the system id of the AP
+   */
+  uint32_t GetApSystemId (uint32_t ap) const;
+  /**
+   * \param sta index of a station in the positions given to Partition
+   * \return the system id of the station
+   */
+  uint32_t GetStaSystemId (uint32_t sta) const;
+  /**
+   * \param sta index of a station in the positions given to Partition
+   * \return the index of the AP the station is attached to
+   */
+  uint32_t GetStaAp (uint32_t sta) const;
+
+  /**
+   * \return one node per AP, created on the system id of the AP
+   */
+  NodeContainer CreateApNodes (void) const;
+  /**
+   * \return one node per station, created on the system id of the station
+   */
+  NodeContainer CreateStaNodes (void) const;
+
+
+private:
+  /**
+   * Assign a set of APs to a range of system ids.
+   *
+   * \param aps the indexes of the APs
+   * \param firstSystemId the first system id of the range
+   * \param systemCount the number of system ids in the range
+   */
+  void Bisect (std::vector<uint32_t> aps, uint32_t firstSystemId, uint32_t systemCount);
+
+  uint32_t m_systemCount;             //!< number of MPI tasks
+  std::vector<Vector> m_apPositions;  //!< position of every AP
+  std::vector<uint32_t> m_apWeight;   //!< number of nodes in each BSS
+  std::vector<uint32_t> m_apSystemId; //!< system id of every AP
+  std::vector<uint32_t> m_staAp;      //!< AP of every station
+};
+
+} //namespace ns3
+
+#endif /* WIFI_PARTITION_HELPER_H */
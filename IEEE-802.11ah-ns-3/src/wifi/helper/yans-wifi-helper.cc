@@ -24,6 +24,7 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-remote-channel.h"
 #include "ns3/yans-wifi-phy.h"
 #include "ns3/wifi-net-device.h"
 #include "ns3/radiotap-header.h"
@@ -153,6 +154,21 @@ Ptr<YansWifiChannel>
 YansWifiChannelHelper::Create (void) const
 {
   Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  Configure (channel);
+  return channel;
+}
+
+Ptr<YansWifiRemoteChannel>
+YansWifiChannelHelper::CreateRemote (void) const
+{
+  Ptr<YansWifiRemoteChannel> channel = CreateObject<YansWifiRemoteChannel> ();
+  Configure (channel);
+  return channel;
+}
+
+void
+YansWifiChannelHelper::Configure (Ptr<YansWifiChannel> channel) const
+{
   Ptr<PropagationLossModel> prev = 0;
   for (std::vector<ObjectFactory>::const_iterator i = m_propagationLoss.begin (); i != m_propagationLoss.end (); ++i)
     {
@@ -169,7 +185,6 @@ YansWifiChannelHelper::Create (void) const
     }
   Ptr<PropagationDelayModel> delay = m_propagationDelay.Create<PropagationDelayModel> ();
   channel->SetPropagationDelayModel (delay);
-  return channel;
 }
 
 int64_t
@@ -270,7 +285,6 @@ PcapSniffTxEvent (
       }
     case PcapHelper::DLT_IEEE802_11_RADIO:
       {
-        Ptr<Packet> p = packet->Copy ();
         RadiotapHeader header;
         uint8_t frameFlags = RadiotapHeader::FRAME_FLAG_NONE;
         header.SetTsft (Simulator::Now ().GetMicroSeconds ());
@@ -317,8 +331,8 @@ PcapSniffTxEvent (
 
         header.SetChannelFrequencyAndFlags (channelFreqMhz, channelFlags);
 
-        p->AddHeader (header);
-        file->Write (Simulator::Now (), p);
+        //the header is serialized in front of the packet in the file
+        file->Write (Simulator::Now (), header, packet);
         return;
       }
     default:
@@ -352,7 +366,6 @@ PcapSniffRxEvent (
       }
     case PcapHelper::DLT_IEEE802_11_RADIO:
       {
-        Ptr<Packet> p = packet->Copy ();
         RadiotapHeader header;
         uint8_t frameFlags = RadiotapHeader::FRAME_FLAG_NONE;
         header.SetTsft (Simulator::Now ().GetMicroSeconds ());
@@ -402,8 +415,8 @@ PcapSniffRxEvent (
         header.SetAntennaSignalPower (signalDbm);
         header.SetAntennaNoisePower (noiseDbm);
 
-        p->AddHeader (header);
-        file->Write (Simulator::Now (), p);
+        //the header is serialized in front of the packet in the file
+        file->Write (Simulator::Now (), header, packet);
         return;
       }
     default:
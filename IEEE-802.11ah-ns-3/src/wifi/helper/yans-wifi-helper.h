@@ -24,6 +24,7 @@
 #include "wifi-helper.h"
 #include "ns3/trace-helper.h"
 #include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-remote-channel.h"
 
 namespace ns3 {
 
@@ -126,6 +127,13 @@ public:
    */
   Ptr<YansWifiChannel> Create (void) const;
 
+  /**
+   * \returns a new channel whose PHYs may be distributed over several MPI tasks
+   *
+   * Same as Create, but the channel is a YansWifiRemoteChannel.
+   */
+  Ptr<YansWifiRemoteChannel> CreateRemote (void) const;
+
   /**
   * Assign a fixed random variable stream number to the random variables
   * used by the channel.  Typically this corresponds to random variables
@@ -142,6 +150,13 @@ public:
 
 
 private:
+  /**
+   * Install the configured propagation models on a channel.
+   *
+   * \param channel the channel to configure
+   */
+  void Configure (Ptr<YansWifiChannel> channel) const;
+
   std::vector<ObjectFactory> m_propagationLoss;
   ObjectFactory m_propagationDelay;
 };
@@ -202,6 +202,9 @@ ApWifiMac::DoDispose ()
   m_beaconDca = 0;
   m_enableBeaconGeneration = false;
   m_beaconEvent.Cancel ();
+  //Simulator::Destroy disposes the MAC through the node list, so the
+  //files of the RAW controller are complete once it returns
+  m_S1gRawCtr.FlushLog ();
   RegularWifiMac::DoDispose ();
 }
 
@@ -584,42 +587,10 @@ ApWifiMac::GetSlotStartTimeFromAid (uint16_t aid) const
 	}
 
 	//std::cout << "aid=" << (int)aid << ", toTim=" << (int)toTim << std::endl;
-	uint16_t raw_len = (*m_rpsset.rpsset.at(toTim)).GetInformationFieldSize();
-
-	uint16_t rawAssignment_len = 6;
-	if (raw_len % rawAssignment_len !=0)
-	{
-		NS_ASSERT ("RAW configuration incorrect!");
-	}
-	uint8_t RAW_number = raw_len/rawAssignment_len;
-
-    uint16_t slotDurationCount=0;
-    uint16_t slotNum=0;
-    uint64_t currentRAW_start=0;
-    Time lastRawDurationus = MicroSeconds(0);
-    int x = 0;
-	for (uint8_t raw_index=0; raw_index < RAW_number; raw_index++)
-	{
-		RPS::RawAssignment ass = m_rpsset.rpsset.at(toTim)->GetRawAssigmentObj(raw_index);
-		currentRAW_start += (500 + slotDurationCount * 120) * slotNum;
-		slotDurationCount = ass.GetSlotDurationCount();
-		slotNum = ass.GetSlotNum();
-		Time slotDuration = MicroSeconds(500 + slotDurationCount * 120);
-		lastRawDurationus += slotDuration * slotNum;
-		if (ass.GetRawGroupAIDStart() <= aid && aid <= ass.GetRawGroupAIDEnd()) {
-			uint16_t statRawSlot = (aid & 0x03ff) % slotNum;
-			Time start = MicroSeconds((500 + slotDurationCount * 120) * statRawSlot + currentRAW_start);
-			NS_LOG_DEBUG ("[aid=" << aid << "] is located in RAW " << (int)raw_index + 1 << " in slot " << statRawSlot + 1 << ". RAW slot start time relative to the beacon = " << start.GetMicroSeconds() << " us.");
-			x = 1;
-			return start;
-		}
-	}
-	// AIDs that are not assigned to any RAW group can sleep through all the RAW groups
-	// For station that does not belong to anz RAW group, return the time after all RAW groups
-	/*currentRAW_start += (500 + slotDurationCount * 120) * slotNum;
-	NS_LOG_DEBUG ("[aid=" << aid << "] is located outside all RAWs. It can start contending " << currentRAW_start << " us after the beacon.");*/
-	NS_ASSERT (x);
-	return MicroSeconds (currentRAW_start);
+	Ptr<const RawSchedule> schedule = m_rawSchedules.Get (*m_rpsset.rpsset.at(toTim));
+	Time start = schedule->GetSlotStart (aid);
+	NS_LOG_DEBUG ("[aid=" << aid << "] is located in RAW " << schedule->GetRawIndex (aid) + 1 << ". RAW slot start time relative to the beacon = " << start.GetMicroSeconds() << " us.");
+	return start;
 }
 
 void
@@ -760,9 +731,26 @@ ApWifiMac::SendAssocResp (Mac48Address to, bool success, uint8_t staType)
   hdr.SetAddr3 (GetAddress ());
   hdr.SetDsNotFrom ();
   hdr.SetDsNotTo ();
+  if (m_htSupported)
+    {
+      hdr.SetNoOrder ();
+    }
   Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (CreateAssocResp (to, success, staType));
+
+  //The standard is not clear on the correct queue for management
+  //frames if we are a QoS AP. The approach taken here is to always
+  //use the DCF for these regardless of whether we have a QoS
+  //association or not.
+  m_dca->Queue (packet, hdr);
+}
+
+MgtAssocResponseHeader
+ApWifiMac::CreateAssocResp (Mac48Address to, bool success, uint8_t staType)
+{
+  NS_LOG_FUNCTION (this << to << success);
   MgtAssocResponseHeader assoc;
-  
+
   uint8_t mac[6];
   to.CopyTo (mac);
   uint8_t aid_l = mac[5];
@@ -786,11 +774,8 @@ ApWifiMac::SendAssocResp (Mac48Address to, bool success, uint8_t staType)
   if (m_htSupported)
     {
       assoc.SetHtCapabilities (GetHtCapabilities ());
-      hdr.SetNoOrder ();
     }
-    //NS_LOG_UNCOND ("ApWifiMac::SendAssocResp =" );
 
-   
   if (m_s1gSupported && success)
     {
       assoc.SetS1gCapabilities (GetS1gCapabilities ());
@@ -800,7 +785,7 @@ ApWifiMac::SendAssocResp (Mac48Address to, bool success, uint8_t staType)
           for (std::vector<uint16_t>::iterator it = m_sensorList.begin(); it != m_sensorList.end(); it++)
             {
               if (*it == aid)
-                 goto Addheader;
+                 return assoc;
             }
           m_sensorList.push_back (aid);
           NS_LOG_INFO ("m_sensorList =" << m_sensorList.size ());
@@ -811,20 +796,13 @@ ApWifiMac::SendAssocResp (Mac48Address to, bool success, uint8_t staType)
            for (std::vector<uint16_t>::iterator it = m_OffloadList.begin(); it != m_OffloadList.end(); it++)
             {
                 if (*it == aid)
-                  goto Addheader;
+                  return assoc;
             }
           m_OffloadList.push_back (aid);
           NS_LOG_INFO ("m_OffloadList =" << m_OffloadList.size ());
         }
     }
-Addheader:
-  packet->AddHeader (assoc);
-
-  //The standard is not clear on the correct queue for management
-  //frames if we are a QoS AP. The approach taken here is to always
-  //use the DCF for these regardless of whether we have a QoS
-  //association or not.
-  m_dca->Queue (packet, hdr);
+  return assoc;
 }
 
 //For now, to avoid adjust pageslicecount and pageslicecount dynamicly,   page bitmap is always 4 bytes
@@ -1361,6 +1339,88 @@ ApWifiMac::TxFailed (const WifiMacHeader &hdr)
     }
 }
 
+bool
+ApWifiMac::AcceptAssocRequest (Mac48Address from, const MgtAssocRequestHeader &assocReq, uint8_t &staType)
+{
+  NS_LOG_FUNCTION (this << from);
+  staType = 0;
+  //first, verify that the the station's supported
+  //rate set is compatible with our Basic Rate set
+  SupportedRates rates = assocReq.GetSupportedRates ();
+  for (uint32_t i = 0; i < m_stationManager->GetNBasicModes (); i++)
+    {
+      WifiMode mode = m_stationManager->GetBasicMode (i);
+      if (!rates.IsSupportedRate (mode.GetDataRate ()))
+        {
+          return false;
+        }
+    }
+  if (m_htSupported)
+    {
+      //check that the STA supports all MCSs in Basic MCS Set
+      HtCapabilities htcapabilities = assocReq.GetHtCapabilities ();
+      for (uint32_t i = 0; i < m_stationManager->GetNBasicMcs (); i++)
+        {
+          uint8_t mcs = m_stationManager->GetBasicMcs (i);
+          if (!htcapabilities.IsSupportedMcs (mcs))
+            {
+              return false;
+            }
+        }
+    }
+
+  //station supports all rates in Basic Rate Set.
+  //record all its supported modes in its associated WifiRemoteStation
+  for (uint32_t j = 0; j < m_phy->GetNModes (); j++)
+    {
+      WifiMode mode = m_phy->GetMode (j);
+      if (rates.IsSupportedRate (mode.GetDataRate ()))
+        {
+          m_stationManager->AddSupportedMode (from, mode);
+        }
+    }
+  if (m_htSupported)
+    {
+      HtCapabilities htcapabilities = assocReq.GetHtCapabilities ();
+      m_stationManager->AddStationHtCapabilities (from, htcapabilities);
+      for (uint32_t j = 0; j < m_phy->GetNMcs (); j++)
+        {
+          uint8_t mcs = m_phy->GetMcs (j);
+          if (htcapabilities.IsSupportedMcs (mcs))
+            {
+              m_stationManager->AddSupportedMcs (from, mcs);
+            }
+        }
+    }
+
+  m_stationManager->RecordWaitAssocTxOk (from);
+
+  if (m_s1gSupported)
+    {
+      S1gCapabilities s1gcapabilities = assocReq.GetS1gCapabilities ();
+      m_stationManager->AddStationS1gCapabilities (from, s1gcapabilities);
+      staType = s1gcapabilities.GetStaType ();
+      m_supportPageSlicingList[from] = s1gcapabilities.GetPageSlicingSupport () != 0;
+    }
+  return true;
+}
+
+MgtAssocResponseHeader
+ApWifiMac::Associate (Mac48Address from, const MgtAssocRequestHeader &assocReq)
+{
+  NS_LOG_FUNCTION (this << from);
+  uint8_t staType;
+  bool success = AcceptAssocRequest (from, assocReq, staType);
+  MgtAssocResponseHeader assocResp = CreateAssocResp (from, success, staType);
+  if (success)
+    {
+      //there is no response frame whose transmission would complete
+      //the association
+      m_stationManager->RecordGotAssocTxOk (from);
+    }
+  return assocResp;
+}
+
 void
 ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
 {
@@ -1461,93 +1521,11 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
                 {
                   return;  //test, avoid repeate assoc
                  }
-               //NS_LOG_LOGIC ("Received AssocReq "); // for test
-              //first, verify that the the station's supported
-              //rate set is compatible with our Basic Rate set
               MgtAssocRequestHeader assocReq;
-
               packet->RemoveHeader (assocReq);
-
-              SupportedRates rates = assocReq.GetSupportedRates ();
-              bool problem = false;
-              for (uint32_t i = 0; i < m_stationManager->GetNBasicModes (); i++)
-                {
-                  WifiMode mode = m_stationManager->GetBasicMode (i);
-                  if (!rates.IsSupportedRate (mode.GetDataRate ()))
-                    {
-                      problem = true;
-                      break;
-                    }
-                }
-
-              if (m_htSupported)
-                {
-                  //check that the STA supports all MCSs in Basic MCS Set
-                  HtCapabilities htcapabilities = assocReq.GetHtCapabilities ();
-                  for (uint32_t i = 0; i < m_stationManager->GetNBasicMcs (); i++)
-                    {
-                      uint8_t mcs = m_stationManager->GetBasicMcs (i);
-                      if (!htcapabilities.IsSupportedMcs (mcs))
-                        {
-                          problem = true;
-                          break;
-                        }
-                    }
-
-                }
-
-                
-              if (problem)
-                {
-                  //One of the Basic Rate set mode is not
-                  //supported by the station. So, we return an assoc
-                  //response with an error status.
-                  SendAssocResp (hdr->GetAddr2 (), false, 0);
-                }
-              else
-                {
-                  //station supports all rates in Basic Rate Set.
-                  //record all its supported modes in its associated WifiRemoteStation
-                  for (uint32_t j = 0; j < m_phy->GetNModes (); j++)
-                    {
-                      WifiMode mode = m_phy->GetMode (j);
-                      if (rates.IsSupportedRate (mode.GetDataRate ()))
-                        {
-                          m_stationManager->AddSupportedMode (from, mode);
-                        }
-                    }
-                  if (m_htSupported)
-                    {
-                      HtCapabilities htcapabilities = assocReq.GetHtCapabilities ();
-                      m_stationManager->AddStationHtCapabilities (from,htcapabilities);
-                      for (uint32_t j = 0; j < m_phy->GetNMcs (); j++)
-                        {
-                          uint8_t mcs = m_phy->GetMcs (j);
-                          if (htcapabilities.IsSupportedMcs (mcs))
-                            {
-                              m_stationManager->AddSupportedMcs (from, mcs);
-                            }
-                        }
-                    }
-                    
-                  m_stationManager->RecordWaitAssocTxOk (from);
-                  
-                  if (m_s1gSupported)
-                    {
-                      S1gCapabilities s1gcapabilities = assocReq.GetS1gCapabilities ();
-                      m_stationManager->AddStationS1gCapabilities (from,s1gcapabilities);
-                      uint8_t sta_type = s1gcapabilities.GetStaType ();
-                      bool pageSlicingSupported = s1gcapabilities.GetPageSlicingSupport() != 0;
-                      m_supportPageSlicingList[hdr->GetAddr2 ()] = pageSlicingSupported;
-                      SendAssocResp (hdr->GetAddr2 (), true, sta_type);
-                    }
-                  else
-                    {
-                      //send assoc response with success status.
-                      SendAssocResp (hdr->GetAddr2 (), true, 0);
-                    }
-
-                }
+              uint8_t staType;
+              bool success = AcceptAssocRequest (from, assocReq, staType);
+              SendAssocResp (from, success, staType);
               return;
             }
           else if (hdr->IsDisassociation ())
@@ -33,6 +33,7 @@
 #include "tim.h"
 #include "pageSlice.h"
 #include "s1g-raw-control.h"
+#include "raw-schedule.h"
 #include "ns3/string.h"
 #include "extension-headers.h"
 #include "ns3/traced-value.h"
@@ -41,6 +42,9 @@
 
 namespace ns3 {
 
+class MgtAssocRequestHeader;
+class MgtAssocResponseHeader;
+
 /**
  * \brief Wi-Fi AP state machine
  * \ingroup wifi
@@ -142,6 +146,18 @@ public:
   uint8_t HasPacketsToBlock (uint16_t blockInd , uint16_t PageInd);
   uint32_t HasPacketsToPage (uint8_t blockstart , uint8_t Page);
 
+  /**
+   * Accept the association request of a station without exchanging the
+   * association frames, as if the response had been sent and
+   * acknowledged. This is used to bootstrap large scenarios where the
+   * association itself is not studied.
+   *
+   * \param from the address of the station
+   * \param assocReq the request of the station, see StaWifiMac::GetAssocRequest
+   * \return the association response, to be given to StaWifiMac::SetAssociated
+   */
+  MgtAssocResponseHeader Associate (Mac48Address from, const MgtAssocRequestHeader &assocReq);
+
 
 
 
@@ -213,6 +229,25 @@ private:
    * \param success indicates whether the association was successful or not
    */
   void SendAssocResp (Mac48Address to, bool success, uint8_t staType);
+  /**
+   * Build an association response and record the AID of the STA.
+   *
+   * \param to the address of the STA we are sending an association response to
+   * \param success indicates whether the association was successful or not
+   * \param staType the S1G station type of the STA
+   * \return the association response
+   */
+  MgtAssocResponseHeader CreateAssocResp (Mac48Address to, bool success, uint8_t staType);
+  /**
+   * Check that a STA supports our basic rates, and record its capabilities
+   * in the station manager if it does.
+   *
+   * \param from the address of the STA
+   * \param assocReq the association request of the STA
+   * \param staType set to the S1G station type of the STA
+   * \return whether the association is accepted
+   */
+  bool AcceptAssocRequest (Mac48Address from, const MgtAssocRequestHeader &assocReq, uint8_t &staType);
   /**
    * Forward a beacon packet to the beacon special DCF.
    */
@@ -312,6 +347,7 @@ private:
   std::map<Mac48Address, bool> m_supportPageSlicingList;
 
   S1gRawCtr m_S1gRawCtr;
+  mutable RawScheduleCache m_rawSchedules;   //!< the schedules of the RPS elements of the beacons
   Ptr<DcaTxop> m_beaconDca;                  //!< Dedicated DcaTxop for beacons
   Time m_beaconInterval;                     //!< Interval between beacons
   bool m_enableBeaconGeneration;             //!< Flag if beacons are being generated
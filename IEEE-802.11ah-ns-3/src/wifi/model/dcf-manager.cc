@@ -574,12 +574,13 @@ void
 DcfManager::DoGrantAccess (void)
 {
   NS_LOG_FUNCTION (this);
+  Time accessGrantStart = GetAccessGrantStart ();
   uint32_t k = 0;
   for (States::const_iterator i = m_states.begin (); i != m_states.end (); k++)
     {
       DcfState *state = *i;
       if (state->IsAccessRequested ()
-          && GetBackoffEndFor (state) <= Simulator::Now () )
+          && GetBackoffEndFor (state, accessGrantStart) <= Simulator::Now () )
         {
           /**
            * This is the first dcf we find with an expired backoff and which
@@ -593,7 +594,7 @@ DcfManager::DoGrantAccess (void)
             {
               DcfState *otherState = *j;
               if (otherState->IsAccessRequested ()
-                  && GetBackoffEndFor (otherState) <= Simulator::Now ())
+                  && GetBackoffEndFor (otherState, accessGrantStart) <= Simulator::Now ())
                 {
                   MY_DEBUG ("dcf " << k << " needs access. backoff expired. internal collision. slots=" <<
                             otherState->GetBackoffSlots ());
@@ -680,33 +681,35 @@ DcfManager::GetAccessGrantStart (void) const
 }
 
 Time
-DcfManager::GetBackoffStartFor (DcfState *state)
+DcfManager::GetBackoffStartFor (DcfState *state, Time accessGrantStart) const
 {
-  NS_LOG_FUNCTION (this << state);
+  NS_LOG_FUNCTION (this << state << accessGrantStart);
   Time mostRecentEvent = MostRecent (state->GetBackoffStart (),
-                                     GetAccessGrantStart () + MicroSeconds (state->GetAifsn () * m_slotTimeUs));
+                                     accessGrantStart + MicroSeconds (state->GetAifsn () * m_slotTimeUs));
 
   return mostRecentEvent;
 }
 
 Time
-DcfManager::GetBackoffEndFor (DcfState *state)
+DcfManager::GetBackoffEndFor (DcfState *state, Time accessGrantStart) const
 {
   //return GetBackoffStartFor (state) + MicroSeconds (state->GetBackoffSlots () * m_slotTimeUs);
 	//std::cout << "Calculating backoff end, start is " << GetBackoffStartFor (state).GetMicroSeconds() << ", duration of backoff is (slots: " << state->GetBackoffSlots() << ", slot duration: " << m_slotTimeUs << "), total duration: " << state->GetBackoffSlots () * m_slotTimeUs << std::endl;
-    Time backOffEnd = GetBackoffStartFor (state) + MicroSeconds (state->GetBackoffSlots () * m_slotTimeUs);
+    Time backOffStart = GetBackoffStartFor (state, accessGrantStart);
+    Time backOffEnd = backOffStart + MicroSeconds (state->GetBackoffSlots () * m_slotTimeUs);
+    Time rawSlotEnd = m_rawSlotStart + m_rawSlotDuration;
 
-	if(m_rawSlotStart + m_rawSlotDuration == Time(0)) // if not set
+	if(rawSlotEnd.IsZero ()) // if not set
 		return backOffEnd;
 
 	// don't schedule the backoff end beyond the raw slot period
-	if(backOffEnd > m_rawSlotStart + m_rawSlotDuration) {
+	if(backOffEnd > rawSlotEnd) {
 
 		//std::cout << "Backoff end was calculated beyond the slot duration, adjusting backoff end (backoffend: " << backOffEnd.GetMicroSeconds()
 		//		<< ", " << "Raw slot end: " << (m_rawSlotStart + m_rawSlotDuration).GetMicroSeconds() << ")" <<  std::endl;
-		Time adjusted = backOffEnd - (m_rawSlotStart + m_rawSlotDuration);
+		Time adjusted = backOffEnd - rawSlotEnd;
 
-		if(adjusted <= GetBackoffStartFor (state)) {
+		if(adjusted <= backOffStart) {
 			// eh can't adjust it, the start of the backoff is already later
 			// nothing to be done now, let it drop
 			//std::cout << "Unable to adjust the backoff end to prevent going out of the RAW period, the start is already later than the raw slot end" << std::endl;;
@@ -725,12 +728,13 @@ void
 DcfManager::UpdateBackoff (void)
 {
   NS_LOG_FUNCTION (this);
+  Time accessGrantStart = GetAccessGrantStart ();
   uint32_t k = 0;
   for (States::const_iterator i = m_states.begin (); i != m_states.end (); i++, k++)
     {
       DcfState *state = *i;
 
-      Time backoffStart = GetBackoffStartFor (state);
+      Time backoffStart = GetBackoffStartFor (state, accessGrantStart);
       if (backoffStart <= Simulator::Now ())
         {
           uint32_t nus = (Simulator::Now () - backoffStart).GetMicroSeconds ();
@@ -753,12 +757,19 @@ DcfManager::DoRestartAccessTimeoutIfNeeded (void)
    */
   bool accessTimeoutNeeded = false;
   Time expectedBackoffEnd = Simulator::GetMaximumSimulationTime ();
+  Time accessGrantStart;
+  bool accessGrantStartKnown = false;
   for (States::const_iterator i = m_states.begin (); i != m_states.end (); i++)
     {
       DcfState *state = *i;
       if (state->IsAccessRequested ())
         {
-          Time tmp = GetBackoffEndFor (state);
+          if (!accessGrantStartKnown)
+            {
+              accessGrantStart = GetAccessGrantStart ();
+              accessGrantStartKnown = true;
+            }
+          Time tmp = GetBackoffEndFor (state, accessGrantStart);
           if (tmp > Simulator::Now ())
             {
               accessTimeoutNeeded = true;
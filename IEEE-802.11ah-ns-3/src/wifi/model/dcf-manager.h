@@ -499,19 +499,22 @@ private:
    * started for the given DcfState.
    *
    * \param state
+   * \param accessGrantStart the value of GetAccessGrantStart, which is
+   *        the same for all the states and computed once by the caller
    *
    * \return the time when the backoff procedure started
    */
-  Time GetBackoffStartFor (DcfState *state);
+  Time GetBackoffStartFor (DcfState *state, Time accessGrantStart) const;
   /**
    * Return the time when the backoff procedure
    * ended (or will ended) for the given DcfState.
    *
    * \param state
+   * \param accessGrantStart the value of GetAccessGrantStart
    *
    * \return the time when the backoff procedure ended (or will ended)
    */
-  Time GetBackoffEndFor (DcfState *state);
+  Time GetBackoffEndFor (DcfState *state, Time accessGrantStart) const;
 
   void DoRestartAccessTimeoutIfNeeded (void);
 
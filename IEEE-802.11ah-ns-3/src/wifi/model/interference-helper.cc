@@ -36,11 +36,11 @@ NS_LOG_COMPONENT_DEFINE ("InterferenceHelper");
 
 InterferenceHelper::Event::Event (uint32_t size, WifiTxVector txVector,
                                   enum WifiPreamble preamble,
-                                  Time duration, double rxPower)
+                                  Time duration, double rxPower, Time startTime)
   : m_size (size),
     m_txVector (txVector),
     m_preamble (preamble),
-    m_startTime (Simulator::Now ()),
+    m_startTime (startTime),
     m_endTime (m_startTime + duration),
     m_rxPowerW (rxPower)
 {
@@ -151,13 +151,23 @@ InterferenceHelper::Add (uint32_t size, WifiTxVector txVector,
                          enum WifiPreamble preamble,
                          Time duration, double rxPowerW)
 {
+  return Add (size, txVector, preamble, duration, rxPowerW, Simulator::Now ());
+}
+
+Ptr<InterferenceHelper::Event>
+InterferenceHelper::Add (uint32_t size, WifiTxVector txVector,
+                         enum WifiPreamble preamble,
+                         Time duration, double rxPowerW, Time startTime)
+{
+  NS_ASSERT (startTime <= Simulator::Now ());
   Ptr<InterferenceHelper::Event> event;
 
   event = Create<InterferenceHelper::Event> (size,
                                              txVector,
                                              preamble,
                                              duration,
-                                             rxPowerW);
+                                             rxPowerW,
+                                             startTime);
   AppendEvent (event);
   return event;
 }
@@ -213,15 +223,14 @@ InterferenceHelper::GetEnergyDuration (double energyW)
 void
 InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
 {
-  Time now = Simulator::Now ();
   if (!m_rxing)
     {
-      NiChanges::iterator nowIterator = GetPosition (now);
-      for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
+      NiChanges::iterator startIterator = GetPosition (event->GetStartTime ());
+      for (NiChanges::iterator i = m_niChanges.begin (); i != startIterator; i++)
         {
           m_firstPower += i->GetDelta ();
         }
-      m_niChanges.erase (m_niChanges.begin (), nowIterator);
+      m_niChanges.erase (m_niChanges.begin (), startIterator);
       m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW ()));
     }
   else
@@ -56,11 +56,11 @@ public:
      * \param preamble preamble type
      * \param duration duration of the signal
      * \param rxPower the receive power (w)
-     * \param txvector TXVECTOR of the packet
+     * \param startTime the arrival time of the first bit of the signal
      */
     Event (uint32_t size, WifiTxVector txvector,
            enum WifiPreamble preamble,
-           Time duration, double rxPower);
+           Time duration, double rxPower, Time startTime);
     ~Event ();
 
     /**
@@ -183,6 +183,23 @@ private:
   Ptr<InterferenceHelper::Event> Add (uint32_t size, WifiTxVector txvector,
                                       enum WifiPreamble preamble,
                                       Time duration, double rxPower);
+  /**
+   * Add the packet-related signal to interference helper, for a signal
+   * whose first bit arrived before now, e.g. one only detected once part
+   * of its preamble was received.
+   *
+   * \param size packet size
+   * \param txvector TXVECTOR of the packet
+   * \param preamble Wi-Fi preamble for the packet
+   * \param duration the duration of the signal
+   * \param rxPower receive power (W)
+   * \param startTime the arrival time of the first bit of the signal
+   *
+   * \return InterferenceHelper::Event
+   */
+  Ptr<InterferenceHelper::Event> Add (uint32_t size, WifiTxVector txvector,
+                                      enum WifiPreamble preamble,
+                                      Time duration, double rxPower, Time startTime);
 
   /**
    * Calculate the SNIR at the start of the plcp payload and accumulate
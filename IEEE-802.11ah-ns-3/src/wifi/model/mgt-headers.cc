@@ -604,13 +604,13 @@ MgtAssocResponseHeader::~MgtAssocResponseHeader ()
 }
 
 StatusCode
-MgtAssocResponseHeader::GetStatusCode (void)
+MgtAssocResponseHeader::GetStatusCode (void) const
 {
   return m_code;
 }
 
 SupportedRates
-MgtAssocResponseHeader::GetSupportedRates (void)
+MgtAssocResponseHeader::GetSupportedRates (void) const
 {
   return m_rates;
 }
@@ -221,13 +221,13 @@ public:
    *
    * \return the status code
    */
-  StatusCode GetStatusCode (void);
+  StatusCode GetStatusCode (void) const;
   /**
    * Return the supported rates.
    *
    * \return the supported rates
    */
-  SupportedRates GetSupportedRates (void);
+  SupportedRates GetSupportedRates (void) const;
   /**
    * Return the HT capabilities.
    *
@@ -154,22 +154,18 @@ MinstrelWifiManager::AssignStreams (int64_t stream)
 Time
 MinstrelWifiManager::GetCalcTxTime (WifiMode mode) const
 {
-
-  for (TxTime::const_iterator i = m_calcTxTime.begin (); i != m_calcTxTime.end (); i++)
-    {
-      if (mode == i->second)
-        {
-          return i->first;
-        }
-    }
-  NS_ASSERT (false);
-  return Seconds (0);
+  NS_ASSERT (mode.GetUid () < m_calcTxTime.size ());
+  return m_calcTxTime[mode.GetUid ()];
 }
 
 void
 MinstrelWifiManager::AddCalcTxTime (WifiMode mode, Time t)
 {
-  m_calcTxTime.push_back (std::make_pair (t, mode));
+  if (mode.GetUid () >= m_calcTxTime.size ())
+    {
+      m_calcTxTime.resize (mode.GetUid () + 1);
+    }
+  m_calcTxTime[mode.GetUid ()] = t;
 }
 
 WifiRemoteStation *
@@ -208,7 +204,7 @@ MinstrelWifiManager::CheckInit (MinstrelWifiRemoteStation *station)
       //before we perform our own initialization.
       m_nsupported = GetNSupported (station);
       station->m_minstrelTable = MinstrelRate (m_nsupported);
-      station->m_sampleTable = SampleRate (m_nsupported, std::vector<uint32_t> (m_sampleCol));
+      station->m_sampleTable = SampleRate (m_nsupported * m_sampleCol);
       InitSampleTable (station);
       RateInit (station);
       station->m_initialized = true;
@@ -545,7 +541,7 @@ uint32_t
 MinstrelWifiManager::GetNextSample (MinstrelWifiRemoteStation *station)
 {
   uint32_t bitrate;
-  bitrate = station->m_sampleTable[station->m_index][station->m_col];
+  bitrate = station->m_sampleTable[station->m_index * m_sampleCol + station->m_col];
   station->m_index++;
 
   //bookeeping for m_index and m_col variables
@@ -670,9 +666,10 @@ MinstrelWifiManager::UpdateStats (MinstrelWifiRemoteStation *station)
   NS_LOG_DEBUG ("Index-Rate\t\tAttempt\tSuccess");
   for (uint32_t i = 0; i < m_nsupported; i++)
     {
+      RateInfo &rate = station->m_minstrelTable[i];
 
       //calculate the perfect tx time for this rate
-      txTime = station->m_minstrelTable[i].perfectTxTime;
+      txTime = rate.perfectTxTime;
 
       //just for initialization
       if (txTime.GetMicroSeconds () == 0)
@@ -681,37 +678,37 @@ MinstrelWifiManager::UpdateStats (MinstrelWifiRemoteStation *station)
         }
 
       NS_LOG_DEBUG (i << " " << GetSupported (station, i) <<
-                    "\t" << station->m_minstrelTable[i].numRateAttempt <<
-                    "\t" << station->m_minstrelTable[i].numRateSuccess);
+                    "\t" << rate.numRateAttempt <<
+                    "\t" << rate.numRateSuccess);
 
       //if we've attempted something
-      if (station->m_minstrelTable[i].numRateAttempt)
+      if (rate.numRateAttempt)
         {
           /**
            * calculate the probability of success
            * assume probability scales from 0 to 18000
            */
-          tempProb = (station->m_minstrelTable[i].numRateSuccess * 18000) / station->m_minstrelTable[i].numRateAttempt;
+          tempProb = (rate.numRateSuccess * 18000) / rate.numRateAttempt;
 
           //bookeeping
-          station->m_minstrelTable[i].prob = tempProb;
+          rate.prob = tempProb;
 
           //ewma probability (cast for gcc 3.4 compatibility)
-          tempProb = static_cast<uint32_t> (((tempProb * (100 - m_ewmaLevel)) + (station->m_minstrelTable[i].ewmaProb * m_ewmaLevel) ) / 100);
+          tempProb = static_cast<uint32_t> (((tempProb * (100 - m_ewmaLevel)) + (rate.ewmaProb * m_ewmaLevel) ) / 100);
 
-          station->m_minstrelTable[i].ewmaProb = tempProb;
+          rate.ewmaProb = tempProb;
 
           //calculating throughput
-          station->m_minstrelTable[i].throughput = tempProb * (1000000 / txTime.GetMicroSeconds ());
+          rate.throughput = tempProb * (1000000 / txTime.GetMicroSeconds ());
 
         }
 
       //bookeeping
-      station->m_minstrelTable[i].numRateSuccess = 0;
-      station->m_minstrelTable[i].numRateAttempt = 0;
+      rate.numRateSuccess = 0;
+      rate.numRateAttempt = 0;
 
       //Sample less often below 10% and  above 95% of success
-      if ((station->m_minstrelTable[i].ewmaProb > 17100) || (station->m_minstrelTable[i].ewmaProb < 1800))
+      if ((rate.ewmaProb > 17100) || (rate.ewmaProb < 1800))
         {
           /**
            * See: http://wireless.kernel.org/en/developers/Documentation/mac80211/RateControl/minstrel/
@@ -720,24 +717,24 @@ MinstrelWifiManager::UpdateStats (MinstrelWifiRemoteStation *station)
            * For those rates that never work (54mb, 500m range) there is no point in sending 10 sample packets (< 6 ms time).
            * Consequently, for the very very low probability rates, we sample at most twice.
            */
-          if (station->m_minstrelTable[i].retryCount > 2)
+          if (rate.retryCount > 2)
             {
-              station->m_minstrelTable[i].adjustedRetryCount = 2;
+              rate.adjustedRetryCount = 2;
             }
           else
             {
-              station->m_minstrelTable[i].adjustedRetryCount = station->m_minstrelTable[i].retryCount;
+              rate.adjustedRetryCount = rate.retryCount;
             }
         }
       else
         {
-          station->m_minstrelTable[i].adjustedRetryCount = station->m_minstrelTable[i].retryCount;
+          rate.adjustedRetryCount = rate.retryCount;
         }
 
       //if it's 0 allow one retry limit
-      if (station->m_minstrelTable[i].adjustedRetryCount == 0)
+      if (rate.adjustedRetryCount == 0)
         {
-          station->m_minstrelTable[i].adjustedRetryCount = 1;
+          rate.adjustedRetryCount = 1;
         }
     }
 
@@ -879,11 +876,11 @@ MinstrelWifiManager::InitSampleTable (MinstrelWifiRemoteStation *station)
           newIndex = (i + uv) % numSampleRates;
 
           //this loop is used for filling in other uninitilized places
-          while (station->m_sampleTable[newIndex][col] != 0)
+          while (station->m_sampleTable[newIndex * m_sampleCol + col] != 0)
             {
               newIndex = (newIndex + 1) % m_nsupported;
             }
-          station->m_sampleTable[newIndex][col] = i;
+          station->m_sampleTable[newIndex * m_sampleCol + col] = i;
         }
     }
 }
@@ -899,7 +896,7 @@ MinstrelWifiManager::PrintSampleTable (MinstrelWifiRemoteStation *station)
     {
       for (uint32_t j = 0; j < m_sampleCol; j++)
         {
-          table << station->m_sampleTable[i][j] << "\t";
+          table << station->m_sampleTable[i * m_sampleCol + j] << "\t";
         }
       table << std::endl;
     }
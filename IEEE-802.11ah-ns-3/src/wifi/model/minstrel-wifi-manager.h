@@ -63,9 +63,10 @@ struct RateInfo
 typedef std::vector<struct RateInfo> MinstrelRate;
 /**
  * Data structure for a Sample Rate table
- * A vector of a vector uint32_t
+ * One row of sample columns per rate, stored row by row in a single
+ * vector: the entry of rate i and column j is at i * columns + j
  */
-typedef std::vector<std::vector<uint32_t> > SampleRate;
+typedef std::vector<uint32_t> SampleRate;
 
 
 /**
@@ -173,11 +174,10 @@ private:
   void CheckInit (MinstrelWifiRemoteStation *station);  ///< check for initializations
 
   /**
-   * typedef for a vector of a pair of Time, WifiMode.
-   * (Essentially a list for WifiMode and its corresponding transmission time
-   * to transmit a reference packet.
+   * typedef for a vector of Time indexed by WifiMode uid.
+   * (Essentially the time to transmit a reference packet with each mode.)
    */
-  typedef std::vector<std::pair<Time,WifiMode> > TxTime;
+  typedef std::vector<Time> TxTime;
 
   TxTime m_calcTxTime;      ///< to hold all the calculated TxTime for all modes
   Time m_updateStats;       ///< how frequent do we calculate the stats (1/10 seconds)
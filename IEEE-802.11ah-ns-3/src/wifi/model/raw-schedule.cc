@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "raw-schedule.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <map>
+#include <string>
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RawSchedule");
+
+/// Length of a RAW assignment in an RPS element
+static const uint16_t RAW_ASSIGNMENT_LENGTH = 6;
+/// Number of schedules above which RawSchedule::Get drops the unused ones
+static const uint32_t RAW_SCHEDULE_TABLE_SIZE = 64;
+
+RawSchedule::RawSchedule (const RPS &rps)
+  : m_group (8192, -1),
+    m_duration (0)
+{
+  NS_LOG_FUNCTION (this);
+  uint16_t length = rps.GetInformationFieldSize ();
+  NS_ASSERT_MSG (length % RAW_ASSIGNMENT_LENGTH == 0, "RAW configuration incorrect!");
+  uint32_t n = length / RAW_ASSIGNMENT_LENGTH;
+  m_raws.reserve (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      RPS::RawAssignment ass = rps.GetRawAssigmentObj (i);
+      Raw raw;
+      raw.start = m_duration;
+      raw.slotDuration = 500 + ass.GetSlotDurationCount () * 120;
+      raw.slotNum = ass.GetSlotNum ();
+      raw.crossSlotBoundary = ass.GetSlotCrossBoundary () == 0x0001;
+      raw.rawTypeIndex = ass.GetRawTypeIndex ();
+      m_raws.push_back (raw);
+      m_duration += raw.slotDuration * raw.slotNum;
+
+      // the later groups take precedence over the earlier ones
+      uint16_t page = static_cast<uint16_t> (ass.GetRawGroupPage ()) << 11;
+      for (uint32_t aid = ass.GetRawGroupAIDStart (); aid <= ass.GetRawGroupAIDEnd (); aid++)
+        {
+          m_group[page | aid] = i;
+        }
+      NS_LOG_DEBUG ("RAW " << i << ": AIDs " << ass.GetRawGroupAIDStart () << "-" << ass.GetRawGroupAIDEnd ()
+                           << " of page " << (int)ass.GetRawGroupPage () << ", " << raw.slotNum
+                           << " slots of " << raw.slotDuration << " us from " << raw.start << " us");
+    }
+}
+
+/**
+ * \param rps an RPS element
+ * \returns the content of the RAW assignments of the RPS
+ */
+static std::string
+GetRawAssignments (const RPS &rps)
+{
+  uint16_t length = rps.GetInformationFieldSize ();
+  if (length == 0)
+    {
+      return std::string ();
+    }
+  return std::string (reinterpret_cast<const char *> (rps.GetRawAssignment ()), length);
+}
+
+Ptr<const RawSchedule>
+RawSchedule::Get (const RPS &rps)
+{
+  typedef std::map<std::string, Ptr<const RawSchedule> > Table;
+  static Table table;
+
+  std::string key = GetRawAssignments (rps);
+  Table::const_iterator i = table.find (key);
+  if (i != table.end ())
+    {
+      return i->second;
+    }
+  if (table.size () >= RAW_SCHEDULE_TABLE_SIZE)
+    {
+      // drop the schedules which no caller holds any more, the others
+      // must stay shared
+      for (Table::iterator j = table.begin (); j != table.end (); )
+        {
+          if (j->second->GetReferenceCount () == 1)
+            {
+              table.erase (j++);
+            }
+          else
+            {
+              ++j;
+            }
+        }
+    }
+  Ptr<const RawSchedule> schedule = Create<RawSchedule> (rps);
+  table.insert (std::make_pair (key, schedule));
+  return schedule;
+}
+
+uint32_t
+RawSchedule::GetNRaws (void) const
+{
+  return m_raws.size ();
+}
+
+Time
+RawSchedule::GetDuration (void) const
+{
+  return MicroSeconds (m_duration);
+}
+
+Time
+RawSchedule::GetRawStart (uint32_t i) const
+{
+  NS_ASSERT (i < m_raws.size ());
+  return MicroSeconds (m_raws[i].start);
+}
+
+Time
+RawSchedule::GetSlotDuration (uint32_t i) const
+{
+  NS_ASSERT (i < m_raws.size ());
+  return MicroSeconds (m_raws[i].slotDuration);
+}
+
+uint16_t
+RawSchedule::GetSlotNum (uint32_t i) const
+{
+  NS_ASSERT (i < m_raws.size ());
+  return m_raws[i].slotNum;
+}
+
+bool
+RawSchedule::GetSlotCrossBoundary (uint32_t i) const
+{
+  NS_ASSERT (i < m_raws.size ());
+  return m_raws[i].crossSlotBoundary;
+}
+
+uint8_t
+RawSchedule::GetRawTypeIndex (uint32_t i) const
+{
+  NS_ASSERT (i < m_raws.size ());
+  return m_raws[i].rawTypeIndex;
+}
+
+int32_t
+RawSchedule::GetRawIndex (uint16_t aid) const
+{
+  return m_group[aid & 0x1fff];
+}
+
+Time
+RawSchedule::GetSlotStart (uint16_t aid) const
+{
+  int32_t i = GetRawIndex (aid);
+  NS_ASSERT_MSG (i >= 0, "AID " << aid << " is in no RAW group");
+  const Raw &raw = m_raws[i];
+  if (raw.slotNum == 0)
+    {
+      // a group without slots has no slot boundary to wait for
+      return MicroSeconds (raw.start);
+    }
+  uint16_t slot = (aid & 0x07ff) % raw.slotNum;
+  return MicroSeconds (raw.start + raw.slotDuration * slot);
+}
+
+RawScheduleCache::RawScheduleCache (uint32_t size)
+  : m_size (size)
+{
+  NS_ASSERT (size > 0);
+}
+
+Ptr<const RawSchedule>
+RawScheduleCache::Get (const RPS &rps)
+{
+  uint16_t length = rps.GetInformationFieldSize ();
+  const char *content = length == 0 ? "" : reinterpret_cast<const char *> (rps.GetRawAssignment ());
+  for (Entries::iterator i = m_entries.begin (); i != m_entries.end (); ++i)
+    {
+      if (i->first.size () == length && std::memcmp (i->first.data (), content, length) == 0)
+        {
+          m_entries.splice (m_entries.begin (), m_entries, i);
+          return i->second;
+        }
+    }
+  if (m_entries.size () >= m_size)
+    {
+      m_entries.pop_back ();
+    }
+  m_entries.push_front (std::make_pair (std::string (content, length), RawSchedule::Get (rps)));
+  return m_entries.front ().second;
+}
+
+} // namespace ns3
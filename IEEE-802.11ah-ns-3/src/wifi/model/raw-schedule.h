@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RAW_SCHEDULE_H
+#define RAW_SCHEDULE_H
+
+#include <stdint.h>
+#include <vector>
+#include <list>
+#include <string>
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "rps.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ * \brief The slot boundaries of the RAW groups of an RPS element
+ *
+ * The schedule decodes the RAW assignments of an RPS once, and then
+ * answers in constant time in which RAW group a station is, and when its
+ * slot starts relative to the end of the beacon. A station is in the last
+ * RAW group of its page whose AID range holds the 11 low bits of its AID,
+ * and in slot (AID mod number of slots) of that group.
+ *
+ * The beacons of an AP carry the same few RPS elements over and over, so
+ * the schedules are shared: RawSchedule::Get returns the same object to
+ * the AP and to all its stations for as long as one of them holds it.
+ */
+class RawSchedule : public SimpleRefCount<RawSchedule>
+{
+public:
+  /**
+   * \param rps the RPS element to decode
+   */
+  RawSchedule (const RPS &rps);
+
+  /**
+   * The schedules are kept in a table until only the table holds them,
+   * so that the callers which keep their schedules, such as the
+   * RawScheduleCache of the MACs, all share the same objects.
+   *
+   * \param rps an RPS element
+   * \returns the schedule of the RPS, shared with any other caller which
+   *          passed an RPS with the same content and still holds it
+   */
+  static Ptr<const RawSchedule> Get (const RPS &rps);
+
+  /**
+   * \returns the number of RAW groups
+   */
+  uint32_t GetNRaws (void) const;
+  /**
+   * \returns the total duration of the RAW groups
+   */
+  Time GetDuration (void) const;
+
+  /**
+   * \param i the index of a RAW group
+   * \returns the start of the group, relative to the end of the beacon
+   */
+  Time GetRawStart (uint32_t i) const;
+  /**
+   * \param i the index of a RAW group
+   * \returns the duration of the slots of the group
+   */
+  Time GetSlotDuration (uint32_t i) const;
+  /**
+   * \param i the index of a RAW group
+   * \returns the number of slots of the group
+   */
+  uint16_t GetSlotNum (uint32_t i) const;
+  /**
+   * \param i the index of a RAW group
+   * \returns whether a transmission may cross the slot boundaries of the group
+   */
+  bool GetSlotCrossBoundary (uint32_t i) const;
+  /**
+   * \param i the index of a RAW group
+   * \returns the RAW type index of the group
+   */
+  uint8_t GetRawTypeIndex (uint32_t i) const;
+
+  /**
+   * \param aid the AID of a station
+   * \returns the index of the RAW group of the station, or -1 if the
+   *          station is in none
+   */
+  int32_t GetRawIndex (uint16_t aid) const;
+  /**
+   * \param aid the AID of a station in a RAW group
+   * \returns the start of the slot of the station, relative to the end of
+   *          the beacon
+   */
+  Time GetSlotStart (uint16_t aid) const;
+
+private:
+  /** A decoded RAW assignment. */
+  struct Raw
+  {
+    uint64_t start;          //!< the start of the group, in microseconds
+    uint64_t slotDuration;   //!< the duration of a slot, in microseconds
+    uint16_t slotNum;        //!< the number of slots
+    bool crossSlotBoundary;  //!< whether slot boundaries may be crossed
+    uint8_t rawTypeIndex;    //!< the RAW type
+  };
+
+  std::vector<Raw> m_raws;      //!< the RAW groups, in the order of the RPS
+  std::vector<int16_t> m_group; //!< the RAW group of each AID, or -1
+  uint64_t m_duration;          //!< the total duration, in microseconds
+};
+
+/**
+ * \ingroup wifi
+ * \brief The schedules of the last RPS elements seen by a MAC
+ *
+ * A MAC looks up the schedule of every beacon it sends or receives. The
+ * cache keeps the schedules of the last few RPS elements, least recently
+ * used first out, so that the lookup of a known RPS compares a few bytes
+ * instead of decoding it again.
+ */
+class RawScheduleCache
+{
+public:
+  /**
+   * \param size the number of RPS elements to keep
+   */
+  RawScheduleCache (uint32_t size = 8);
+
+  /**
+   * \param rps an RPS element
+   * \returns the schedule of the RPS
+   */
+  Ptr<const RawSchedule> Get (const RPS &rps);
+
+private:
+  /// The content of an RPS element and its schedule
+  typedef std::pair<std::string, Ptr<const RawSchedule> > Entry;
+  /// The entries, most recently used first
+  typedef std::list<Entry> Entries;
+
+  Entries m_entries; //!< the schedules, most recently used first
+  uint32_t m_size;   //!< the maximum number of entries
+};
+
+} // namespace ns3
+
+#endif /* RAW_SCHEDULE_H */
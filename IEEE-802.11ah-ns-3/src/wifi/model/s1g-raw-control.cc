@@ -203,6 +203,97 @@ OffloadStation::GetFailedTransmissionCount (void) const
     return m_offloadFailedCount;
 }
 
+/// Size of the buffered lines above which the log is written out
+static const uint32_t RAW_LOG_MAX_BUFFERED = 1 << 20;
+
+S1gRawLog::S1gRawLog ()
+  : m_bufferedBytes (0)
+{
+}
+
+S1gRawLog::~S1gRawLog ()
+{
+  Flush ();
+}
+
+void
+S1gRawLog::SetPath (std::string path)
+{
+  if (path != m_path)
+    {
+      Flush ();
+      m_path = path;
+    }
+}
+
+S1gRawLog::File &
+S1gRawLog::GetFile (uint16_t aid)
+{
+  if (aid >= m_files.size ())
+    {
+      File file;
+      file.create = false;
+      file.truncate = false;
+      file.dirty = false;
+      m_files.resize (aid + 1, file);
+    }
+  File &file = m_files[aid];
+  if (!file.dirty)
+    {
+      file.dirty = true;
+      m_dirty.push_back (aid);
+    }
+  return file;
+}
+
+void
+S1gRawLog::Create (uint16_t aid, bool truncate)
+{
+  File &file = GetFile (aid);
+  file.create = true;
+  if (truncate)
+    {
+      m_bufferedBytes -= file.buffer.size ();
+      file.buffer.clear ();
+      file.truncate = true;
+    }
+}
+
+void
+S1gRawLog::Append (uint16_t aid, const std::string &line)
+{
+  File &file = GetFile (aid);
+  file.buffer += line;
+  file.buffer += '\n';
+  m_bufferedBytes += line.size () + 1;
+  if (m_bufferedBytes > RAW_LOG_MAX_BUFFERED)
+    {
+      Flush ();
+    }
+}
+
+void
+S1gRawLog::Flush (void)
+{
+  for (std::vector<uint16_t>::const_iterator i = m_dirty.begin (); i != m_dirty.end (); ++i)
+    {
+      File &file = m_files[*i];
+      if (file.create || !file.buffer.empty ())
+        {
+          std::ostringstream name;
+          name << m_path << *i << ".txt";
+          std::ofstream out (name.str ().c_str (), std::ios::out | (file.truncate ? std::ios::trunc : std::ios::app));
+          out << file.buffer;
+        }
+      file.buffer.clear ();
+      file.create = false;
+      file.truncate = false;
+      file.dirty = false;
+    }
+  m_dirty.clear ();
+  m_bufferedBytes = 0;
+}
+
 //
 S1gRawCtr::S1gRawCtr ()
 {
@@ -220,56 +311,98 @@ S1gRawCtr::S1gRawCtr ()
 
     MaxSlotForSensor = 40; //In order to guarantee channel for offload stations.
     m_rps = new RPS;
+    m_markId = 0;
 
 }
 
 S1gRawCtr::~S1gRawCtr ()
 {
+  for (StationsCI it = m_stations.begin (); it != m_stations.end (); it++)
+    {
+      delete *it;
+    }
+  for (OffloadStationsCI it = m_offloadStations.begin (); it != m_offloadStations.end (); it++)
+    {
+      delete *it;
+    }
 }
 
 void
-S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<uint16_t> m_receivedAid, std::string outputpath)
+S1gRawCtr::FlushLog (void)
 {
-   //initialization
-  //if sorted queue is empty, put all sensor into queue
-  std::string ApNode;
-  std::ofstream outputfile;
-  std::ostringstream APId;
+  m_log.Flush ();
+}
 
-  uint16_t numsensor = m_sensorlist.size (); //need to be improved
-  /*if (m_stations.size() < numsensor)
-     {
-      for (uint16_t i = m_stations.size(); i < numsensor; i++)
+void
+S1gRawCtr::EnsureAid (uint16_t aid)
+{
+  if (aid >= m_sensorByAid.size ())
+    {
+      m_sensorByAid.resize (aid + 1, 0);
+      m_offloadByAid.resize (aid + 1, 0);
+      m_lastTransmissionPos.resize (aid + 1, m_lastTransmissionList.end ());
+      m_receivedCount.resize (aid + 1, 0);
+      m_mark.resize (aid + 1, 0);
+    }
+}
+
+void
+S1gRawCtr::CountReceived (const std::vector<uint16_t> &receivedAid)
+{
+  for (std::vector<uint16_t>::const_iterator ci = m_countedAid.begin (); ci != m_countedAid.end (); ci++)
+    {
+      m_receivedCount[*ci] = 0;
+    }
+  m_countedAid = receivedAid;
+  for (std::vector<uint16_t>::const_iterator ci = m_countedAid.begin (); ci != m_countedAid.end (); ci++)
+    {
+      EnsureAid (*ci);
+      m_receivedCount[*ci]++;
+    }
+}
+
+void
+S1gRawCtr::RemoveDisassociatedSensors (const std::vector<uint16_t> &sensorlist)
+{
+  m_markId++;
+  for (std::vector<uint16_t>::const_iterator ci = sensorlist.begin (); ci != sensorlist.end (); ci++)
+    {
+      m_mark[*ci] = m_markId;
+    }
+  StationsCI kept = m_stations.begin ();
+  for (StationsCI it = m_stations.begin (); it != m_stations.end (); it++)
+    {
+      uint16_t aid = (*it)->GetAid ();
+      if (m_mark[aid] == m_markId)
         {
-            Sensor * m_sta = new Sensor;
-            m_sta->SetAid (i+1);
-            m_sta->EstimateNextTransmissionId (currentId+1);
-            //NS_LOG_UNCOND ("initial, set next id = " << currentId);
-            //initialize UpdateInfo struct
-            m_sta->SetEverSuccess (false);
-            m_sta->m_snesorUpdatInfo = (UpdateInfo){currentId,currentId,currentId,false,currentId,currentId,currentId,false};
-            //
-            m_stations.push_back (m_sta); // should create a Dispose function?
-            //
-            APId.clear ();
-            APId.str ("");
-            APId << (i+1);
-            ApNode = APId.str();
-            sensorfile = outputpath + ApNode + ".txt";
-            outputfile.open (sensorfile, std::ios::out | std::ios::trunc);
-            outputfile.close();
-            //
+          *kept++ = *it;
+          continue;
         }
-     } */
+      NS_LOG_UNCOND ( "Aid " << aid << " erased from m_stations since disassociated");
+      m_lastTransmissionList.erase (m_lastTransmissionPos[aid]);
+      m_lastTransmissionPos[aid] = m_lastTransmissionList.end ();
+      m_sensorByAid[aid] = 0;
+      delete *it;
+    }
+  m_stations.erase (kept, m_stations.end ());
+}
+
+void
+S1gRawCtr::UdpateSensorStaInfo (const std::vector<uint16_t> &m_sensorlist, const std::vector<uint16_t> &m_receivedAid, std::string outputpath)
+{
+  //initialization
+  //if sorted queue is empty, put all sensor into queue
+  m_log.SetPath (outputpath);
+  CountReceived (m_receivedAid);
 
-    for (std::vector<uint16_t>::iterator ci = m_sensorlist.begin(); ci != m_sensorlist.end(); ci++)
+    for (std::vector<uint16_t>::const_iterator ci = m_sensorlist.begin(); ci != m_sensorlist.end(); ci++)
     {
+        EnsureAid (*ci);
         if (LookupSensorSta (*ci) == nullptr)
         {
             Sensor * m_sta = new Sensor;
             m_sta->SetAid (*ci);
             m_sta->EstimateNextTransmissionId (currentId+1);
-            //NS_LOG_UNCOND ("initial, set next id = " << currentId);
             //initialize UpdateInfo struct
             m_sta->SetEverSuccess (false);
             m_sta->m_snesorUpdatInfo = (UpdateInfo){currentId,currentId,currentId,false,currentId,currentId,currentId,false};
@@ -278,48 +411,17 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
                 m_sta->m_transIntervalList.push_back(1);
             }
             //
-            m_stations.push_back (m_sta); // should create a Dispose function?
+            m_stations.push_back (m_sta);
+            m_sensorByAid[*ci] = m_sta;
+            m_log.Create (*ci, false);
             //
-            APId.clear ();
-            APId.str ("");
-            APId << (*ci);
-            ApNode = APId.str();
-            sensorfile = outputpath + ApNode + ".txt";
-            outputfile.open (sensorfile, std::ios::out | std::ios::app);
-            outputfile.close();
-            //
-            m_lastTransmissionList.push_back (*ci);
-            NS_LOG_UNCOND ("initial, aid = " << *ci);
-
-        }
-    }
-
-    bool disassoc;
-    //for (StationsCI it = m_stations.begin(); it != m_stations.end(); it++)
-    StationsCI itcheck = m_stations.begin();
-    for (uint16_t i = 0; i < m_stations.size(); i++)
-
-    {
-        disassoc = true;
-        for (std::vector<uint16_t>::iterator ci = m_sensorlist.begin(); ci != m_sensorlist.end(); ci++)
-        {
-            if ((*itcheck)->GetAid ()  == *ci)
-             {
-                 disassoc = false;
-                 if (i < m_stations.size() - 1)
-                     itcheck++;  //avoid itcheck increase to m_sensorlist.end()
-                 break;
-             }
-        }
+            m_lastTransmissionPos[*ci] = m_lastTransmissionList.insert (m_lastTransmissionList.end (), *ci);
+            NS_LOG_DEBUG ("initial, aid = " << *ci);
 
-      if (disassoc == true)
-        {
-            NS_LOG_UNCOND ( "Aid " << (*itcheck)->GetAid () << " erased from m_stations since disassociated");
-            m_stations.erase(itcheck);
         }
     }
 
-
+    RemoveDisassociatedSensors (m_sensorlist);
 
     NS_LOG_UNCOND ("m_aidList.size() = " << m_aidList.size() << ", m_receivedAid = " << m_receivedAid.size () << ", m_stations.size() = " << m_stations.size() << ", currentId = " << currentId);
 
@@ -333,36 +435,14 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
          }
 
          m_receivedsuccess = false;
-         for (std::vector<uint16_t>::iterator ci = m_receivedAid.begin(); ci != m_receivedAid.end(); ci++)
-         {
-
-             if (*ci == *it)
+         if (m_receivedCount[*it] > 0)
               {
-                //NS_LOG_UNCOND ("stations of aid " << *it << " received");
                 stationTransmit->SetTransmissionSuccess (true);
-                  //output to files.
-                  //write into currentID  coulumn
-                  //write  into allowed to send coulumn
-                  //write  into reaeived to receive coulumn
-                  /* APId.clear ();
-                  APId.str ("");
-                  APId << (*it);
-                  ApNode = APId.str();
-
-                  sensorfile = outputpath + ApNode + ".txt";
-                  outputfile.open (sensorfile, std::ios::out | std::ios::app);
-                  outputfile << currentId << "\t" << "1" << "\t" << "1" << "\n";
-                  outputfile.close(); */
-                  //
 
                 if (stationTransmit->GetEverSuccess () == false)
                   {
                       stationTransmit->m_snesorUpdatInfo = (UpdateInfo){currentId-1,currentId-1,currentId-1,false,currentId-1,currentId-1,currentId-1,false};
                       stationTransmit->SetEverSuccess (true);
-                      /*for (uint16_t i = 0; i < stationTransmit->m_transIntervalListSize; i++)
-                      {
-                          stationTransmit->m_transIntervalList.push_back(1);
-                      }*/
                       for (std::vector<uint16_t>::iterator ci = stationTransmit->m_transIntervalList.begin(); ci != stationTransmit->m_transIntervalList.end(); ci++)
                       {
                           (*ci) = 1;
@@ -378,28 +458,10 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
 
                 stationTransmit->m_snesorUpdatInfo.preTrySuccess = stationTransmit->m_snesorUpdatInfo.CurrentTrySuccess;
                 stationTransmit->m_snesorUpdatInfo.CurrentTrySuccess = true;
-
-                goto EstimateInterval;
+                continue;
               }
-         }
 
-
-            //NS_LOG_UNCOND ("stations of aid " << *it << " not received");
             stationTransmit->SetTransmissionSuccess (false);
-            //output to files.
-            //write into currentID  coulumn
-            //write  into allowed to send coulumn
-            //write  into received to receive coulumn
-           /* APId.clear ();
-            APId.str ("");
-            APId << (*it);
-            ApNode = APId.str();
-
-            sensorfile = outputpath + ApNode + ".txt";
-            outputfile.open (sensorfile, std::ios::out | std::ios::app);
-            outputfile << currentId << "\t" << "1" << "\t" << "0" << "\n";
-            outputfile.close(); */
-            //
 
             stationTransmit->m_snesorUpdatInfo.preUnsuccessId = stationTransmit->m_snesorUpdatInfo.CurrentUnSuccessId; //update, swith current to pre
             stationTransmit->m_snesorUpdatInfo.CurrentUnSuccessId = currentId;
@@ -407,13 +469,9 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
 
             stationTransmit->m_snesorUpdatInfo.preTrySuccess = stationTransmit->m_snesorUpdatInfo.CurrentTrySuccess;
             stationTransmit->m_snesorUpdatInfo.CurrentTrySuccess = false;
-
-    EstimateInterval :
-           //stationTransmit->EstimateTransmissionInterval (currentId);
-           //NS_LOG_UNCOND ("... "); //to do, remove it
-         uint16_t add=0;
      }
 
+    std::ostringstream line;
     for (std::vector<uint16_t>::iterator it = m_aidList.begin(); it != m_aidList.end(); it++)
      {
         Sensor * stationTransmit = LookupSensorSta (*it);
@@ -422,48 +480,31 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
             return;
           }
 
-        uint16_t m_numReceived = 0;
-        for (std::vector<uint16_t>::iterator ci = m_receivedAid.begin(); ci != m_receivedAid.end(); ci++)
-          {
-            if (*ci == *it)
-             {
-                m_numReceived++;
-             }
-          }
-
-        //NS_LOG_UNCOND ("stations of aid " << *it << " received " << m_numReceived << " packets");
-
-         APId.clear ();
-         APId.str ("");
-         APId << (*it);
-         ApNode = APId.str();
+        uint16_t m_numReceived = m_receivedCount[*it];
 
-         sensorfile = outputpath + ApNode + ".txt";
-         outputfile.open (sensorfile, std::ios::out | std::ios::app);
-         outputfile << currentId << "\t" << "1" << "\t" << m_numReceived << "\t" << stationTransmit->GetTransInOneBeacon () << "\n";
-         outputfile.close();
+         line.str ("");
+         line << currentId << "\t" << "1" << "\t" << m_numReceived << "\t" << stationTransmit->GetTransInOneBeacon ();
+         m_log.Append (*it, line.str ());
 
          stationTransmit->SetNumPacketsReceived (m_numReceived);
          stationTransmit->EstimateTransmissionInterval (currentId, m_beaconInterval);
      }
 
- for (std::vector<uint16_t>::iterator ci = m_receivedAid.begin(); ci != m_receivedAid.end(); ci++)
+ //stations which sent without being allowed to; each is handled once
+ m_markId++;
+ for (std::vector<uint16_t>::iterator it = m_aidList.begin(); it != m_aidList.end(); it++)
     {
-      uint16_t m_numReceived = 0;
-      bool match = false;
-      for (std::vector<uint16_t>::iterator it = m_aidList.begin(); it != m_aidList.end(); it++)
-         {
-             if (*ci == *it)
-              {
-                match = true;
-                break;
-              }
-         }
+      m_mark[*it] = m_markId;
+    }
+ for (std::vector<uint16_t>::const_iterator ci = m_receivedAid.begin(); ci != m_receivedAid.end(); ci++)
+    {
+        bool match = m_mark[*ci] == m_markId;
 
         Sensor * stationTransmit = LookupSensorSta (*ci);
     if (stationTransmit != nullptr && !match)
         {
             m_aidList.push_back (*ci); //trick, avoid same receiveAid repeate several times
+            m_mark[*ci] = m_markId;
              if (stationTransmit->GetEverSuccess () == false)
              {
                  stationTransmit->m_snesorUpdatInfo = (UpdateInfo){currentId-1,currentId-1,currentId-1,false,currentId-1,currentId-1,currentId-1,false};
@@ -485,25 +526,11 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
              stationTransmit->m_snesorUpdatInfo.preTrySuccess = stationTransmit->m_snesorUpdatInfo.CurrentTrySuccess;
              stationTransmit->m_snesorUpdatInfo.CurrentTrySuccess = true;
 
-             //NS_LOG_UNCOND ("stations of aid " << *it << " received " << m_numReceived << " packets");
-
-            for (std::vector<uint16_t>::iterator ct = m_receivedAid.begin(); ct != m_receivedAid.end(); ct++)
-            {
-                if (*ci == *ct)
-                {
-                    m_numReceived++;
-                }
-            }
-
-             APId.clear ();
-             APId.str ("");
-             APId << (*ci);
-             ApNode = APId.str();
+             uint16_t m_numReceived = m_receivedCount[*ci];
 
-             sensorfile = outputpath + ApNode + ".txt";
-             outputfile.open (sensorfile, std::ios::out | std::ios::app);
-             outputfile << currentId << "\t" << "0" << "\t" << m_numReceived << "\t" << stationTransmit->GetTransInOneBeacon () << "\n";
-             outputfile.close();
+             line.str ("");
+             line << currentId << "\t" << "0" << "\t" << m_numReceived << "\t" << stationTransmit->GetTransInOneBeacon ();
+             m_log.Append (*ci, line.str ());
 
              stationTransmit->SetNumPacketsReceived (m_numReceived);
              stationTransmit->EstimateTransmissionInterval (currentId, m_beaconInterval);
@@ -739,58 +766,44 @@ S1gRawCtr::SetSensorAllowedToSend ()
 
    uint32_t SendNum = 0;
      
-   std::vector<uint16_t>::iterator it = m_lastTransmissionList.begin();
-   //for (std::vector<uint16_t>::iterator it = m_lastTransmissionList.begin(); it != m_lastTransmissionList.end(); it++)
-    for (uint16_t i = 0; i < m_lastTransmissionList.size (); i++)
+   //stations allowed to send are moved to the back of the list, each
+   //station present at the start is visited once
+   std::list<uint16_t>::iterator it = m_lastTransmissionList.begin();
+   for (std::size_t i = m_lastTransmissionList.size (); i > 0; i--)
      {
-         Sensor * stationTransmit;
-         if (LookupSensorSta (*it) == nullptr) //disassociated station
+         std::list<uint16_t>::iterator current = it++;
+         Sensor * stationTransmit = LookupSensorSta (*current);
+         if (stationTransmit == nullptr) //disassociated station
            {
-             m_lastTransmissionList.erase (it);
-             it++;
+             m_lastTransmissionList.erase (current);
              continue;
            }
-         stationTransmit = LookupSensorSta (*it);
-         it++;
        if (stationTransmit->GetEstimateNextTransmissionId () <= currentId)
         {
            if (SendNum == m_numSendSensorAllowed)
              {
                 stationTransmit->EstimateNextTransmissionId (currentId+1);
                 //Postpone transmission to next interval
-                //NS_LOG_UNCOND ("aid = " << stationTransmit->GetAid () << " not allwed to send, since its full ");
-                //NS_LOG_UNCOND ("update NextTransmissionId to = " << currentId+1);
              }
            else if ( SendNum + stationTransmit->GetTransInOneBeacon () > m_numSendSensorAllowed)
             {
                 stationTransmit->EstimateNextTransmissionId (currentId+1);
                 //Postpone transmission to next interval
-                //NS_LOG_UNCOND ("aid = " << stationTransmit->GetAid () << " not allwed to send, since transmit number is " << stationTransmit->GetTransInOneBeacon () );
-                //NS_LOG_UNCOND ("update NextTransmissionId to = " << currentId+1);
 
                 uint8_t numleft = m_numSendSensorAllowed - SendNum;
                 if (numleft > 0)
                  {
-                     it--;
                      stationTransmit->SetTransInOneBeacon (numleft);
                      m_aidList.push_back(stationTransmit->GetAid ());
-                     std::vector<uint16_t>::iterator position = LookupLastTransmission (stationTransmit->GetAid ());
-                     m_lastTransmissionList.erase (position);
-                     m_lastTransmissionList.push_back (stationTransmit->GetAid ());
+                     m_lastTransmissionList.splice (m_lastTransmissionList.end (), m_lastTransmissionList, current);
                      SendNum = SendNum + numleft;
-                     //NS_LOG_UNCOND ("reset Trans number to = " << numleft << " to send");
                  }
             }
            else
             {
-               it--;
                m_aidList.push_back(stationTransmit->GetAid ());
-               std::vector<uint16_t>::iterator position = LookupLastTransmission (stationTransmit->GetAid ());
-               m_lastTransmissionList.erase (position);
-               m_lastTransmissionList.push_back (stationTransmit->GetAid ());
+               m_lastTransmissionList.splice (m_lastTransmissionList.end (), m_lastTransmissionList, current);
                SendNum = SendNum + stationTransmit->GetTransInOneBeacon ();
-               //NS_LOG_UNCOND ("aid = " << stationTransmit->GetAid () << " allowed to send");
-
             }
          ////put first send stations to m_aidList, choose stations based on last transmission time.
         }
@@ -801,24 +814,11 @@ S1gRawCtr::SetSensorAllowedToSend ()
 
  }
 
-std::vector<uint16_t>::iterator
+std::list<uint16_t>::iterator
 S1gRawCtr::LookupLastTransmission (uint16_t aid)
 {
-
-    for (std::vector<uint16_t>::iterator it = m_lastTransmissionList.begin(); it != m_lastTransmissionList.end(); it++)
-    {
-       // NS_LOG_UNCOND ("m_lastTransmissionList = " << *it);
-    }
-
-  for (std::vector<uint16_t>::iterator it = m_lastTransmissionList.begin(); it != m_lastTransmissionList.end(); it++)
-    {
-        if (aid == *it)
-        {
-            return it;
-        }
-    }
-
-  NS_ASSERT ("ERROR OCUURS");
+  NS_ASSERT (LookupSensorSta (aid) != nullptr);
+  return m_lastTransmissionPos[aid];
 }
 
 
@@ -827,7 +827,7 @@ S1gRawCtr::LookupLastTransmission (uint16_t aid)
 
 //offload
 void
-S1gRawCtr::UdpateOffloadStaInfo (std::vector<uint16_t> m_OffloadList, std::vector<uint16_t> m_receivedAid, std::string outputpath)
+S1gRawCtr::UdpateOffloadStaInfo (const std::vector<uint16_t> &m_OffloadList, const std::vector<uint16_t> &m_receivedAid, std::string outputpath)
 //to do
 //need to change Ap-wifi-mac.cc to get numsensor info
 //need to get successful transmission info.
@@ -853,73 +853,40 @@ S1gRawCtr::UdpateOffloadStaInfo (std::vector<uint16_t> m_OffloadList, std::vecto
     } should be removed*/
 
 
-    std::string ApNode;
-    std::ofstream outputfile;
-    std::ostringstream APId;
-
+    m_log.SetPath (outputpath);
+    CountReceived (m_receivedAid);
 
-    for (std::vector<uint16_t>::iterator ci = m_OffloadList.begin(); ci != m_OffloadList.end(); ci++)
+    for (std::vector<uint16_t>::const_iterator ci = m_OffloadList.begin(); ci != m_OffloadList.end(); ci++)
      {
+        EnsureAid (*ci);
         if (LookupOffloadSta (*ci) == nullptr)
           {
               OffloadStation * m_offloadSta = new OffloadStation;
               m_offloadSta->SetAid (*ci);
               m_offloadSta->SetOffloadStaActive (true);
               m_offloadSta->IncreaseFailedTransmissionCount (0);
-              m_offloadStations.push_back (m_offloadSta); // should create a Dispose function?
-              NS_LOG_UNCOND ("m_offloadStations.size () = " << m_offloadStations.size ());
-
-              APId.clear ();
-              APId.str ("");
-              APId << (*ci);
-              ApNode = APId.str();
-              sensorfile = outputpath + ApNode + ".txt";
-              outputfile.open (sensorfile, std::ios::out | std::ios::trunc);
-              outputfile.close();
+              m_offloadStations.push_back (m_offloadSta);
+              m_offloadByAid[*ci] = m_offloadSta;
+              NS_LOG_DEBUG ("m_offloadStations.size () = " << m_offloadStations.size ());
+
+              m_log.Create (*ci, true);
           }
      }
 
     //update active offload stations' info.
+    std::ostringstream line;
     for (std::vector<uint16_t>::iterator it = m_aidOffloadList.begin(); it != m_aidOffloadList.end(); it++)
     {
         OffloadStation * OffloadStaTransmit = LookupOffloadSta (*it);
-
-        for (std::vector<uint16_t>::iterator ci = m_receivedAid.begin(); ci != m_receivedAid.end(); ci++)
-        {
-            if (*ci == *it)
-            {
-                //NS_LOG_UNCOND ("stations of aid " << *it << " received, " << *ci);
-                //output to files.
-                APId.clear ();
-                APId.str ("");
-                APId << (*it);
-                ApNode = APId.str();
-                sensorfile = outputpath + ApNode + ".txt";
-                outputfile.open (sensorfile, std::ios::out | std::ios::app);
-                outputfile << currentId << "\t" << "1" << "\t" << "1" << "\n";
-                outputfile.close();
-                //
-                OffloadStaTransmit->SetTransmissionSuccess (true);
-                OffloadStaTransmit->IncreaseFailedTransmissionCount (1);
-                goto FailedMax;
-            }
-        }
+        bool received = m_receivedCount[*it] > 0;
 
         //output to files.
-        //NS_LOG_UNCOND ("stations of aid " << *it << " not received");
-        APId.clear ();
-        APId.str ("");
-        APId << (*it);
-        ApNode = APId.str();
-        sensorfile = outputpath + ApNode + ".txt";
-        outputfile.open (sensorfile, std::ios::out | std::ios::app);
-        outputfile << currentId << "\t" << "1" << "\t" << "0" << "\n";
-        outputfile.close();
-        //
-
-        OffloadStaTransmit->SetTransmissionSuccess (false);
-        OffloadStaTransmit->IncreaseFailedTransmissionCount (0);
-    FailedMax:
+        line.str ("");
+        line << currentId << "\t" << "1" << "\t" << (received ? "1" : "0");
+        m_log.Append (*it, line.str ());
+
+        OffloadStaTransmit->SetTransmissionSuccess (received);
+        OffloadStaTransmit->IncreaseFailedTransmissionCount (received);
         if (OffloadStaTransmit->GetFailedTransmissionCount () == m_offloadFailedMax)
             OffloadStaTransmit->SetOffloadStaActive (false);
 
@@ -994,7 +961,7 @@ S1gRawCtr::GetRPS ()
 
 // Beacon duration), before that use NGroup=1 and initialize by ap-wifi-mac
 RPS
-S1gRawCtr::UpdateRAWGroupping (std::vector<uint16_t> m_sensorlist, std::vector<uint16_t> m_OffloadList, std::vector<uint16_t> m_receivedAid, uint64_t BeaconInterval, std::string outputpath)
+S1gRawCtr::UpdateRAWGroupping (const std::vector<uint16_t> &m_sensorlist, const std::vector<uint16_t> &m_OffloadList, const std::vector<uint16_t> &m_receivedAid, uint64_t BeaconInterval, std::string outputpath)
  {
      NS_ASSERT ("S1gRawCtr should not be called");
      
@@ -1159,7 +1126,7 @@ S1gRawCtr::configureRAW ( )
           aid_end = *it;
           //aid_start = 2;
           //aid_end = 66;
-          NS_LOG_UNCOND ("sensor, aid_start =" << aid_start << ", aid_end=" << aid_end << ", SlotDurationCount = " << SlotDurationCount << ", transmit num one beacon = " << num);
+          NS_LOG_DEBUG ("sensor, aid_start =" << aid_start << ", aid_end=" << aid_end << ", SlotDurationCount = " << SlotDurationCount << ", transmit num one beacon = " << num);
 
           rawinfo = (aid_end << 13) | (aid_start << 2) | page;
           m_raw->SetRawGroup (rawinfo);
@@ -1213,7 +1180,7 @@ S1gRawCtr::configureRAW ( )
          //aid_start = 1;
          //aid_end = 1;
         rawinfo = (aid_end << 13) | (aid_start << 2) | page;
-        NS_LOG_UNCOND ("offload, aid_start =" << aid_start << ", aid_end=" << aid_end << ", offloadcount =" << offloadcount);
+        NS_LOG_DEBUG ("offload, aid_start =" << aid_start << ", aid_end=" << aid_end << ", offloadcount =" << offloadcount);
 
         m_raw2->SetRawGroup (rawinfo);
         m_rps->SetRawAssignment(*m_raw2);
@@ -1227,32 +1194,24 @@ S1gRawCtr::configureRAW ( )
     //delete m_rps;
 }
 
-//what if lookup fails, is it possibile?
 Sensor *
 S1gRawCtr::LookupSensorSta (uint16_t aid)
 {
-   for (StationsCI it = m_stations.begin(); it != m_stations.end(); it++)
-   {
-       if (aid == (*it)->GetAid ())
-        {
-           return (*it);
-        }
-   }
-    return nullptr;
+  if (aid < m_sensorByAid.size ())
+    {
+      return m_sensorByAid[aid];
+    }
+  return nullptr;
 }
 
-//what if lookup fails, is it possibile?
 OffloadStation *
 S1gRawCtr::LookupOffloadSta (uint16_t aid)
 {
-    for (OffloadStationsCI it = m_offloadStations.begin(); it != m_offloadStations.end(); it++)
+  if (aid < m_offloadByAid.size ())
     {
-        if (aid == (*it)->GetAid ())
-        {
-            return (*it);
-        }
+      return m_offloadByAid[aid];
     }
-    return nullptr;
+  return nullptr;
 }
 
 void
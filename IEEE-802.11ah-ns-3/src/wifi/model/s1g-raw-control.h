@@ -29,6 +29,8 @@
 #include "supported-rates.h"
 #include "ns3/random-variable-stream.h"
 #include "rps.h"
+#include <list>
+#include <string>
 
 namespace ns3 {
     
@@ -154,6 +156,66 @@ private:
     //failure here menas AP receives no packets.
 };
 
+/**
+ * \brief Buffered writer of the per-station files of the RAW controller
+ *
+ * The controller keeps one text file per AID under an output path. The
+ * lines are kept in memory and written out once enough of them have been
+ * buffered, when the writer is flushed or when it is destroyed, so that a
+ * beacon does not open and close one file per station.
+ */
+class S1gRawLog
+{
+public:
+  S1gRawLog ();
+  ~S1gRawLog ();
+
+  /**
+   * \param path the prefix of the file names; the AID and ".txt" are
+   *        appended to it
+   */
+  void SetPath (std::string path);
+  /**
+   * Create the file of a station.
+   *
+   * \param aid the AID of the station
+   * \param truncate whether to drop the existing content of the file
+   */
+  void Create (uint16_t aid, bool truncate);
+  /**
+   * Append a line to the file of a station.
+   *
+   * \param aid the AID of the station
+   * \param line the line, without its end of line
+   */
+  void Append (uint16_t aid, const std::string &line);
+  /**
+   * Write all the buffered lines to their files.
+   */
+  void Flush (void);
+
+private:
+  /** The pending output of one file. */
+  struct File
+  {
+    std::string buffer;  //!< the lines not written yet
+    bool create;         //!< whether the file must be created
+    bool truncate;       //!< whether the file must be truncated first
+    bool dirty;          //!< whether the AID is in m_dirty
+  };
+
+  /**
+   * \param aid the AID of the station
+   * \returns the pending output of the file of the station
+   */
+  File & GetFile (uint16_t aid);
+
+  std::string m_path;            //!< the prefix of the file names
+  std::vector<File> m_files;     //!< the pending output, indexed by AID
+  std::vector<uint16_t> m_dirty; //!< the AIDs with pending output
+  uint32_t m_bufferedBytes;      //!< the total size of the buffers
+};
+
 class S1gRawCtr
 {
 public:
@@ -162,14 +224,18 @@ public:
   S1gRawCtr ();
   virtual ~S1gRawCtr ();
 
-    RPS  UpdateRAWGroupping (std::vector<uint16_t> m_aidlist, std::vector<uint16_t> m_aidOffloadList, std::vector<uint16_t> m_receivedAid, uint64_t BeaconInterval, std::string outputpath);
+  RPS  UpdateRAWGroupping (const std::vector<uint16_t> &m_aidlist, const std::vector<uint16_t> &m_aidOffloadList, const std::vector<uint16_t> &m_receivedAid, uint64_t BeaconInterval, std::string outputpath);
 
   void configureRAW ();
   RPS GetRPS ();
     
   void deleteRps ();
-  void UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<uint16_t> m_receivedAid, std::string outputpath); //need to change, controlled by AP
-  void UdpateOffloadStaInfo (std::vector<uint16_t> m_OffloadList, std::vector<uint16_t>  receivedStas, std::string outputpath);
+  /**
+   * Write the buffered lines of the per-station files.
+   */
+  void FlushLog (void);
+  void UdpateSensorStaInfo (const std::vector<uint16_t> &m_sensorlist, const std::vector<uint16_t> &m_receivedAid, std::string outputpath); //need to change, controlled by AP
+  void UdpateOffloadStaInfo (const std::vector<uint16_t> &m_OffloadList, const std::vector<uint16_t> &receivedStas, std::string outputpath);
   void calculateActiveOffloadSta ();
   void SetOffloadAllowedToSend ();
   
@@ -182,7 +248,7 @@ public:
   Sensor * LookupSensorSta (uint16_t aid);
   OffloadStation * LookupOffloadSta (uint16_t aid); //can be combined with function LookupSensorSta.
     
-  std::vector<uint16_t>::iterator  LookupLastTransmission (uint16_t aid);
+  std::list<uint16_t>::iterator  LookupLastTransmission (uint16_t aid);
   
     
     typedef std::vector<Sensor *> Stations;
@@ -200,9 +266,37 @@ public:
     std::vector<uint16_t>::iterator m_aidListCI;
     std::vector<uint16_t> m_aidOffloadList;
     std::vector<uint16_t>::iterator m_aidOffloadListCI;
-    std::vector<uint16_t> m_lastTransmissionList;
+    std::list<uint16_t> m_lastTransmissionList; //least recently allowed stations first
     
 private:
+  /**
+   * Grow the tables indexed by AID so that they hold the given AID.
+   *
+   * \param aid the AID
+   */
+  void EnsureAid (uint16_t aid);
+  /**
+   * Count the packets received from each station since the last beacon.
+   *
+   * \param receivedAid the AID of the sender of each received packet
+   */
+  void CountReceived (const std::vector<uint16_t> &receivedAid);
+  /**
+   * Remove the sensors which are no longer associated.
+   *
+   * \param sensorlist the AIDs of the associated sensors
+   */
+  void RemoveDisassociatedSensors (const std::vector<uint16_t> &sensorlist);
+
+  std::vector<Sensor *> m_sensorByAid;                //!< the sensors, indexed by AID
+  std::vector<OffloadStation *> m_offloadByAid;       //!< the offload stations, indexed by AID
+  std::vector<std::list<uint16_t>::iterator> m_lastTransmissionPos; //!< the position of each sensor in m_lastTransmissionList, indexed by AID
+  std::vector<uint16_t> m_receivedCount;              //!< the packets received since the last beacon, indexed by AID
+  std::vector<uint16_t> m_countedAid;                 //!< the AIDs counted in m_receivedCount
+  std::vector<uint32_t> m_mark;                       //!< per AID stamp used to test membership in linear time
+  uint32_t m_markId;                                  //!< the current value of the stamp
+  S1gRawLog m_log;                                    //!< the writer of the per-station files
+
     
   uint64_t m_rawslotDuration; //us
   uint64_t m_maybeAirtimeSensor;
@@ -233,8 +327,6 @@ private:
   RPSVector rpslist;
     
     bool  m_receivedsuccess;
-    
-    std::string  sensorfile;
 };
 
 } //namespace ns3
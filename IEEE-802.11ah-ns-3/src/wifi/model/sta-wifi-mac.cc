@@ -667,6 +667,7 @@ void StaWifiMac::GoToSleep (Time sleeptime)
 			NS_LOG_DEBUG(
 					"At " << Simulator::Now().GetSeconds() << " s AID " << this->GetAID() << " switches to SLEEP. Schedule wake-up after " << sleeptime.GetMicroSeconds() << " us.");
 			m_low->GetPhy()->SetSleepMode();
+			m_low->GetPhy()->SetWakeUpTime(Simulator::Now() + sleeptime);
 			Simulator::Schedule(sleeptime, &StaWifiMac::WakeUp, this);
 			//std::cout << "+++At " << Simulator::Now().GetMicroSeconds() << "us: GoToSleep:" << sleeptime.GetMicroSeconds() << " FULL" << std::endl;
 
@@ -1050,24 +1051,12 @@ if (assocVaule < fastAssocThreshold)
   hdr.SetAddr3 (GetBssid ());
   hdr.SetDsNotFrom ();
   hdr.SetDsNotTo ();
-  Ptr<Packet> packet = Create<Packet> ();
-  MgtAssocRequestHeader assoc;
-  assoc.SetSsid (GetSsid ());
-  assoc.SetSupportedRates (GetSupportedRates ());
   if (m_htSupported)
     {
-      assoc.SetHtCapabilities (GetHtCapabilities ());
       hdr.SetNoOrder ();
     }
-
-  if (m_s1gSupported)
-    {
-        assoc.SetS1gCapabilities (GetS1gCapabilities ());
-        //NS_LOG_UNCOND ("StaWifiMac::SendAssociationRequest (void)");
-
-    }
-
-  packet->AddHeader (assoc);
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (GetAssocRequest ());
 
   //The standard is not clear on the correct queue for management
   //frames if we are a QoS AP. The approach taken here is to always
@@ -1085,6 +1074,96 @@ if (assocVaule < fastAssocThreshold)
                                            &StaWifiMac::AssocRequestTimeout, this);
 }
 
+MgtAssocRequestHeader
+StaWifiMac::GetAssocRequest (void) const
+{
+  MgtAssocRequestHeader assoc;
+  assoc.SetSsid (GetSsid ());
+  assoc.SetSupportedRates (GetSupportedRates ());
+  if (m_htSupported)
+    {
+      assoc.SetHtCapabilities (GetHtCapabilities ());
+    }
+  if (m_s1gSupported)
+    {
+      assoc.SetS1gCapabilities (GetS1gCapabilities ());
+    }
+  return assoc;
+}
+
+void
+StaWifiMac::SetAssociated (Mac48Address bssid, const MgtAssocResponseHeader &assocResp)
+{
+  NS_LOG_FUNCTION (this << bssid);
+  if (m_probeRequestEvent.IsRunning ())
+    {
+      m_probeRequestEvent.Cancel ();
+    }
+  if (m_assocRequestEvent.IsRunning ())
+    {
+      m_assocRequestEvent.Cancel ();
+    }
+  SetBssid (bssid);
+  SetAID (assocResp.GetAID ());
+  SetState (ASSOCIATED);
+  NS_LOG_DEBUG ("[" << GetAddress () << "] is associated and has AID = " << GetAID ());
+  SupportedRates rates = assocResp.GetSupportedRates ();
+  if (m_htSupported)
+    {
+      HtCapabilities htcapabilities = assocResp.GetHtCapabilities ();
+      m_stationManager->AddStationHtCapabilities (bssid, htcapabilities);
+    }
+
+  if (m_s1gSupported)
+    {
+      S1gCapabilities s1gcapabilities = assocResp.GetS1gCapabilities ();
+      NS_LOG_UNCOND (GetAddress () << ", receive " << uint16_t (s1gcapabilities.GetChannelWidth ()));
+      m_stationManager->AddStationS1gCapabilities (bssid, s1gcapabilities);
+    }
+
+  for (uint32_t i = 0; i < m_phy->GetNModes (); i++)
+    {
+      WifiMode mode = m_phy->GetMode (i);
+      for (uint32_t j = 0; j < m_phy->m_deviceRateSet.size (); j++)
+        {
+          if (m_phy->m_deviceRateSet[j] == mode)
+            {
+              NS_LOG_UNCOND (GetAddress () << ", AddSupportedMode " << bssid << ", " << mode);
+              m_stationManager->AddSupportedMode (bssid, mode);
+              if (rates.IsBasicRate (mode.GetDataRate ()))
+                {
+                  m_stationManager->AddBasicMode (mode);
+                }
+            }
+        }
+      if (rates.IsSupportedRate (mode.GetDataRate ()))
+        {
+          m_stationManager->AddSupportedMode (bssid, mode);
+          if (rates.IsBasicRate (mode.GetDataRate ()))
+            {
+              m_stationManager->AddBasicMode (mode);
+            }
+        }
+    }
+  if (m_htSupported)
+    {
+      HtCapabilities htcapabilities = assocResp.GetHtCapabilities ();
+      for (uint32_t i = 0; i < m_phy->GetNMcs (); i++)
+        {
+          uint8_t mcs = m_phy->GetMcs (i);
+          if (htcapabilities.IsSupportedMcs (mcs))
+            {
+              m_stationManager->AddSupportedMcs (bssid, mcs);
+              //here should add a control to add basic MCS when it is implemented
+            }
+        }
+    }
+  if (!m_linkUp.IsNull ())
+    {
+      m_linkUp ();
+    }
+}
+
 void
 StaWifiMac::TryToEnsureAssociated (void)
 {
@@ -1491,64 +1570,24 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
 
         
         UnsetInRAWgroup ();
-        uint8_t * rawassign;
-        rawassign = beacon.GetRPS().GetRawAssignment();
-        uint16_t raw_len = beacon.GetRPS().GetInformationFieldSize();
-        uint16_t rawAssignment_len = 6;
-        if (raw_len % rawAssignment_len !=0)
-          {
-             NS_ASSERT ("RAW configuration incorrect!");
-          }
-        uint8_t RAW_number = raw_len/rawAssignment_len;
-
-         uint16_t m_slotDurationCount=0;
-         uint16_t m_slotNum=0;
-         uint64_t m_currentRAW_start=0;
-         m_lastRawDurationus = MicroSeconds(0);
-    for (uint8_t raw_index=0; raw_index < RAW_number; raw_index++)
-      {
-        auto ass = beacon.GetRPS().GetRawAssigmentObj(raw_index);
-
-        if (ass.GetRawTypeIndex() == 4) // only support Generic Raw (paged STA RAW or not)
+        Ptr<const RawSchedule> schedule = m_rawSchedules.Get (beacon.GetRPS ());
+        m_lastRawDurationus = schedule->GetDuration ();
+        uint32_t lastRaw = schedule->GetNRaws ();
+        if (lastRaw > 0)
           {
-            m_pagedStaRaw = true;
+            // these follow the last RAW group of the RPS
+            lastRaw--;
+            m_pagedStaRaw = schedule->GetRawTypeIndex (lastRaw) == 4; // only support Generic Raw (paged STA RAW or not)
+            m_slotDuration = schedule->GetSlotDuration (lastRaw);
+            m_crossSlotBoundaryAllowed = schedule->GetSlotCrossBoundary (lastRaw);
           }
-        else
+        int32_t raw = schedule->GetRawIndex (GetAID ());
+        if (raw >= 0)
           {
-            m_pagedStaRaw = false;
+            m_statSlotStart = schedule->GetSlotStart (GetAID ());
+            SetInRAWgroup ();
+            m_currentslotDuration = schedule->GetSlotDuration (raw); //To support variable time duration among multiple RAWs
           }
-         m_currentRAW_start=m_currentRAW_start+(500 + m_slotDurationCount * 120)*m_slotNum;
-         m_slotDurationCount = ass.GetSlotDurationCount();
-         m_slotNum = ass.GetSlotNum();
-
-        m_slotDuration = MicroSeconds(500 + m_slotDurationCount * 120);
-        m_lastRawDurationus = m_lastRawDurationus + m_slotDuration * m_slotNum;
-        m_crossSlotBoundaryAllowed = ass.GetSlotCrossBoundary() == 0x0001;
-
-         if (ass.GetRawGroupPage() == ((GetAID() >> 11 ) & 0x0003)) //in the page indexed
-           {
-               uint16_t statsPerSlot = 0;
-               uint16_t statRawSlot = 0;
-
-               Ptr<UniformRandomVariable> m_rv = CreateObject<UniformRandomVariable> ();
-               uint16_t offset = m_rv->GetValue (0, 1023);
-               offset =0; // for test
-               statsPerSlot = (ass.GetRawGroupAIDEnd() - ass.GetRawGroupAIDStart() + 1)/m_slotNum;
-               //statRawSlot = ((GetAID() & 0x03ff)-raw_start)/statsPerSlot;
-               statRawSlot = ((GetAID() & 0x07ff)+offset)%m_slotNum;
-
-             if ((ass.GetRawGroupAIDStart() <= (GetAID() & 0x07ff)) && ((GetAID() & 0x07ff) <= ass.GetRawGroupAIDEnd()))
-               {
-                 m_statSlotStart = MicroSeconds((500 + m_slotDurationCount * 120)*statRawSlot+m_currentRAW_start);
-                 SetInRAWgroup ();
-                 m_currentslotDuration = m_slotDuration; //To support variable time duration among multiple RAWs
-
-                  // NS_LOG_UNCOND (Simulator::Now () << ", StaWifiMac:: GetAID() = " << GetAID() <<  ", m_statSlotStart=" << m_statSlotStart << ", m_lastRawDurationus = " << m_lastRawDurationus << ", m_currentslotDuration = " << m_currentslotDuration);
-                  //break; //break should not used if multiple RAW is supported
-               }
-               //NS_LOG_UNCOND (Simulator::Now () << ", StaWifiMac:: GetAID() = " << GetAID() << ", raw_start =" << raw_start << ", raw_end=" << raw_end << ", m_statSlotStart=" << m_statSlotStart << ", m_lastRawDurationus = " << m_lastRawDurationus << ", m_currentslotDuration = " << m_currentslotDuration);
-           }
-      }
          m_rawStart = true; //?
          if (this->IsAssociated())
                 S1gTIMReceived(beacon);
@@ -1613,64 +1652,7 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
             }
           if (assocResp.GetStatusCode ().IsSuccess ())
             {
-        	  SetAID (assocResp.GetAID ());
-              SetState (ASSOCIATED);
-	      NS_LOG_DEBUG("[" << this->GetAddress() <<"] is associated and has AID = " << this->GetAID());
-              SupportedRates rates = assocResp.GetSupportedRates ();
-              if (m_htSupported)
-                {
-                  HtCapabilities htcapabilities = assocResp.GetHtCapabilities ();
-                  m_stationManager->AddStationHtCapabilities (hdr->GetAddr2 (),htcapabilities);
-                }
-              
-              if (m_s1gSupported)
-                {
-                  S1gCapabilities s1gcapabilities = assocResp.GetS1gCapabilities ();
-                  NS_LOG_UNCOND (GetAddress () << ", receive " << uint16_t( s1gcapabilities.GetChannelWidth ()));
-                  m_stationManager->AddStationS1gCapabilities (hdr->GetAddr2 (),s1gcapabilities);
-                }
-
-              for (uint32_t i = 0; i < m_phy->GetNModes (); i++)
-                {
-                  WifiMode mode = m_phy->GetMode (i);
-                  for (uint32_t j = 0; j < m_phy->m_deviceRateSet.size (); j++)
-                   {
-                    if (m_phy->m_deviceRateSet[j] == mode )
-                    {
-                       NS_LOG_UNCOND (GetAddress () << ", AddSupportedMode " << hdr->GetAddr2 () << ", " << mode);                        
-                        m_stationManager->AddSupportedMode (hdr->GetAddr2 (), mode);
-                        if (rates.IsBasicRate (mode.GetDataRate ()))
-                        {
-                            m_stationManager->AddBasicMode (mode);
-                        }
-                    }
-                  }
-                  if (rates.IsSupportedRate (mode.GetDataRate ()))
-                    {
-                      m_stationManager->AddSupportedMode (hdr->GetAddr2 (), mode);
-                      if (rates.IsBasicRate (mode.GetDataRate ()))
-                        {
-                          m_stationManager->AddBasicMode (mode);
-                        }
-                    }
-                }
-              if (m_htSupported)
-                {
-                  HtCapabilities htcapabilities = assocResp.GetHtCapabilities ();
-                  for (uint32_t i = 0; i < m_phy->GetNMcs (); i++)
-                    {
-                      uint8_t mcs = m_phy->GetMcs (i);
-                      if (htcapabilities.IsSupportedMcs (mcs))
-                        {
-                          m_stationManager->AddSupportedMcs (hdr->GetAddr2 (), mcs);
-                          //here should add a control to add basic MCS when it is implemented
-                        }
-                    }
-                }
-              if (!m_linkUp.IsNull ())
-                {
-                  m_linkUp ();
-                }
+              SetAssociated (hdr->GetAddr2 (), assocResp);
             }
           else
             {
@@ -31,10 +31,13 @@
 #include "s1g-capabilities.h"
 #include "ns3/traced-value.h"
 #include "extension-headers.h"
+#include "raw-schedule.h"
 
 namespace ns3  {
 
 class MgtAddBaRequestHeader;
+class MgtAssocRequestHeader;
+class MgtAssocResponseHeader;
 
 /**
  * \ingroup wifi
@@ -105,6 +108,21 @@ public:
    */
   uint32_t GetAID (void) const;
 
+  /**
+   * \return the association request this station sends to its AP
+   */
+  MgtAssocRequestHeader GetAssocRequest (void) const;
+  /**
+   * Become associated with an AP without exchanging the probe and
+   * association frames, as if the association response had been
+   * received. This is used to bootstrap large scenarios where the
+   * association itself is not studied.
+   *
+   * \param bssid the address of the AP
+   * \param assocResp the response of the AP to GetAssocRequest
+   */
+  void SetAssociated (Mac48Address bssid, const MgtAssocResponseHeader &assocResp);
+
     /*void SetPageSlicingSupported (uint8_t support);
     uint8_t GetPageSlicingSupported (void) const;*/
 private:
@@ -257,6 +275,7 @@ private:
   void GoToSleepCurrentTIM (S1gBeaconHeader beacon);
   void GoToSleep(Time  sleeptime); 
 
+  RawScheduleCache m_rawSchedules; //!< the schedules of the RPS elements of the last beacons
   Time m_lastRawDurationus;
   Time m_lastRawStart;
   Time m_rawDuration;
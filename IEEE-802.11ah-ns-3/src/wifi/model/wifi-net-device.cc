@@ -23,6 +23,7 @@
 #include "wifi-phy.h"
 #include "wifi-remote-station-manager.h"
 #include "wifi-channel.h"
+#include "wifi-mac-header.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
@@ -76,6 +77,16 @@ WifiNetDevice::WifiNetDevice ()
   : m_configComplete (false)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  // room for the header of a QoS data frame with four addresses, the
+  // LLC/SNAP header, and IPv4 and TCP headers without options. The
+  // headroom is process-wide: from now on every new Buffer, whichever
+  // module creates it, has at least this much room in front of its data.
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetDsFrom ();
+  hdr.SetDsTo ();
+  LlcSnapHeader llc;
+  Buffer::ReserveHeadroom (hdr.GetSize () + llc.GetSerializedSize () + IPV4_HEADER_SIZE + TCP_HEADER_SIZE);
 }
 
 WifiNetDevice::~WifiNetDevice ()
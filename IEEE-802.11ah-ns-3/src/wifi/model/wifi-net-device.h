@@ -128,6 +128,10 @@ protected:
 private:
   //This value conforms to the 802.11 specification
   static const uint16_t MAX_MSDU_SIZE = 2304;
+  //Sizes of the IPv4 header and of the TCP header without options,
+  //which the packets usually get above the device
+  static const uint16_t IPV4_HEADER_SIZE = 20;
+  static const uint16_t TCP_HEADER_SIZE = 20;
 
   /**
    * Set that the link is up. A link is always up in ad-hoc mode.
@@ -127,6 +127,19 @@ WifiPhy::~WifiPhy ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+WifiPhy::SetWakeUpTime (Time wakeUpTime)
+{
+  NS_LOG_FUNCTION (this << wakeUpTime);
+  m_wakeUpTime = wakeUpTime;
+}
+
+Time
+WifiPhy::GetWakeUpTime (void) const
+{
+  return m_wakeUpTime;
+}
+
 WifiMode
 WifiPhy::GetHTPlcpHeaderMode (WifiMode payloadMode, WifiPreamble preamble)
 {
@@ -816,11 +829,46 @@ else
   return duration;
 }
 
+uint64_t
+WifiPhy::GetTxDurationKey (uint32_t size, WifiTxVector txvector, WifiPreamble preamble, double frequency)
+{
+  //the bandwidth is a property of the mode, and the frequency only
+  //matters for the signal extension at 2.4 GHz
+  NS_ASSERT (txvector.GetMode ().GetUid () < 0x10000);
+  uint64_t key = size;
+  key = (key << 16) | txvector.GetMode ().GetUid ();
+  key = (key << 4) | (preamble & 0xf);
+  key = (key << 4) | (txvector.GetNss () & 0xf);
+  key = (key << 2) | (txvector.GetNess () & 0x3);
+  key = (key << 1) | (txvector.IsStbc () ? 1 : 0);
+  key = (key << 1) | (txvector.IsShortGuardInterval () ? 1 : 0);
+  key = (key << 1) | ((frequency >= 2400 && frequency <= 2500) ? 1 : 0);
+  return key;
+}
+
 Time
 WifiPhy::CalculateTxDuration (uint32_t size, WifiTxVector txvector, WifiPreamble preamble, double frequency, uint8_t packetType, uint8_t incFlag)
 {
+  if (packetType != 0)
+    {
+      //the MPDUs of an A-MPDU depend on, and may update, m_totalAmpdu*
+      return CalculatePlcpPreambleAndHeaderDuration (txvector, preamble)
+             + GetPayloadDuration (size, txvector, preamble, frequency, packetType, incFlag);
+    }
+  uint64_t key = GetTxDurationKey (size, txvector, preamble, frequency);
+  TxDurationCache::const_iterator it = m_txDurationCache.find (key);
+  if (it != m_txDurationCache.end ())
+    {
+      return it->second;
+    }
   Time duration = CalculatePlcpPreambleAndHeaderDuration (txvector, preamble)
     + GetPayloadDuration (size, txvector, preamble, frequency, packetType, incFlag);
+  if (m_txDurationCache.size () >= 16384)
+    {
+      //keep the cache bounded when the packet sizes vary a lot
+      m_txDurationCache.clear ();
+    }
+  m_txDurationCache[key] = duration;
   return duration;
 }
 
@@ -33,6 +33,7 @@
 #include "ns3/traced-callback.h"
 #include "wifi-tx-vector.h"
 #include "drop-reason.h"
+#include "ns3/sgi-hashmap.h"
 
 namespace ns3 {
 
@@ -241,6 +242,19 @@ public:
    * Resume from sleep mode.
    */
   virtual void ResumeFromSleep (void) = 0;
+  /**
+   * Record when the MAC will resume this PHY from the sleep mode it is
+   * entering, so that the channel can skip the frames which start and
+   * end before then. Forgotten by ResumeFromSleep.
+   *
+   * \param wakeUpTime the absolute time of the wake up
+   */
+  void SetWakeUpTime (Time wakeUpTime);
+  /**
+   * \return the time recorded by SetWakeUpTime, or zero if the MAC
+   *         did not tell when it resumes this PHY
+   */
+  Time GetWakeUpTime (void) const;
 
   /**
    * \return true of the current state of the PHY layer is WifiPhy::IDLE, false otherwise.
@@ -1883,6 +1897,40 @@ private:
    */
   TracedCallback<Ptr<const Packet>, uint16_t, uint16_t, uint32_t, bool, WifiTxVector> m_phyMonitorSniffTxTrace;
 
+  /**
+   * \param size the number of bytes in the packet to send
+   * \param txvector the transmission parameters used for this packet
+   * \param preamble the type of preamble to use for this packet
+   * \param frequency the channel center frequency (MHz)
+   *
+   * \return the key of the duration of a packet which is not part of
+   *         an A-MPDU in m_txDurationCache
+   */
+  static uint64_t GetTxDurationKey (uint32_t size, WifiTxVector txvector, WifiPreamble preamble, double frequency);
+
+  /// Hash function of the keys of the transmission duration cache
+  struct TxDurationKeyHash
+  {
+    /**
+     * \param key the key to hash
+     * \return the hash of the key
+     */
+    size_t operator () (uint64_t key) const
+    {
+      return static_cast<size_t> (key ^ (key >> 32));
+    }
+  };
+
+  /**
+   * Durations of the packets which are not part of an A-MPDU, indexed by
+   * GetTxDurationKey. They only depend on the key, unlike the durations of
+   * the MPDUs of an A-MPDU, which depend on the previous MPDUs and are
+   * never cached.
+   */
+  typedef sgi::hash_map<uint64_t, Time, TxDurationKeyHash> TxDurationCache;
+
+  TxDurationCache m_txDurationCache; //!< Transmission duration cache
+  Time m_wakeUpTime;               //!< The time at which the MAC resumes this PHY from sleep, if known
   uint32_t m_totalAmpduNumSymbols; //!< Number of symbols previously transmitted for the MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
   uint32_t m_totalAmpduSize;       //!< Total size of the previously transmitted MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
 };
@@ -25,11 +25,14 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
 #include "ns3/object-factory.h"
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+#include <cmath>
 
 namespace ns3 {
 
@@ -52,6 +55,20 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("SkipSleepingPhys",
+                   "Do not deliver a frame to a sleeping PHY which the MAC resumes only after the end of the frame. "
+                   "The frame would be dropped anyway, but the PhyRxDrop trace does not report it, the propagation "
+                   "loss model is not evaluated for it, and a PHY resumed earlier than announced misses it as noise.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiChannel::m_skipSleepingPhys),
+                   MakeBooleanChecker ())
+    .AddAttribute ("AdjacentChannelInterference",
+                   "Deliver the frames of an S1G PHY as noise to the S1G PHYs tuned to another channel, "
+                   "attenuated by the transmit spectrum mask and the RF filter of the receiver. "
+                   "Otherwise the PHYs on other channels do not see the frame at all.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiChannel::m_adjacentChannelInterference),
+                   MakeBooleanChecker ())
 	.AddTraceSource("Transmission", "Fired when something is transmitted on the channel",
 				   MakeTraceSourceAccessor(&YansWifiChannel::m_channelTransmission), "ns3::YansWifiChannel::TransmissionCallback")
   ;
@@ -59,6 +76,10 @@ YansWifiChannel::GetTypeId (void)
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_skipSleepingPhys (false),
+    m_adjacentChannelInterference (false),
+    m_channelPhysValid (false),
+    m_visitedPhys (0)
 {
 }
 
@@ -84,29 +105,70 @@ void
 YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm,
                        WifiTxVector txVector, WifiPreamble preamble, uint8_t packetType, Time duration) const
 {
+  if (!IsLocal (sender))
+    {
+      //the process simulating the sender does the transmission
+      return;
+    }
   Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
   NS_ASSERT (senderMobility != 0);
-  uint32_t j = 0;
 
   m_channelTransmission(sender->GetDevice(), packet->Copy());
 
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++, j++)
+  // without adjacent channel interference, only the PHYs on the channel
+  // of the sender can see the frame
+  const std::vector<uint32_t> *receivers = 0;
+  if (!m_adjacentChannelInterference)
+    {
+      receivers = &GetPhysOnChannel (sender->GetChannelNumber ());
+    }
+  uint32_t n = receivers != 0 ? receivers->size () : m_phyList.size ();
+
+  for (uint32_t k = 0; k < n; k++)
     {
-      if (sender != (*i))
+      uint32_t j = receivers != 0 ? (*receivers)[k] : k;
+      Ptr<YansWifiPhy> receiver = m_phyList[j];
+      if (sender != receiver)
         {
-          //For now don't account for inter channel interference
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
+          m_visitedPhys++;
+          double rejection = 1;
+          if (receiver->GetChannelNumber () != sender->GetChannelNumber ())
             {
-              continue;
+              rejection = GetAdjacentChannelRejection (sender, receiver);
+              if (rejection == 0)
+                {
+                  continue;
+                }
             }
 
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
+          Ptr<MobilityModel> receiverMobility = receiver->GetMobility ()->GetObject<MobilityModel> ();
           Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+          //only the process simulating a receiver knows when it wakes up
+          bool local = IsLocal (receiver);
+          if (local && IsAsleepDuring (receiver, delay + duration))
+            {
+              continue;
+            }
           double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
           NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
                         "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<Object> dstNetDevice = m_phyList[j]->GetDevice ();
+
+          RxParams params;
+          params.rxPowerDbm = rxPowerDbm;
+          params.packetType = packetType;
+          params.duration = duration;
+          if (rejection < 1)
+            {
+              params.rxPowerDbm += 10 * std::log10 (rejection);
+            }
+
+          if (!local)
+            {
+              SendRemote (j, packet, delay, params, txVector, preamble, rejection < 1);
+              continue;
+            }
+
+          Ptr<Object> dstNetDevice = receiver->GetDevice ();
           uint32_t dstNode;
           if (dstNetDevice == 0)
             {
@@ -117,24 +179,108 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
               dstNode = dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
             }
 
-          double *atts = new double[3];
-          *atts = rxPowerDbm;
-          *(atts + 1) = packetType;
-          *(atts + 2) = duration.GetNanoSeconds ();
-
+          if (rejection < 1)
+            {
+              Simulator::ScheduleWithContext (dstNode,
+                                              delay, &YansWifiChannel::ReceiveInterference, this,
+                                              j, params, txVector, preamble);
+              continue;
+            }
+          Ptr<Packet> copy = packet->Copy ();
           Simulator::ScheduleWithContext (dstNode,
                                           delay, &YansWifiChannel::Receive, this,
-                                          j, copy, atts, txVector, preamble);
+                                          j, copy, params, txVector, preamble);
         }
     }
 }
 
 void
-YansWifiChannel::Receive (uint32_t i, Ptr<Packet> packet, double *atts,
+YansWifiChannel::Receive (uint32_t i, Ptr<Packet> packet, RxParams params,
                           WifiTxVector txVector, WifiPreamble preamble) const
 {
-  m_phyList[i]->StartReceivePreambleAndHeader (packet, *atts, txVector, preamble, *(atts + 1), NanoSeconds (*(atts + 2)));
-  delete[] atts;
+  m_phyList[i]->StartReceivePreambleAndHeader (packet, params.rxPowerDbm, txVector, preamble, params.packetType, params.duration);
+}
+
+void
+YansWifiChannel::ReceiveInterference (uint32_t i, RxParams params,
+                                      WifiTxVector txVector, WifiPreamble preamble) const
+{
+  m_phyList[i]->StartReceiveInterference (params.rxPowerDbm, txVector, preamble, params.duration);
+}
+
+bool
+YansWifiChannel::IsLocal (Ptr<YansWifiPhy> phy) const
+{
+  return true;
+}
+
+void
+YansWifiChannel::SendRemote (uint32_t i, Ptr<const Packet> packet, Time delay, RxParams params,
+                             WifiTxVector txVector, WifiPreamble preamble, bool interference) const
+{
+  NS_FATAL_ERROR ("All the PHYs of a YansWifiChannel are local");
+}
+
+double
+YansWifiChannel::GetAdjacentChannelRejection (Ptr<YansWifiPhy> sender, Ptr<YansWifiPhy> receiver) const
+{
+  if (!m_adjacentChannelInterference)
+    {
+      return 0;
+    }
+  uint32_t txChannel = sender->GetChannelNumber ();
+  uint32_t txWidth = sender->GetChannelWidth ();
+  uint32_t rxChannel = receiver->GetChannelNumber ();
+  uint32_t rxWidth = receiver->GetChannelWidth ();
+  if (txChannel < 1 || txChannel > 51 || !IsS1gWidth (txWidth)
+      || rxChannel < 1 || rxChannel > 51 || !IsS1gWidth (rxWidth))
+    {
+      // the 5 and 10 MHz 802.11a PHYs also use small channel numbers
+      return 0;
+    }
+
+  uint32_t key = txChannel | (txWidth << 8) | (rxChannel << 16) | (rxWidth << 24);
+  std::map<uint32_t, double>::const_iterator it = m_rejections.find (key);
+  if (it != m_rejections.end ())
+    {
+      return it->second;
+    }
+  Ptr<SpectrumValue> txPsd = WifiSpectrumValueS1gFactory (txWidth).CreateTxPowerSpectralDensity (1, txChannel);
+  Ptr<SpectrumValue> rxFilter = WifiSpectrumValueS1gFactory (rxWidth).CreateRfFilter (rxChannel);
+  double rejection = Integral ((*txPsd) * (*rxFilter)) / Integral (*txPsd);
+  NS_LOG_DEBUG ("rejection from channel " << txChannel << " (" << txWidth << " MHz) to channel "
+                << rxChannel << " (" << rxWidth << " MHz): " << 10 * std::log10 (rejection) << " dB");
+  m_rejections[key] = rejection;
+  return rejection;
+}
+
+bool
+YansWifiChannel::IsS1gWidth (uint32_t width)
+{
+  return width == 1 || width == 2 || width == 4 || width == 8 || width == 16;
+}
+
+const std::vector<uint32_t> &
+YansWifiChannel::GetPhysOnChannel (uint16_t channelNumber) const
+{
+  if (!m_channelPhysValid)
+    {
+      m_channelPhys.clear ();
+      for (uint32_t j = 0; j < m_phyList.size (); j++)
+        {
+          m_channelPhys[m_phyList[j]->GetChannelNumber ()].push_back (j);
+        }
+      m_channelPhysValid = true;
+    }
+  return m_channelPhys[channelNumber];
+}
+
+bool
+YansWifiChannel::IsAsleepDuring (Ptr<YansWifiPhy> phy, Time end) const
+{
+  return m_skipSleepingPhys
+         && phy->IsStateSleep ()
+         && phy->GetWakeUpTime () >= Simulator::Now () + end;
 }
 
 uint32_t
@@ -153,6 +299,19 @@ void
 YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
 {
   m_phyList.push_back (phy);
+  m_channelPhysValid = false;
+}
+
+void
+YansWifiChannel::NotifyChannelNumberChange (void)
+{
+  m_channelPhysValid = false;
+}
+
+uint64_t
+YansWifiChannel::GetNVisitedPhys (void) const
+{
+  return m_visitedPhys;
 }
 
 int64_t
@@ -22,6 +22,7 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include <vector>
+#include <map>
 #include <stdint.h>
 #include "ns3/packet.h"
 #include "wifi-channel.h"
@@ -70,6 +71,12 @@ public:
    * \param phy the YansWifiPhy to be added to the PHY list
    */
   void Add (Ptr<YansWifiPhy> phy);
+  /**
+   * Tell the channel that one of its PHYs was tuned to another channel
+   * number. The PHYs are sorted by channel number again before the next
+   * transmission.
+   */
+  void NotifyChannelNumberChange (void);
 
   /**
    * \param loss the new propagation loss model.
@@ -108,12 +115,30 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * \return the number of receivers the transmissions so far were
+   *         handed to, before the propagation and sleep checks. It
+   *         shows how much the sorting of the PHYs by channel number
+   *         saves over visiting every PHY of the channel.
+   */
+  uint64_t GetNVisitedPhys (void) const;
+
 
-private:
+protected:
   /**
    * A vector of pointers to YansWifiPhy.
    */
   typedef std::vector<Ptr<YansWifiPhy> > PhyList;
+  /**
+   * The parameters of a reception which do not fit in the arguments of
+   * a scheduled event. It is stored by value in the event.
+   */
+  struct RxParams
+  {
+    double rxPowerDbm;  //!< the received power in dBm
+    uint8_t packetType; //!< the packet type, see WifiPhy::CalculateTxDuration
+    Time duration;      //!< the duration of the packet
+  };
   /**
    * This method is scheduled by Send for each associated YansWifiPhy.
    * The method then calls the corresponding YansWifiPhy that the first
@@ -121,17 +146,98 @@ private:
    *
    * \param i index of the corresponding YansWifiPhy in the PHY list
    * \param packet the packet being sent
-   * \param atts a vector containing the received power in dBm and the packet type
+   * \param params the received power, the packet type and the duration
    * \param txVector the TXVECTOR of the packet
    * \param preamble the type of preamble being used to send the packet
    */
-  void Receive (uint32_t i, Ptr<Packet> packet, double *atts,
+  void Receive (uint32_t i, Ptr<Packet> packet, RxParams params,
                 WifiTxVector txVector, WifiPreamble preamble) const;
+  /**
+   * \param phy a receiver
+   * \param end the delay from now until the end of a frame at the receiver
+   *
+   * \return true if SkipSleepingPhys is set and the receiver sleeps until
+   *         the end of the frame, in which case it need not be delivered
+   */
+  bool IsAsleepDuring (Ptr<YansWifiPhy> phy, Time end) const;
+  /**
+   * This method is scheduled by Send for each YansWifiPhy tuned to an
+   * overlapping channel. The method adds the leaked power to the noise
+   * of the YansWifiPhy, which does not try to synchronize on it.
+   *
+   * \param i index of the corresponding YansWifiPhy in the PHY list
+   * \param params the leaked power, the packet type and the duration
+   * \param txVector the TXVECTOR of the packet
+   * \param preamble the type of preamble being used to send the packet
+   */
+  void ReceiveInterference (uint32_t i, RxParams params,
+                            WifiTxVector txVector, WifiPreamble preamble) const;
+  /**
+   * \param phy a PHY of the channel
+   *
+   * \return true if the PHY is simulated by this process. Send only
+   *         transmits the frames of local PHYs, and hands the frames for
+   *         the other PHYs to SendRemote. All the PHYs of a
+   *         YansWifiChannel are local.
+   */
+  virtual bool IsLocal (Ptr<YansWifiPhy> phy) const;
+  /**
+   * Called by Send instead of scheduling the reception for a receiver
+   * which is not local, once the received power and the propagation
+   * delay are known.
+   *
+   * \param i index of the receiver in the PHY list
+   * \param packet the packet being sent
+   * \param delay the propagation delay to the receiver
+   * \param params the received power, the packet type and the duration
+   * \param txVector the TXVECTOR of the packet
+   * \param preamble the type of preamble being used to send the packet
+   * \param interference whether the receiver is tuned to an overlapping
+   *        channel, so that the frame only adds to its noise
+   */
+  virtual void SendRemote (uint32_t i, Ptr<const Packet> packet, Time delay, RxParams params,
+                           WifiTxVector txVector, WifiPreamble preamble, bool interference) const;
+  /**
+   * \param sender the transmitter
+   * \param receiver a receiver tuned to another channel than the transmitter
+   *
+   * \return the fraction of the transmitted power which passes the RF
+   *         filter of the receiver, or zero if AdjacentChannelInterference
+   *         is not set or the PHYs do not both use S1G channels
+   */
+  double GetAdjacentChannelRejection (Ptr<YansWifiPhy> sender, Ptr<YansWifiPhy> receiver) const;
+  /**
+   * \param width a channel width in MHz
+   *
+   * \return true if the width is one of the S1G channel widths
+   */
+  static bool IsS1gWidth (uint32_t width);
+  /**
+   * \param channelNumber a channel number
+   *
+   * \return the indexes in the PHY list of the PHYs tuned to the
+   *         channel, in increasing order
+   */
+  const std::vector<uint32_t> & GetPhysOnChannel (uint16_t channelNumber) const;
 
 
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  bool m_skipSleepingPhys;             //!< Whether frames are not delivered to the PHYs asleep until their end
+  bool m_adjacentChannelInterference;  //!< Whether frames leak into the PHYs on overlapping S1G channels
+  /**
+   * The rejections computed so far, indexed by the channel numbers and
+   * widths of the transmitter and the receiver.
+   */
+  mutable std::map<uint32_t, double> m_rejections;
+  /**
+   * The indexes in m_phyList of the PHYs tuned to each channel number,
+   * so that a frame only visits the PHYs on its channel.
+   */
+  mutable std::map<uint16_t, std::vector<uint32_t> > m_channelPhys;
+  mutable bool m_channelPhysValid;     //!< Whether m_channelPhys matches the channel numbers of the PHYs
+  mutable uint64_t m_visitedPhys;      //!< The number of receivers visited by Send
 
   TracedCallback<Ptr<NetDevice>, Ptr<Packet>> m_channelTransmission;
 };
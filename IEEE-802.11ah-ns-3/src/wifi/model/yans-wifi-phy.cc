@@ -440,6 +440,10 @@ YansWifiPhy::SetChannelNumber (uint16_t nch)
       //this is not channel switch, this is initialization
       NS_LOG_DEBUG ("start at channel " << nch);
       m_channelNumber = nch;
+      if (m_channel != 0)
+        {
+          m_channel->NotifyChannelNumberChange ();
+        }
       return;
     }
 
@@ -483,6 +487,7 @@ switchChannel:
    * out the state of the medium after the switching.
    */
   m_channelNumber = nch;
+  m_channel->NotifyChannelNumberChange ();
 }
 
 uint16_t
@@ -553,6 +558,7 @@ YansWifiPhy::ResumeFromSleep (void)
     case YansWifiPhy::SLEEP:
       {
         NS_LOG_DEBUG ("resuming from sleep mode");
+        SetWakeUpTime (Seconds (0));
         Time delayUntilCcaEnd = m_interference.GetEnergyDuration (m_ccaMode1ThresholdW);
         m_state->SwitchFromSleep (delayUntilCcaEnd);
         break;
@@ -583,6 +589,17 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
                                             WifiTxVector txVector,
                                             enum WifiPreamble preamble,
                                             uint8_t packetType, Time rxDuration)
+{
+  StartReceivePreambleAndHeader (packet, rxPowerDbm, txVector, preamble, packetType, rxDuration, Simulator::Now ());
+}
+
+void
+YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
+                                            double rxPowerDbm,
+                                            WifiTxVector txVector,
+                                            enum WifiPreamble preamble,
+                                            uint8_t packetType, Time rxDuration,
+                                            Time rxStart)
 {
   //This function should be later split to check separately wether plcp preamble and plcp header can be successfully received.
   //Note: plcp preamble reception is not yet modeled.
@@ -591,15 +608,20 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
   AmpduTag ampduTag;
   rxPowerDbm += m_rxGainDb;
   double rxPowerW = DbmToW (rxPowerDbm);
-  Time endRx = Simulator::Now () + rxDuration;
+  Time endRx = rxStart + rxDuration;
   Time preambleAndHeaderDuration = CalculatePlcpPreambleAndHeaderDuration (txVector, preamble);
+  //the reception may start after the first bit of the packet arrived
+  Time remainingRxDuration = endRx - Simulator::Now ();
+  Time remainingPreambleAndHeaderDuration = Max (rxStart + preambleAndHeaderDuration - Simulator::Now (), Seconds (0));
+  NS_ASSERT (remainingRxDuration.IsStrictlyPositive ());
 
   Ptr<InterferenceHelper::Event> event;
   event = m_interference.Add (packet->GetSize (),
                               txVector,
                               preamble,
                               rxDuration,
-                              rxPowerW);
+                              rxPowerW,
+                              rxStart);
 
   switch (m_state->GetState ())
     {
@@ -689,7 +711,7 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
 
           NS_LOG_DEBUG ("sync to signal (power=" << rxPowerW << "W)");
           //sync to signal
-          m_state->SwitchToRx (rxDuration);
+          m_state->SwitchToRx (remainingRxDuration);
           NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
           NotifyRxBegin (packet);
           m_interference.NotifyRxStart ();
@@ -697,12 +719,12 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
           if (preamble != WIFI_PREAMBLE_NONE)
             {
               NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
-              m_endPlcpRxEvent = Simulator::Schedule (preambleAndHeaderDuration, &YansWifiPhy::StartReceivePacket, this,
+              m_endPlcpRxEvent = Simulator::Schedule (remainingPreambleAndHeaderDuration, &YansWifiPhy::StartReceivePacket, this,
                                                       packet, txVector, preamble, packetType, event);
             }
 
           NS_ASSERT (m_endRxEvent.IsExpired ());
-          m_endRxEvent = Simulator::Schedule (rxDuration, &YansWifiPhy::EndReceive, this,
+          m_endRxEvent = Simulator::Schedule (remainingRxDuration, &YansWifiPhy::EndReceive, this,
                                               packet, preamble, packetType, event);
         }
       else
@@ -738,6 +760,35 @@ maybeCcaBusy:
     }
 }
 
+void
+YansWifiPhy::StartReceiveInterference (double rxPowerDbm,
+                                       WifiTxVector txVector,
+                                       enum WifiPreamble preamble,
+                                       Time rxDuration)
+{
+  StartReceiveInterference (rxPowerDbm, txVector, preamble, rxDuration, Simulator::Now ());
+}
+
+void
+YansWifiPhy::StartReceiveInterference (double rxPowerDbm,
+                                       WifiTxVector txVector,
+                                       enum WifiPreamble preamble,
+                                       Time rxDuration, Time rxStart)
+{
+  NS_LOG_FUNCTION (this << rxPowerDbm << txVector.GetMode () << preamble << rxDuration << rxStart);
+  rxPowerDbm += m_rxGainDb;
+  m_interference.Add (0, txVector, preamble, rxDuration, DbmToW (rxPowerDbm), rxStart);
+  if (m_state->IsStateSleep ())
+    {
+      return;
+    }
+  Time delayUntilCcaEnd = m_interference.GetEnergyDuration (m_ccaMode1ThresholdW);
+  if (!delayUntilCcaEnd.IsZero ())
+    {
+      m_state->SwitchMaybeToCcaBusy (delayUntilCcaEnd);
+    }
+}
+
 void
 YansWifiPhy::StartReceivePacket (Ptr<Packet> packet,
                                  WifiTxVector txVector,
@@ -1419,7 +1470,8 @@ YansWifiPhy::GetS1gLongfield (void) const
 void
 YansWifiPhy::SetChannelWidth(uint32_t channelwidth)
 {
-    NS_ASSERT_MSG (channelwidth == 1 || channelwidth == 2 || channelwidth == 4| channelwidth == 8| channelwidth ==16|| channelwidth == 20 || channelwidth == 40 || channelwidth == 80 || channelwidth == 160, "wrong channel width value");
+    NS_ASSERT_MSG (channelwidth == 1 || channelwidth == 2 || channelwidth == 4 || channelwidth == 8 || channelwidth == 16
+                   || channelwidth == 5 || channelwidth == 10 || channelwidth == 20 || channelwidth == 40 || channelwidth == 80 || channelwidth == 160, "wrong channel width value");
     m_channelWidth = channelwidth;
 }
 
@@ -115,6 +115,56 @@ public:
                                       WifiPreamble preamble,
                                       uint8_t packetType,
                                       Time rxDuration);
+  /**
+   * Starting receiving the plcp of a packet whose first bit arrived at
+   * \p rxStart, e.g. a packet detected only after part of its preamble
+   * was received. The interference and the end of the reception are
+   * computed from \p rxStart.
+   *
+   * \param packet the arriving packet
+   * \param rxPowerDbm the receive power in dBm
+   * \param txVector the TXVECTOR of the arriving packet
+   * \param preamble the preamble of the arriving packet
+   * \param packetType The type of the received packet (values: 0 not an A-MPDU, 1 corresponds to any packets in an A-MPDU except the last one, 2 is the last packet in an A-MPDU)
+   * \param rxDuration the duration needed for the reception of the packet
+   * \param rxStart the arrival time of the first bit of the packet, not after now
+   */
+  void StartReceivePreambleAndHeader (Ptr<Packet> packet,
+                                      double rxPowerDbm,
+                                      WifiTxVector txVector,
+                                      WifiPreamble preamble,
+                                      uint8_t packetType,
+                                      Time rxDuration,
+                                      Time rxStart);
+  /**
+   * The first bit of a signal this PHY cannot synchronize on has arrived,
+   * e.g. the leakage of a frame sent on an adjacent channel. The signal
+   * only adds to the noise and may make CCA busy.
+   *
+   * \param rxPowerDbm the receive power in dBm
+   * \param txVector the TXVECTOR of the signal
+   * \param preamble the preamble of the signal
+   * \param rxDuration the duration of the signal
+   */
+  void StartReceiveInterference (double rxPowerDbm,
+                                 WifiTxVector txVector,
+                                 WifiPreamble preamble,
+                                 Time rxDuration);
+  /**
+   * The first bit of a signal this PHY cannot synchronize on arrived at
+   * \p rxStart.
+   *
+   * \param rxPowerDbm the receive power in dBm
+   * \param txVector the TXVECTOR of the signal
+   * \param preamble the preamble of the signal
+   * \param rxDuration the duration of the signal
+   * \param rxStart the arrival time of the first bit of the signal, not after now
+   */
+  void StartReceiveInterference (double rxPowerDbm,
+                                 WifiTxVector txVector,
+                                 WifiPreamble preamble,
+                                 Time rxDuration,
+                                 Time rxStart);
   /**
    * Starting receiving the payload of a packet (i.e. the first bit of the packet has arrived).
    *
@@ -0,0 +1,309 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include <algorithm>
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/mobility-model.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/mpi-receiver.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "yans-wifi-remote-channel.h"
+#include "yans-wifi-phy.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("YansWifiRemoteChannel");
+
+NS_OBJECT_ENSURE_REGISTERED (YansWifiRemoteHeader);
+NS_OBJECT_ENSURE_REGISTERED (YansWifiRemoteChannel);
+
+YansWifiRemoteHeader::YansWifiRemoteHeader ()
+  : m_phyIndex (0),
+    m_rxPowerDbm (0),
+    m_packetType (0),
+    m_interference (false),
+    m_preamble (WIFI_PREAMBLE_LONG)
+{
+}
+
+TypeId
+YansWifiRemoteHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::YansWifiRemoteHeader")
+    .SetParent<Header> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<YansWifiRemoteHeader> ()
+  ;
+  return tid;
+}
+
+TypeId
+YansWifiRemoteHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+void
+YansWifiRemoteHeader::Print (std::ostream &os) const
+{
+  os << "phy=" << m_phyIndex
+     << ", rxPower=" << m_rxPowerDbm << "dbm"
+     << ", type=" << (uint16_t) m_packetType
+     << ", interference=" << m_interference
+     << ", start=" << m_start
+     << ", duration=" << m_duration
+     << ", preamble=" << m_preamble
+     << ", txVector=" << m_txVector;
+}
+
+uint32_t
+YansWifiRemoteHeader::GetSerializedSize (void) const
+{
+  return 4 + 8 + 1 + 1 + 8 + 8 + 1
+         + 1 + m_txVector.GetMode ().GetUniqueName ().size ()
+         + 6;
+}
+
+void
+YansWifiRemoteHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+  uint64_t power;
+  std::memcpy (&power, &m_rxPowerDbm, sizeof (power));
+  i.WriteHtonU32 (m_phyIndex);
+  i.WriteHtonU64 (power);
+  i.WriteU8 (m_packetType);
+  i.WriteU8 (m_interference);
+  i.WriteHtonU64 (m_start.GetTimeStep ());
+  i.WriteHtonU64 (m_duration.GetTimeStep ());
+  i.WriteU8 (m_preamble);
+  std::string mode = m_txVector.GetMode ().GetUniqueName ();
+  i.WriteU8 (mode.size ());
+  i.Write (reinterpret_cast<const uint8_t *> (mode.c_str ()), mode.size ());
+  i.WriteU8 (m_txVector.GetTxPowerLevel ());
+  i.WriteU8 (m_txVector.GetRetries ());
+  i.WriteU8 (m_txVector.IsShortGuardInterval ());
+  i.WriteU8 (m_txVector.GetNss ());
+  i.WriteU8 (m_txVector.GetNess ());
+  i.WriteU8 (m_txVector.IsStbc ());
+}
+
+uint32_t
+YansWifiRemoteHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  m_phyIndex = i.ReadNtohU32 ();
+  uint64_t power = i.ReadNtohU64 ();
+  std::memcpy (&m_rxPowerDbm, &power, sizeof (power));
+  m_packetType = i.ReadU8 ();
+  m_interference = i.ReadU8 ();
+  m_start = TimeStep (i.ReadNtohU64 ());
+  m_duration = TimeStep (i.ReadNtohU64 ());
+  m_preamble = static_cast<WifiPreamble> (i.ReadU8 ());
+  uint8_t length = i.ReadU8 ();
+  std::string mode (length, ' ');
+  for (uint8_t j = 0; j < length; j++)
+    {
+      mode[j] = i.ReadU8 ();
+    }
+  m_txVector.SetMode (WifiMode (mode));
+  m_txVector.SetTxPowerLevel (i.ReadU8 ());
+  m_txVector.SetRetries (i.ReadU8 ());
+  m_txVector.SetShortGuardInterval (i.ReadU8 ());
+  m_txVector.SetNss (i.ReadU8 ());
+  m_txVector.SetNess (i.ReadU8 ());
+  m_txVector.SetStbc (i.ReadU8 ());
+  return i.GetDistanceFrom (start);
+}
+
+TypeId
+YansWifiRemoteChannel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::YansWifiRemoteChannel")
+    .SetParent<YansWifiChannel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<YansWifiRemoteChannel> ()
+    .AddAttribute ("PreambleDetectionTime",
+                   "Delay after the arrival of its first bit before a PHY on another "
+                   "MPI task starts receiving a frame. It is added to the lookahead.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&YansWifiRemoteChannel::m_preambleDetectionTime),
+                   MakeTimeChecker (Seconds (0)))
+  ;
+  return tid;
+}
+
+YansWifiRemoteChannel::YansWifiRemoteChannel ()
+  : m_setup (false)
+{
+}
+
+YansWifiRemoteChannel::~YansWifiRemoteChannel ()
+{
+}
+
+uint32_t
+YansWifiRemoteChannel::GetPhySystemId (Ptr<YansWifiPhy> phy) const
+{
+  Ptr<NetDevice> device = phy->GetDevice ();
+  if (device == 0)
+    {
+      return MpiInterface::GetSystemId ();
+    }
+  return device->GetNode ()->GetSystemId ();
+}
+
+bool
+YansWifiRemoteChannel::IsLocal (Ptr<YansWifiPhy> phy) const
+{
+  return GetPhySystemId (phy) == MpiInterface::GetSystemId ();
+}
+
+void
+YansWifiRemoteChannel::Setup (void) const
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t localSystemId = MpiInterface::GetSystemId ();
+  uint32_t systemCount = MpiInterface::GetSize ();
+  std::vector<uint32_t> systemIds (m_phyList.size ());
+  for (uint32_t i = 0; i < m_phyList.size (); i++)
+    {
+      systemIds[i] = GetPhySystemId (m_phyList[i]);
+      systemCount = std::max (systemCount, systemIds[i] + 1);
+    }
+  m_lookAhead.assign (systemCount, Seconds (-1));
+  for (uint32_t i = 0; i < m_phyList.size (); i++)
+    {
+      if (systemIds[i] != localSystemId)
+        {
+          continue;
+        }
+      Ptr<MobilityModel> localMobility = m_phyList[i]->GetMobility ()->GetObject<MobilityModel> ();
+      for (uint32_t j = 0; j < m_phyList.size (); j++)
+        {
+          if (systemIds[j] == localSystemId
+              || (!m_adjacentChannelInterference
+                  && m_phyList[j]->GetChannelNumber () != m_phyList[i]->GetChannelNumber ()))
+            {
+              continue;
+            }
+          Ptr<MobilityModel> remoteMobility = m_phyList[j]->GetMobility ()->GetObject<MobilityModel> ();
+          Time delay = m_delay->GetDelay (localMobility, remoteMobility) + m_preambleDetectionTime;
+          Time &lookAhead = m_lookAhead[systemIds[j]];
+          if (lookAhead.IsStrictlyNegative () || delay < lookAhead)
+            {
+              lookAhead = delay;
+            }
+        }
+
+      // frames mirrored by the other tasks are delivered to the device
+      Ptr<NetDevice> device = m_phyList[i]->GetDevice ();
+      if (device != 0 && device->GetObject<MpiReceiver> () == 0)
+        {
+          Ptr<MpiReceiver> mpiRec = CreateObject<MpiReceiver> ();
+          mpiRec->SetReceiveCallback (MakeCallback (&YansWifiRemoteChannel::ReceiveRemote,
+                                                    const_cast<YansWifiRemoteChannel *> (this)));
+          device->AggregateObject (mpiRec);
+        }
+    }
+  m_setup = true;
+}
+
+Time
+YansWifiRemoteChannel::GetRemoteLookAhead (uint32_t systemId) const
+{
+  if (!m_setup)
+    {
+      Setup ();
+    }
+  NS_ASSERT (systemId < m_lookAhead.size ());
+  return m_lookAhead[systemId];
+}
+
+void
+YansWifiRemoteChannel::SendRemote (uint32_t i, Ptr<const Packet> packet, Time delay, RxParams params,
+                                   WifiTxVector txVector, WifiPreamble preamble, bool interference) const
+{
+  Ptr<NetDevice> dstNetDevice = m_phyList[i]->GetDevice ();
+  Time lookAhead = GetRemoteLookAhead (GetPhySystemId (m_phyList[i]));
+  Time detection = delay + m_preambleDetectionTime;
+  if (detection < lookAhead)
+    {
+      //the nodes moved closer than they were at simulation start
+      NS_LOG_WARN ("remote reception delayed from " << detection << " to lookahead " << lookAhead);
+      detection = lookAhead;
+    }
+  YansWifiRemoteHeader header;
+  header.m_phyIndex = i;
+  header.m_rxPowerDbm = params.rxPowerDbm;
+  header.m_packetType = params.packetType;
+  header.m_interference = interference;
+  header.m_start = Simulator::Now () + delay;
+  header.m_duration = params.duration;
+  header.m_preamble = preamble;
+  header.m_txVector = txVector;
+  Ptr<Packet> copy = interference ? Create<Packet> () : packet->Copy ();
+  copy->AddHeader (header);
+  SendToTask (copy, Simulator::Now () + detection, dstNetDevice);
+}
+
+void
+YansWifiRemoteChannel::SendToTask (Ptr<Packet> packet, Time rxTime, Ptr<NetDevice> device) const
+{
+#ifdef NS3_MPI
+  MpiInterface::SendPacket (packet, rxTime, device->GetNode ()->GetId (), device->GetIfIndex ());
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
+
+void
+YansWifiRemoteChannel::ReceiveRemote (Ptr<Packet> packet)
+{
+  YansWifiRemoteHeader header;
+  packet->RemoveHeader (header);
+  NS_LOG_FUNCTION (this << packet << header);
+  NS_ASSERT (header.m_phyIndex < m_phyList.size ());
+  Ptr<YansWifiPhy> phy = m_phyList[header.m_phyIndex];
+  Time end = header.m_start + header.m_duration - Simulator::Now ();
+  if (!end.IsStrictlyPositive ())
+    {
+      NS_LOG_DEBUG ("frame over before its detection");
+      return;
+    }
+  if (IsAsleepDuring (phy, end))
+    {
+      return;
+    }
+  if (header.m_interference)
+    {
+      phy->StartReceiveInterference (header.m_rxPowerDbm, header.m_txVector, header.m_preamble,
+                                     header.m_duration, header.m_start);
+      return;
+    }
+  phy->StartReceivePreambleAndHeader (packet, header.m_rxPowerDbm, header.m_txVector,
+                                      header.m_preamble, header.m_packetType,
+                                      header.m_duration, header.m_start);
+}
+
+} //namespace ns3
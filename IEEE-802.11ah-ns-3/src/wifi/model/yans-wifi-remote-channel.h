@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef YANS_WIFI_REMOTE_CHANNEL_H
+#define YANS_WIFI_REMOTE_CHANNEL_H
+
+#include <vector>
+#include "yans-wifi-channel.h"
+#include "ns3/header.h"
+#include "ns3/mpi-remote-channel.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * Header prepended to a frame mirrored to another MPI task by
+ * YansWifiRemoteChannel. It carries everything the receiving PHY needs
+ * to start the reception, since those values are computed by the
+ * channel on the transmitting task.
+ */
+class YansWifiRemoteHeader : public Header
+{
+public:
+  YansWifiRemoteHeader ();
+
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual void Print (std::ostream &os) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+  uint32_t m_phyIndex;     //!< index of the receiving PHY in the channel PHY list
+  double m_rxPowerDbm;     //!< received power computed by the transmitting task
+  uint8_t m_packetType;    //!< A-MPDU packet type
+  bool m_interference;     //!< whether the frame only adds to the noise of the PHY
+  Time m_start;            //!< arrival time of the first bit of the frame at the PHY
+  Time m_duration;         //!< duration of the frame
+  WifiPreamble m_preamble; //!< preamble of the frame
+  WifiTxVector m_txVector; //!< TXVECTOR of the frame
+};
+
+/**
+ * \brief A Yans wifi channel whose PHYs may be distributed over several
+ * MPI tasks
+ * \ingroup wifi
+ *
+ * As with the other distributed channels, the full topology is created on
+ * every task. A transmission from a PHY of a local node is delivered
+ * locally to the other local PHYs exactly like YansWifiChannel does, and
+ * mirrored through MpiInterface::SendPacket to each PHY living on a
+ * remote task. The propagation loss and delay are evaluated on the
+ * transmitting task, so the remote task only starts the reception.
+ * PHYs of nodes owned by another task never transmit on the local task.
+ *
+ * The channel implements MpiRemoteChannel: the lookahead towards a task
+ * is the minimum propagation delay between a local PHY and a PHY of that
+ * task (computed from the positions at simulation start) plus the
+ * PreambleDetectionTime attribute. A remote PHY detects a frame that much
+ * later than its first bit arrives, i.e. once its preamble has been
+ * partially received, but the frame still occupies the medium of the PHY
+ * from the arrival of its first bit, as for a local PHY. The same query
+ * installs the MpiReceiver on every local device of the channel.
+ */
+class YansWifiRemoteChannel : public YansWifiChannel,
+                              public MpiRemoteChannel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  YansWifiRemoteChannel ();
+  virtual ~YansWifiRemoteChannel ();
+
+  //inherited from MpiRemoteChannel
+  virtual Time GetRemoteLookAhead (uint32_t systemId) const;
+
+
+protected:
+  /**
+   * Send a frame mirrored to a PHY of another task through
+   * MpiInterface::SendPacket.
+   *
+   * \param packet the frame, with its YansWifiRemoteHeader
+   * \param rxTime the time at which the other task receives the frame
+   * \param device the device of the receiving PHY
+   */
+  virtual void SendToTask (Ptr<Packet> packet, Time rxTime, Ptr<NetDevice> device) const;
+  /**
+   * Called by the MpiReceiver of a local device when a frame mirrored by
+   * another task arrives.
+   *
+   * \param packet the frame, with its YansWifiRemoteHeader
+   */
+  void ReceiveRemote (Ptr<Packet> packet);
+
+
+private:
+  //inherited from YansWifiChannel
+  virtual bool IsLocal (Ptr<YansWifiPhy> phy) const;
+  virtual void SendRemote (uint32_t i, Ptr<const Packet> packet, Time delay, RxParams params,
+                           WifiTxVector txVector, WifiPreamble preamble, bool interference) const;
+
+  /**
+   * Compute the lookahead towards every task and connect the MPI
+   * receivers of the local devices. Done once, when the distributed
+   * simulator first asks for the lookahead.
+   */
+  void Setup (void) const;
+  /**
+   * \param phy a PHY of the channel
+   * \return the system id of the node owning the PHY
+   */
+  uint32_t GetPhySystemId (Ptr<YansWifiPhy> phy) const;
+
+  Time m_preambleDetectionTime;           //!< delay before a remote PHY detects a frame
+  mutable bool m_setup;                   //!< whether Setup has run
+  mutable std::vector<Time> m_lookAhead;  //!< lookahead per system id, negative if unreachable
+};
+
+} //namespace ns3
+
+#endif /* YANS_WIFI_REMOTE_CHANNEL_H */
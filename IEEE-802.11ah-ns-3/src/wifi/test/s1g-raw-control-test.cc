@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/s1g-raw-control.h"
+#include "ns3/raw-schedule.h"
+
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the station bookkeeping and the log files of the dynamic
+ * RAW controller over a few beacons.
+ */
+class S1gRawCtrTest : public TestCase
+{
+public:
+  S1gRawCtrTest ();
+  virtual void DoRun (void);
+};
+
+S1gRawCtrTest::S1gRawCtrTest ()
+  : TestCase ("Dynamic RAW controller station tables")
+{
+}
+
+void
+S1gRawCtrTest::DoRun (void)
+{
+  std::string path = CreateTempDirFilename ("raw-");
+  std::vector<uint16_t> sensors;
+  sensors.push_back (1);
+  sensors.push_back (2);
+  sensors.push_back (3);
+  std::vector<uint16_t> offload;
+  std::vector<uint16_t> received;
+  {
+    S1gRawCtr ctr;
+    ctr.UpdateRAWGroupping (sensors, offload, received, 102400, path);
+    NS_TEST_ASSERT_MSG_EQ (ctr.m_stations.size (), 3, "One estimator per sensor expected");
+    NS_TEST_ASSERT_MSG_EQ (ctr.m_aidList.size (), 3, "All the sensors should be allowed to send");
+    NS_TEST_ASSERT_MSG_EQ (ctr.LookupSensorSta (2)->GetAid (), 2, "Wrong sensor found");
+    NS_TEST_ASSERT_MSG_EQ (ctr.LookupSensorSta (4), 0, "Unknown sensor found");
+    NS_TEST_ASSERT_MSG_EQ (ctr.LookupOffloadSta (2), 0, "A sensor is not an offload station");
+
+    received.push_back (1);
+    received.push_back (1);
+    received.push_back (2);
+    ctr.UpdateRAWGroupping (sensors, offload, received, 102400, path);
+    NS_TEST_EXPECT_MSG_EQ (ctr.LookupSensorSta (1)->GetNumPacketsReceived (), 2, "Wrong number of packets");
+    NS_TEST_EXPECT_MSG_EQ (ctr.LookupSensorSta (2)->GetNumPacketsReceived (), 1, "Wrong number of packets");
+    NS_TEST_EXPECT_MSG_EQ (ctr.LookupSensorSta (3)->GetNumPacketsReceived (), 0, "Wrong number of packets");
+    NS_TEST_EXPECT_MSG_EQ (ctr.LookupSensorSta (3)->GetTransmissionSuccess (), false, "Sensor 3 sent nothing");
+
+    sensors.pop_back ();
+    received.clear ();
+    ctr.UpdateRAWGroupping (sensors, offload, received, 102400, path);
+    NS_TEST_ASSERT_MSG_EQ (ctr.m_stations.size (), 2, "The disassociated sensor is still there");
+    NS_TEST_ASSERT_MSG_EQ (ctr.LookupSensorSta (3), 0, "The disassociated sensor is still there");
+    NS_TEST_ASSERT_MSG_EQ (ctr.m_lastTransmissionList.size (), 2, "The disassociated sensor is still queued");
+  }
+
+  // the buffered lines are written when the controller is destroyed
+  std::ifstream file ((path + "1.txt").c_str ());
+  NS_TEST_ASSERT_MSG_EQ (file.is_open (), true, "The file of sensor 1 was not created");
+  std::ostringstream content;
+  content << file.rdbuf ();
+  NS_TEST_EXPECT_MSG_EQ (content.str (), "2\t1\t2\t1\n", "Unexpected content of the file of sensor 1");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the slot boundaries decoded from an RPS element.
+ */
+class RawScheduleTest : public TestCase
+{
+public:
+  RawScheduleTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Add a RAW group to an RPS element.
+   *
+   * \param rps the RPS element
+   * \param aidStart the first AID of the group
+   * \param aidEnd the last AID of the group
+   * \param slotDurationCount the slot duration count of the group
+   * \param slotNum the number of slots of the group
+   */
+  void AddRaw (RPS &rps, uint16_t aidStart, uint16_t aidEnd, uint16_t slotDurationCount, uint16_t slotNum);
+};
+
+RawScheduleTest::RawScheduleTest ()
+  : TestCase ("RAW slot schedule")
+{
+}
+
+void
+RawScheduleTest::AddRaw (RPS &rps, uint16_t aidStart, uint16_t aidEnd, uint16_t slotDurationCount, uint16_t slotNum)
+{
+  RPS::RawAssignment raw;
+  raw.SetRawControl (0);
+  raw.SetSlotCrossBoundary (1);
+  raw.SetSlotFormat (1);
+  raw.SetSlotDurationCount (slotDurationCount);
+  raw.SetSlotNum (slotNum);
+  raw.SetRawGroup ((uint32_t (aidEnd) << 13) | (uint32_t (aidStart) << 2));
+  rps.SetRawAssignment (raw);
+}
+
+void
+RawScheduleTest::DoRun (void)
+{
+  RPS rps;
+  AddRaw (rps, 1, 10, 10, 4);   // 4 slots of 1700 us
+  AddRaw (rps, 11, 20, 20, 2);  // 2 slots of 2900 us
+
+  Ptr<const RawSchedule> schedule = RawSchedule::Get (rps);
+  NS_TEST_ASSERT_MSG_EQ (schedule->GetNRaws (), 2, "Wrong number of RAW groups");
+  NS_TEST_EXPECT_MSG_EQ (schedule->GetDuration (), MicroSeconds (4 * 1700 + 2 * 2900), "Wrong RAW duration");
+  NS_TEST_EXPECT_MSG_EQ (schedule->GetRawStart (1), MicroSeconds (4 * 1700), "Wrong start of the second group");
+  NS_TEST_EXPECT_MSG_EQ (schedule->GetSlotCrossBoundary (0), true, "Wrong cross slot boundary");
+
+  NS_TEST_EXPECT_MSG_EQ (schedule->GetRawIndex (0), -1, "AID 0 is in no group");
+  NS_TEST_EXPECT_MSG_EQ (schedule->GetRawIndex (7), 0, "AID 7 is in the first group");
+  NS_TEST_EXPECT_MSG_EQ (schedule->GetRawIndex (20), 1, "AID 20 is in the second group");
+  NS_TEST_EXPECT_MSG_EQ (schedule->GetRawIndex (21), -1, "AID 21 is in no group");
+  NS_TEST_EXPECT_MSG_EQ (schedule->GetRawIndex (2048 + 7), -1, "AID 2055 is in page 1");
+  NS_TEST_EXPECT_MSG_EQ (schedule->GetSlotStart (7), MicroSeconds (3 * 1700), "Wrong slot of AID 7");
+  NS_TEST_EXPECT_MSG_EQ (schedule->GetSlotStart (13), MicroSeconds (4 * 1700 + 2900), "Wrong slot of AID 13");
+
+  RawScheduleCache ap;
+  RawScheduleCache sta (1);
+  NS_TEST_EXPECT_MSG_EQ (ap.Get (rps), schedule, "The caches should share the schedule with its holders");
+  RPS same;
+  AddRaw (same, 1, 10, 10, 4);
+  AddRaw (same, 11, 20, 20, 2);
+  NS_TEST_EXPECT_MSG_EQ (sta.Get (same), schedule, "An RPS with the same content should share the schedule");
+  RPS other;
+  AddRaw (other, 1, 20, 10, 4);
+  Ptr<const RawSchedule> otherSchedule = sta.Get (other);
+  NS_TEST_EXPECT_MSG_NE (otherSchedule, schedule, "A different RPS should have its own schedule");
+  NS_TEST_EXPECT_MSG_EQ (otherSchedule->GetRawIndex (13), 0, "AID 13 is in the only group");
+  NS_TEST_EXPECT_MSG_EQ (ap.Get (other), otherSchedule, "The evicted schedule should still be shared");
+  NS_TEST_EXPECT_MSG_EQ (sta.Get (same), schedule, "The schedule held by the AP should be shared again");
+
+  RPS noSlot;
+  AddRaw (noSlot, 1, 10, 10, 0);
+  NS_TEST_EXPECT_MSG_EQ (sta.Get (noSlot)->GetSlotStart (7), MicroSeconds (0), "A group without slots starts at its start");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Dynamic RAW controller TestSuite
+ */
+class S1gRawCtrTestSuite : public TestSuite
+{
+public:
+  S1gRawCtrTestSuite ();
+};
+
+S1gRawCtrTestSuite::S1gRawCtrTestSuite ()
+  : TestSuite ("wifi-s1g-raw-control", UNIT)
+{
+  AddTestCase (new S1gRawCtrTest, TestCase::QUICK);
+  AddTestCase (new RawScheduleTest, TestCase::QUICK);
+}
+
+static S1gRawCtrTestSuite g_s1gRawCtrTestSuite; ///< the test suite
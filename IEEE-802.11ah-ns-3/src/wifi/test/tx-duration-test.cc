@@ -278,6 +278,105 @@ TxDurationTest::DoRun (void)
 }
 
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the durations memoized by WifiPhy::CalculateTxDuration
+ * are the ones computed from scratch, and that the A-MPDU bookkeeping is
+ * not affected by the cache.
+ */
+class TxDurationCacheTest : public TestCase
+{
+public:
+  TxDurationCacheTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \param phy the PHY to compute the duration with
+   * \param size size of payload in octets
+   * \param txVector the transmission parameters
+   * \param preamble the WifiPreamble used
+   * \param frequency the channel center frequency (MHz)
+   *
+   * \return the duration computed without the cache
+   */
+  static Time Compute (Ptr<WifiPhy> phy, uint32_t size, WifiTxVector txVector, WifiPreamble preamble, double frequency);
+};
+
+TxDurationCacheTest::TxDurationCacheTest ()
+  : TestCase ("Wifi TX Duration cache")
+{
+}
+
+Time
+TxDurationCacheTest::Compute (Ptr<WifiPhy> phy, uint32_t size, WifiTxVector txVector, WifiPreamble preamble, double frequency)
+{
+  return phy->CalculatePlcpPreambleAndHeaderDuration (txVector, preamble)
+         + phy->GetPayloadDuration (size, txVector, preamble, frequency, 0, 0);
+}
+
+void
+TxDurationCacheTest::DoRun (void)
+{
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  WifiMode modes[] = {
+    WifiPhy::GetOfdmRate300KbpsBW1MHz (), WifiPhy::GetOfdmRate650KbpsBW2MHz (),
+    WifiPhy::GetOfdmRate722_2KbpsBW2MHz (), WifiPhy::GetOfdmRate65MbpsBW20MHz ()
+  };
+  WifiPreamble preambles[] = {
+    WIFI_PREAMBLE_S1G_1M, WIFI_PREAMBLE_S1G_SHORT, WIFI_PREAMBLE_S1G_SHORT, WIFI_PREAMBLE_HT_MF
+  };
+  uint32_t sizes[] = { 14, 76, 1536 };
+  double frequencies[] = { CHANNEL_1_MHZ, CHANNEL_36_MHZ };
+
+  //twice, so that the second pass is served by the cache
+  for (uint32_t pass = 0; pass < 2; pass++)
+    {
+      for (uint32_t m = 0; m < sizeof (modes) / sizeof (modes[0]); m++)
+        {
+          for (uint8_t nss = 1; nss <= 2; nss++)
+            {
+              WifiTxVector txVector;
+              txVector.SetMode (modes[m]);
+              txVector.SetNss (nss);
+              txVector.SetStbc (0);
+              txVector.SetNess (0);
+              for (uint32_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); s++)
+                {
+                  for (uint32_t f = 0; f < sizeof (frequencies) / sizeof (frequencies[0]); f++)
+                    {
+                      Time expected = Compute (phy, sizes[s], txVector, preambles[m], frequencies[f]);
+                      NS_TEST_EXPECT_MSG_EQ (phy->CalculateTxDuration (sizes[s], txVector, preambles[m], frequencies[f], 0, 0),
+                                             expected, "Wrong duration for " << modes[m] << " nss=" << (uint32_t)nss
+                                             << " size=" << sizes[s] << " frequency=" << frequencies[f]);
+                    }
+                }
+            }
+        }
+    }
+
+  //an A-MPDU interleaved with cached computations gives the same
+  //durations as on a fresh PHY
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate650KbpsBW2MHz ());
+  txVector.SetNss (1);
+  txVector.SetStbc (0);
+  txVector.SetNess (0);
+  Ptr<YansWifiPhy> fresh = CreateObject<YansWifiPhy> ();
+  Time first = fresh->CalculateTxDuration (100, txVector, WIFI_PREAMBLE_S1G_SHORT, CHANNEL_1_MHZ, 1, 1);
+  Time middle = fresh->CalculateTxDuration (100, txVector, WIFI_PREAMBLE_NONE, CHANNEL_1_MHZ, 1, 1);
+  Time last = fresh->CalculateTxDuration (100, txVector, WIFI_PREAMBLE_NONE, CHANNEL_1_MHZ, 2, 1);
+
+  NS_TEST_EXPECT_MSG_EQ (phy->CalculateTxDuration (100, txVector, WIFI_PREAMBLE_S1G_SHORT, CHANNEL_1_MHZ, 1, 1), first, "Wrong first MPDU");
+  phy->CalculateTxDuration (100, txVector, WIFI_PREAMBLE_S1G_SHORT, CHANNEL_1_MHZ, 0, 0);
+  NS_TEST_EXPECT_MSG_EQ (phy->CalculateTxDuration (100, txVector, WIFI_PREAMBLE_NONE, CHANNEL_1_MHZ, 1, 1), middle, "Wrong middle MPDU");
+  phy->CalculateTxDuration (100, txVector, WIFI_PREAMBLE_S1G_SHORT, CHANNEL_1_MHZ, 0, 0);
+  NS_TEST_EXPECT_MSG_EQ (phy->CalculateTxDuration (100, txVector, WIFI_PREAMBLE_NONE, CHANNEL_1_MHZ, 2, 1), last, "Wrong last MPDU");
+}
+
+
 class TxDurationTestSuite : public TestSuite
 {
 public:
@@ -291,3 +390,18 @@ TxDurationTestSuite::TxDurationTestSuite ()
 }
 
 static TxDurationTestSuite g_txDurationTestSuite;
+
+
+class TxDurationCacheTestSuite : public TestSuite
+{
+public:
+  TxDurationCacheTestSuite ();
+};
+
+TxDurationCacheTestSuite::TxDurationCacheTestSuite ()
+  : TestSuite ("devices-wifi-tx-duration-cache", UNIT)
+{
+  AddTestCase (new TxDurationCacheTest, TestCase::QUICK);
+}
+
+static TxDurationCacheTestSuite g_txDurationCacheTestSuite;
@@ -25,6 +25,7 @@
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/yans-wifi-phy.h"
 #include "ns3/arf-wifi-manager.h"
+#include "ns3/constant-rate-wifi-manager.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/error-rate-model.h"
@@ -41,6 +42,16 @@
 #include "ns3/edca-txop-n.h"
 #include "ns3/config.h"
 #include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/s1g-wifi-mac-helper.h"
+#include "ns3/wifi-association-helper.h"
+#include "ns3/sta-wifi-mac.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/yans-wifi-remote-channel.h"
+#include "ns3/wifi-partition-helper.h"
+#include "ns3/nstime.h"
 
 using namespace ns3;
 
@@ -499,3 +510,722 @@ WifiTestSuite::WifiTestSuite ()
 }
 
 static WifiTestSuite g_wifiTestSuite;
+
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that a YansWifiChannel with SkipSleepingPhys set does not
+ * deliver the frames sent while a receiver sleeps until a known time,
+ * and still delivers the frames sent once it is resumed.
+ */
+class SleepingReceiverTest : public TestCase
+{
+public:
+  SleepingReceiverTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  void RunOne (bool skipSleepingPhys);
+  Ptr<WifiNetDevice> CreateOne (Vector pos, Ptr<YansWifiChannel> channel);
+  void SendOnePacket (Ptr<WifiNetDevice> dev);
+  void Sleep (Ptr<WifiNetDevice> dev, Time wakeUpTime);
+  void RxBegin (Ptr<const Packet> p);
+  void RxDrop (Ptr<const Packet> p);
+
+  uint32_t m_rxBegin; //!< Number of frames the receiver started to receive
+  uint32_t m_rxDrop;  //!< Number of frames the receiver dropped
+};
+
+SleepingReceiverTest::SleepingReceiverTest ()
+  : TestCase ("Skip the frames a sleeping receiver would drop")
+{
+}
+
+Ptr<WifiNetDevice>
+SleepingReceiverTest::CreateOne (Vector pos, Ptr<YansWifiChannel> channel)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<WifiNetDevice> dev = CreateObject<WifiNetDevice> ();
+
+  ObjectFactory mac;
+  mac.SetTypeId ("ns3::AdhocWifiMac");
+  Ptr<WifiMac> adhoc = mac.Create<WifiMac> ();
+  adhoc->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetChannel (channel);
+  phy->SetDevice (dev);
+  phy->SetMobility (mobility);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+
+  mobility->SetPosition (pos);
+  node->AggregateObject (mobility);
+  adhoc->SetAddress (Mac48Address::Allocate ());
+  dev->SetMac (adhoc);
+  dev->SetPhy (phy);
+  dev->SetRemoteStationManager (CreateObject<ConstantRateWifiManager> ());
+  node->AddDevice (dev);
+  return dev;
+}
+
+void
+SleepingReceiverTest::SendOnePacket (Ptr<WifiNetDevice> dev)
+{
+  dev->Send (Create<Packet> (1000), dev->GetBroadcast (), 1);
+}
+
+void
+SleepingReceiverTest::Sleep (Ptr<WifiNetDevice> dev, Time wakeUpTime)
+{
+  dev->GetPhy ()->SetSleepMode ();
+  dev->GetPhy ()->SetWakeUpTime (wakeUpTime);
+  Simulator::Schedule (wakeUpTime - Simulator::Now (), &WifiPhy::ResumeFromSleep, dev->GetPhy ());
+}
+
+void
+SleepingReceiverTest::RxBegin (Ptr<const Packet> p)
+{
+  m_rxBegin++;
+}
+
+void
+SleepingReceiverTest::RxDrop (Ptr<const Packet> p)
+{
+  m_rxDrop++;
+}
+
+void
+SleepingReceiverTest::RunOne (bool skipSleepingPhys)
+{
+  m_rxBegin = 0;
+  m_rxDrop = 0;
+
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<FriisPropagationLossModel> ());
+  channel->SetAttribute ("SkipSleepingPhys", BooleanValue (skipSleepingPhys));
+
+  Ptr<WifiNetDevice> sender = CreateOne (Vector (0.0, 0.0, 0.0), channel);
+  Ptr<WifiNetDevice> receiver = CreateOne (Vector (5.0, 0.0, 0.0), channel);
+  receiver->GetPhy ()->TraceConnectWithoutContext ("PhyRxBegin", MakeCallback (&SleepingReceiverTest::RxBegin, this));
+  receiver->GetPhy ()->TraceConnectWithoutContext ("PhyRxDrop", MakeCallback (&SleepingReceiverTest::RxDrop, this));
+
+  Simulator::Schedule (Seconds (0.5), &SleepingReceiverTest::Sleep, this, receiver, Seconds (2.0));
+  Simulator::Schedule (Seconds (1.0), &SleepingReceiverTest::SendOnePacket, this, sender);
+  Simulator::Schedule (Seconds (3.0), &SleepingReceiverTest::SendOnePacket, this, sender);
+
+  Simulator::Stop (Seconds (4.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+SleepingReceiverTest::DoRun (void)
+{
+  RunOne (false);
+  NS_TEST_ASSERT_MSG_EQ (m_rxDrop, 1, "The frame sent during the sleep was not delivered and dropped");
+  NS_TEST_ASSERT_MSG_EQ (m_rxBegin, 1, "The frame sent after the wake up was not received");
+
+  RunOne (true);
+  NS_TEST_ASSERT_MSG_EQ (m_rxDrop, 0, "The frame sent during the sleep was delivered");
+  NS_TEST_ASSERT_MSG_EQ (m_rxBegin, 1, "The frame sent after the wake up was not received");
+}
+
+//-----------------------------------------------------------------------------
+class WifiSleepingReceiverTestSuite : public TestSuite
+{
+public:
+  WifiSleepingReceiverTestSuite ();
+};
+
+WifiSleepingReceiverTestSuite::WifiSleepingReceiverTestSuite ()
+  : TestSuite ("devices-wifi-sleeping-receivers", UNIT)
+{
+  AddTestCase (new SleepingReceiverTest, TestCase::QUICK);
+}
+
+static WifiSleepingReceiverTestSuite g_wifiSleepingReceiverTestSuite;
+
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that a frame sent on an S1G channel makes CCA busy on an
+ * adjacent channel only when AdjacentChannelInterference is set, and
+ * that a PHY switched to the channel of the sender receives its frames.
+ * The 5 and 10 MHz PHYs also use channel numbers below 52, but do not
+ * leak into each other nor into the S1G PHYs.
+ */
+class AdjacentChannelInterferenceTest : public TestCase
+{
+public:
+  AdjacentChannelInterferenceTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  void RunOne (bool adjacentChannelInterference);
+  void RunMixedWidths (void);
+  Ptr<YansWifiPhy> CreateOne (Vector pos, uint16_t channelNumber, Ptr<YansWifiChannel> channel,
+                              WifiPhyStandard standard = WIFI_PHY_STANDARD_80211ah, uint32_t channelWidth = 1);
+  void SendOnePacket (Ptr<YansWifiPhy> phy);
+  void SendOneLegacyPacket (Ptr<YansWifiPhy> phy, WifiMode mode);
+  void CheckIdle (Ptr<YansWifiPhy> first, Ptr<YansWifiPhy> second);
+  void CheckStates (Ptr<YansWifiPhy> coChannel, Ptr<YansWifiPhy> adjacent);
+  void SwitchChannel (Ptr<YansWifiPhy> phy, uint16_t channelNumber);
+  void CheckSwitched (Ptr<YansWifiPhy> switched);
+
+  bool m_coChannelRx;      //!< Whether the PHY on the same channel was receiving
+  bool m_adjacentCcaBusy;  //!< Whether CCA was busy on the adjacent channel
+  bool m_adjacentIdle;     //!< Whether the PHY on the adjacent channel was idle
+  bool m_switchedRx;       //!< Whether the PHY switched to the channel of the sender was receiving
+  uint32_t m_idleChecks;   //!< Number of checks which found both PHYs idle
+};
+
+AdjacentChannelInterferenceTest::AdjacentChannelInterferenceTest ()
+  : TestCase ("Leak the frames sent on an S1G channel into the adjacent channels")
+{
+}
+
+Ptr<YansWifiPhy>
+AdjacentChannelInterferenceTest::CreateOne (Vector pos, uint16_t channelNumber, Ptr<YansWifiChannel> channel,
+                                            WifiPhyStandard standard, uint32_t channelWidth)
+{
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (pos);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetChannel (channel);
+  phy->SetMobility (mobility);
+  phy->SetChannelWidth (channelWidth);
+  phy->SetChannelNumber (channelNumber);
+  phy->ConfigureStandard (standard);
+  return phy;
+}
+
+void
+AdjacentChannelInterferenceTest::SendOnePacket (Ptr<YansWifiPhy> phy)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate300KbpsBW1MHz ());
+  txVector.SetTxPowerLevel (0);
+  txVector.SetNss (1);
+  phy->SendPacket (Create<Packet> (100), txVector, WIFI_PREAMBLE_S1G_1M, 0);
+}
+
+void
+AdjacentChannelInterferenceTest::SendOneLegacyPacket (Ptr<YansWifiPhy> phy, WifiMode mode)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (mode);
+  txVector.SetTxPowerLevel (0);
+  txVector.SetNss (1);
+  phy->SendPacket (Create<Packet> (100), txVector, WIFI_PREAMBLE_LONG, 0);
+}
+
+void
+AdjacentChannelInterferenceTest::CheckIdle (Ptr<YansWifiPhy> first, Ptr<YansWifiPhy> second)
+{
+  if (first->IsStateIdle () && second->IsStateIdle ())
+    {
+      m_idleChecks++;
+    }
+}
+
+void
+AdjacentChannelInterferenceTest::CheckStates (Ptr<YansWifiPhy> coChannel, Ptr<YansWifiPhy> adjacent)
+{
+  m_coChannelRx = coChannel->IsStateRx ();
+  m_adjacentCcaBusy = adjacent->IsStateCcaBusy ();
+  m_adjacentIdle = adjacent->IsStateIdle ();
+}
+
+void
+AdjacentChannelInterferenceTest::SwitchChannel (Ptr<YansWifiPhy> phy, uint16_t channelNumber)
+{
+  phy->SetChannelNumber (channelNumber);
+}
+
+void
+AdjacentChannelInterferenceTest::CheckSwitched (Ptr<YansWifiPhy> switched)
+{
+  m_switchedRx = switched->IsStateRx ();
+}
+
+void
+AdjacentChannelInterferenceTest::RunOne (bool adjacentChannelInterference)
+{
+  m_coChannelRx = false;
+  m_adjacentCcaBusy = false;
+  m_adjacentIdle = false;
+  m_switchedRx = false;
+
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<FriisPropagationLossModel> ());
+  channel->SetAttribute ("AdjacentChannelInterference", BooleanValue (adjacentChannelInterference));
+
+  Ptr<YansWifiPhy> sender = CreateOne (Vector (0.0, 0.0, 0.0), 1, channel);
+  Ptr<YansWifiPhy> coChannel = CreateOne (Vector (1.0, 0.0, 0.0), 1, channel);
+  Ptr<YansWifiPhy> adjacent = CreateOne (Vector (0.0, 1.0, 0.0), 3, channel);
+
+  Simulator::Schedule (Seconds (1.0), &AdjacentChannelInterferenceTest::SendOnePacket, this, sender);
+  Simulator::Schedule (Seconds (1.0) + MilliSeconds (1), &AdjacentChannelInterferenceTest::CheckStates, this,
+                       coChannel, adjacent);
+  Simulator::Schedule (Seconds (1.2), &AdjacentChannelInterferenceTest::SwitchChannel, this, adjacent, 1);
+  Simulator::Schedule (Seconds (1.5), &AdjacentChannelInterferenceTest::SendOnePacket, this, sender);
+  Simulator::Schedule (Seconds (1.5) + MilliSeconds (1), &AdjacentChannelInterferenceTest::CheckSwitched, this,
+                       adjacent);
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+AdjacentChannelInterferenceTest::RunMixedWidths (void)
+{
+  m_idleChecks = 0;
+
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<FriisPropagationLossModel> ());
+  channel->SetAttribute ("AdjacentChannelInterference", BooleanValue (true));
+
+  Ptr<YansWifiPhy> tenMhz = CreateOne (Vector (0.0, 0.0, 0.0), 1, channel, WIFI_PHY_STANDARD_80211_10MHZ, 10);
+  Ptr<YansWifiPhy> fiveMhz = CreateOne (Vector (1.0, 0.0, 0.0), 3, channel, WIFI_PHY_STANDARD_80211_5MHZ, 5);
+  Ptr<YansWifiPhy> s1g = CreateOne (Vector (0.0, 1.0, 0.0), 2, channel);
+
+  Simulator::Schedule (Seconds (1.0), &AdjacentChannelInterferenceTest::SendOneLegacyPacket, this,
+                       tenMhz, WifiPhy::GetOfdmRate3MbpsBW10MHz ());
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (100), &AdjacentChannelInterferenceTest::CheckIdle, this,
+                       fiveMhz, s1g);
+  Simulator::Schedule (Seconds (1.5), &AdjacentChannelInterferenceTest::SendOnePacket, this, s1g);
+  Simulator::Schedule (Seconds (1.5) + MilliSeconds (1), &AdjacentChannelInterferenceTest::CheckIdle, this,
+                       tenMhz, fiveMhz);
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+AdjacentChannelInterferenceTest::DoRun (void)
+{
+  RunOne (false);
+  NS_TEST_ASSERT_MSG_EQ (m_coChannelRx, true, "The frame was not received on its channel");
+  NS_TEST_ASSERT_MSG_EQ (m_adjacentIdle, true, "The frame was seen on the adjacent channel");
+  NS_TEST_ASSERT_MSG_EQ (m_switchedRx, true, "The frame was not received after switching to its channel");
+
+  RunOne (true);
+  NS_TEST_ASSERT_MSG_EQ (m_coChannelRx, true, "The frame was not received on its channel");
+  NS_TEST_ASSERT_MSG_EQ (m_adjacentCcaBusy, true, "The frame did not make CCA busy on the adjacent channel");
+
+  RunMixedWidths ();
+  NS_TEST_ASSERT_MSG_EQ (m_idleChecks, 2, "A frame leaked between PHYs which do not both use S1G channels");
+}
+
+//-----------------------------------------------------------------------------
+class WifiAdjacentChannelTestSuite : public TestSuite
+{
+public:
+  WifiAdjacentChannelTestSuite ();
+};
+
+WifiAdjacentChannelTestSuite::WifiAdjacentChannelTestSuite ()
+  : TestSuite ("devices-wifi-adjacent-channel", UNIT)
+{
+  AddTestCase (new AdjacentChannelInterferenceTest, TestCase::QUICK);
+}
+
+static WifiAdjacentChannelTestSuite g_wifiAdjacentChannelTestSuite;
+
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that the stations associated by WifiAssociationHelper get the
+ * AID the association frames would give them, and stay associated once
+ * the AP starts beaconing.
+ */
+class AssociationHelperTest : public TestCase
+{
+public:
+  AssociationHelperTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  void CheckAssociated (NetDeviceContainer staDevices, Ptr<WifiNetDevice> ap);
+  void Assoc (Mac48Address bssid);
+  void DeAssoc (Mac48Address bssid);
+
+  uint32_t m_assoc;   //!< Number of stations which became associated
+  uint32_t m_deAssoc; //!< Number of stations which lost their association
+};
+
+AssociationHelperTest::AssociationHelperTest ()
+  : TestCase ("Associate the stations without the association frames")
+{
+}
+
+void
+AssociationHelperTest::Assoc (Mac48Address bssid)
+{
+  m_assoc++;
+}
+
+void
+AssociationHelperTest::DeAssoc (Mac48Address bssid)
+{
+  m_deAssoc++;
+}
+
+void
+AssociationHelperTest::CheckAssociated (NetDeviceContainer staDevices, Ptr<WifiNetDevice> ap)
+{
+  for (uint32_t i = 0; i < staDevices.GetN (); i++)
+    {
+      Ptr<WifiNetDevice> sta = DynamicCast<WifiNetDevice> (staDevices.Get (i));
+      Ptr<StaWifiMac> mac = DynamicCast<StaWifiMac> (sta->GetMac ());
+      Mac48Address address = Mac48Address::ConvertFrom (sta->GetAddress ());
+      uint8_t buffer[6];
+      address.CopyTo (buffer);
+      NS_TEST_ASSERT_MSG_EQ (mac->GetBssid (), ap->GetMac ()->GetAddress (), "The station is associated with another BSS");
+      NS_TEST_ASSERT_MSG_EQ (mac->GetAID (), (((buffer[4] & 0x1f) << 8) | buffer[5]), "The AID is not derived from the address");
+      NS_TEST_ASSERT_MSG_EQ (ap->GetRemoteStationManager ()->IsAssociated (address), true,
+                             "The AP does not know the station is associated");
+    }
+}
+
+void
+AssociationHelperTest::DoRun (void)
+{
+  NodeContainer staNodes;
+  staNodes.Create (2);
+  NodeContainer apNode;
+  apNode.Create (1);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  phy.Set ("ChannelWidth", UintegerValue (2));
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ah);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate650KbpsBW2MHz"),
+                                "ControlMode", StringValue ("OfdmRate650KbpsBW2MHz"));
+  S1gWifiMacHelper mac = S1gWifiMacHelper::Default ();
+  Ssid ssid = Ssid ("association-helper");
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+  NetDeviceContainer staDevices = wifi.Install (phy, mac, staNodes);
+
+  // one RAW group covering the AIDs of the stations
+  uint8_t buffer[6];
+  Mac48Address::ConvertFrom (staDevices.Get (0)->GetAddress ()).CopyTo (buffer);
+  uint32_t aidStart = ((buffer[4] & 0x1f) << 8) | buffer[5];
+  RPS *rps = new RPS;
+  RPS::RawAssignment raw;
+  raw.SetRawControl (0);
+  raw.SetSlotCrossBoundary (1);
+  raw.SetSlotFormat (1);
+  raw.SetSlotDurationCount (200);
+  raw.SetSlotNum (1);
+  raw.SetRawGroup (((aidStart + 1) << 13) | (aidStart << 2));
+  rps->SetRawAssignment (raw);
+  RPSVector rpsVector;
+  rpsVector.rpsset.push_back (rps);
+  pageSlice pageS;
+  pageS.SetPageindex (0);
+  pageS.SetPagePeriod (1);
+  pageS.SetPageSliceLen (1);
+  pageS.SetPageSliceCount (0);
+  pageS.SetBlockOffset (0);
+  pageS.SetTIMOffset (0);
+  TIM tim;
+  tim.SetPageIndex (0);
+  tim.SetDTIMPeriod (1);
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "NRawStations", UintegerValue (2),
+               "RPSsetup", RPSVectorValue (rpsVector),
+               "PageSliceSet", pageSliceValue (pageS),
+               "TIMSet", TIMValue (tim));
+  NetDeviceContainer apDevices = wifi.Install (phy, mac, apNode);
+  Ptr<WifiNetDevice> ap = DynamicCast<WifiNetDevice> (apDevices.Get (0));
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (staNodes);
+  mobility.Install (apNode);
+
+  m_assoc = 0;
+  m_deAssoc = 0;
+  for (uint32_t i = 0; i < staDevices.GetN (); i++)
+    {
+      Ptr<WifiMac> staMac = DynamicCast<WifiNetDevice> (staDevices.Get (i))->GetMac ();
+      staMac->TraceConnectWithoutContext ("Assoc", MakeCallback (&AssociationHelperTest::Assoc, this));
+      staMac->TraceConnectWithoutContext ("DeAssoc", MakeCallback (&AssociationHelperTest::DeAssoc, this));
+    }
+
+  WifiAssociationHelper association;
+  association.Associate (staDevices, ap);
+  NS_TEST_ASSERT_MSG_EQ (m_assoc, 2, "Not every station became associated");
+  CheckAssociated (staDevices, ap);
+
+  Simulator::Schedule (Seconds (1.0), &AssociationHelperTest::CheckAssociated, this, staDevices, ap);
+  Simulator::Stop (Seconds (1.5));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_ASSERT_MSG_EQ (m_assoc, 2, "A station associated again");
+  NS_TEST_ASSERT_MSG_EQ (m_deAssoc, 0, "A station lost its association");
+}
+
+//-----------------------------------------------------------------------------
+class WifiAssociationHelperTestSuite : public TestSuite
+{
+public:
+  WifiAssociationHelperTestSuite ();
+};
+
+WifiAssociationHelperTestSuite::WifiAssociationHelperTestSuite ()
+  : TestSuite ("devices-wifi-association-helper", UNIT)
+{
+  AddTestCase (new AssociationHelperTest, TestCase::QUICK);
+}
+
+static WifiAssociationHelperTestSuite g_wifiAssociationHelperTestSuite;
+
+//-----------------------------------------------------------------------------
+/**
+ * A YansWifiRemoteChannel which hands the frames for the PHYs of the
+ * other tasks back to itself instead of sending them with MPI, so that
+ * the path of a remote frame can be checked in a single process.
+ */
+class LoopbackRemoteChannel : public YansWifiRemoteChannel
+{
+public:
+  LoopbackRemoteChannel ();
+
+  uint32_t m_handOffs; //!< Number of frames handed to another task
+
+
+private:
+  virtual void SendToTask (Ptr<Packet> packet, Time rxTime, Ptr<NetDevice> device) const;
+  void Deliver (Ptr<Packet> packet);
+};
+
+LoopbackRemoteChannel::LoopbackRemoteChannel ()
+  : m_handOffs (0)
+{
+}
+
+void
+LoopbackRemoteChannel::SendToTask (Ptr<Packet> packet, Time rxTime, Ptr<NetDevice> device) const
+{
+  LoopbackRemoteChannel *channel = const_cast<LoopbackRemoteChannel *> (this);
+  channel->m_handOffs++;
+  Simulator::ScheduleWithContext (device->GetNode ()->GetId (), rxTime - Simulator::Now (),
+                                  &LoopbackRemoteChannel::Deliver, channel, packet);
+}
+
+void
+LoopbackRemoteChannel::Deliver (Ptr<Packet> packet)
+{
+  ReceiveRemote (packet);
+}
+
+/**
+ * Make sure that a frame reaches a PHY owned by another task at the
+ * same time and with the same outcome as a local PHY at the same
+ * distance, even though the remote PHY only detects it after the
+ * PreambleDetectionTime, and that the lookahead accounts for it.
+ */
+class RemoteChannelTest : public TestCase
+{
+public:
+  RemoteChannelTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  Ptr<WifiNetDevice> CreateOne (Vector pos, uint32_t systemId, Ptr<YansWifiChannel> channel);
+  void SendOnePacket (Ptr<WifiNetDevice> dev);
+  void LocalRxEnd (Ptr<const Packet> p);
+  void RemoteRxEnd (Ptr<const Packet> p);
+
+  Time m_localRxEnd;   //!< End of the reception by the local PHY
+  Time m_remoteRxEnd;  //!< End of the reception by the remote PHY
+  uint32_t m_localRx;  //!< Number of frames received by the local PHY
+  uint32_t m_remoteRx; //!< Number of frames received by the remote PHY
+};
+
+RemoteChannelTest::RemoteChannelTest ()
+  : TestCase ("Receive the frames mirrored to another task like local frames")
+{
+}
+
+Ptr<WifiNetDevice>
+RemoteChannelTest::CreateOne (Vector pos, uint32_t systemId, Ptr<YansWifiChannel> channel)
+{
+  Ptr<Node> node = CreateObject<Node> (systemId);
+  Ptr<WifiNetDevice> dev = CreateObject<WifiNetDevice> ();
+
+  ObjectFactory mac;
+  mac.SetTypeId ("ns3::AdhocWifiMac");
+  Ptr<WifiMac> adhoc = mac.Create<WifiMac> ();
+  adhoc->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetChannel (channel);
+  phy->SetDevice (dev);
+  phy->SetMobility (mobility);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+
+  mobility->SetPosition (pos);
+  node->AggregateObject (mobility);
+  adhoc->SetAddress (Mac48Address::Allocate ());
+  dev->SetMac (adhoc);
+  dev->SetPhy (phy);
+  dev->SetRemoteStationManager (CreateObject<ConstantRateWifiManager> ());
+  node->AddDevice (dev);
+  return dev;
+}
+
+void
+RemoteChannelTest::SendOnePacket (Ptr<WifiNetDevice> dev)
+{
+  dev->Send (Create<Packet> (1000), dev->GetBroadcast (), 1);
+}
+
+void
+RemoteChannelTest::LocalRxEnd (Ptr<const Packet> p)
+{
+  m_localRx++;
+  m_localRxEnd = Simulator::Now ();
+}
+
+void
+RemoteChannelTest::RemoteRxEnd (Ptr<const Packet> p)
+{
+  m_remoteRx++;
+  m_remoteRxEnd = Simulator::Now ();
+}
+
+void
+RemoteChannelTest::DoRun (void)
+{
+  m_localRx = 0;
+  m_remoteRx = 0;
+
+  Ptr<LoopbackRemoteChannel> channel = CreateObject<LoopbackRemoteChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<FriisPropagationLossModel> ());
+  channel->SetAttribute ("PreambleDetectionTime", TimeValue (MicroSeconds (4)));
+
+  Ptr<WifiNetDevice> sender = CreateOne (Vector (0.0, 0.0, 0.0), 0, channel);
+  Ptr<WifiNetDevice> local = CreateOne (Vector (5.0, 0.0, 0.0), 0, channel);
+  Ptr<WifiNetDevice> remote = CreateOne (Vector (0.0, 5.0, 0.0), 1, channel);
+  local->GetPhy ()->TraceConnectWithoutContext ("PhyRxEnd", MakeCallback (&RemoteChannelTest::LocalRxEnd, this));
+  remote->GetPhy ()->TraceConnectWithoutContext ("PhyRxEnd", MakeCallback (&RemoteChannelTest::RemoteRxEnd, this));
+
+  // the nearest local PHY is 5 m away from the remote PHY
+  Time delay = CreateObject<ConstantSpeedPropagationDelayModel> ()->GetDelay (sender->GetNode ()->GetObject<MobilityModel> (),
+                                                                              remote->GetNode ()->GetObject<MobilityModel> ());
+  NS_TEST_ASSERT_MSG_EQ (channel->GetRemoteLookAhead (1), delay + MicroSeconds (4), "Wrong lookahead");
+  NS_TEST_ASSERT_MSG_EQ (channel->GetRemoteLookAhead (0).IsStrictlyNegative (), true, "Lookahead towards the local task");
+
+  Simulator::Schedule (Seconds (1.0), &RemoteChannelTest::SendOnePacket, this, sender);
+  // the PHY of the remote node does not transmit on this task
+  Simulator::Schedule (Seconds (2.0), &RemoteChannelTest::SendOnePacket, this, remote);
+
+  Simulator::Stop (Seconds (3.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (channel->m_handOffs, 1, "The frame was not handed to the remote task once");
+  NS_TEST_ASSERT_MSG_EQ (m_localRx, 1, "The local PHY did not receive the frame");
+  NS_TEST_ASSERT_MSG_EQ (m_remoteRx, 1, "The remote PHY did not receive the frame");
+  NS_TEST_ASSERT_MSG_EQ (m_remoteRxEnd, m_localRxEnd, "The remote reception is not as long as the local one");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that WifiPartitionHelper keeps every station with its nearest
+ * AP and puts neighbouring BSSs on the same task.
+ */
+class PartitionHelperTest : public TestCase
+{
+public:
+  PartitionHelperTest ();
+
+  virtual void DoRun (void);
+};
+
+PartitionHelperTest::PartitionHelperTest ()
+  : TestCase ("Split the BSSs over the tasks by geography")
+{
+}
+
+void
+PartitionHelperTest::DoRun (void)
+{
+  // two pairs of APs, far apart along x, with two stations each
+  std::vector<Vector> aps;
+  aps.push_back (Vector (0.0, 0.0, 0.0));
+  aps.push_back (Vector (1000.0, 0.0, 0.0));
+  aps.push_back (Vector (0.0, 200.0, 0.0));
+  aps.push_back (Vector (1000.0, 200.0, 0.0));
+  std::vector<Vector> stas;
+  for (uint32_t ap = 0; ap < aps.size (); ap++)
+    {
+      stas.push_back (Vector (aps[ap].x + 10.0, aps[ap].y, 0.0));
+      stas.push_back (Vector (aps[ap].x, aps[ap].y - 10.0, 0.0));
+    }
+
+  WifiPartitionHelper partition;
+  partition.SetSystemCount (2);
+  partition.Partition (aps, stas);
+
+  NS_TEST_ASSERT_MSG_EQ (partition.GetApSystemId (0), partition.GetApSystemId (2), "Neighbouring BSSs on different tasks");
+  NS_TEST_ASSERT_MSG_EQ (partition.GetApSystemId (1), partition.GetApSystemId (3), "Neighbouring BSSs on different tasks");
+  NS_TEST_ASSERT_MSG_NE (partition.GetApSystemId (0), partition.GetApSystemId (1), "The BSSs are not spread over the tasks");
+  for (uint32_t sta = 0; sta < stas.size (); sta++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (partition.GetStaAp (sta), sta / 2, "The station is not attached to its nearest AP");
+      NS_TEST_ASSERT_MSG_EQ (partition.GetStaSystemId (sta), partition.GetApSystemId (sta / 2), "The BSS is split");
+    }
+
+  NodeContainer apNodes = partition.CreateApNodes ();
+  NodeContainer staNodes = partition.CreateStaNodes ();
+  NS_TEST_ASSERT_MSG_EQ (apNodes.GetN (), aps.size (), "Wrong number of AP nodes");
+  NS_TEST_ASSERT_MSG_EQ (staNodes.GetN (), stas.size (), "Wrong number of station nodes");
+  for (uint32_t ap = 0; ap < aps.size (); ap++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (apNodes.Get (ap)->GetSystemId (), partition.GetApSystemId (ap), "AP node on the wrong task");
+    }
+  for (uint32_t sta = 0; sta < stas.size (); sta++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (staNodes.Get (sta)->GetSystemId (), partition.GetStaSystemId (sta), "Station node on the wrong task");
+    }
+}
+
+//-----------------------------------------------------------------------------
+class WifiRemoteChannelTestSuite : public TestSuite
+{
+public:
+  WifiRemoteChannelTestSuite ();
+};
+
+WifiRemoteChannelTestSuite::WifiRemoteChannelTestSuite ()
+  : TestSuite ("devices-wifi-remote-channel", UNIT)
+{
+  AddTestCase (new RemoteChannelTest, TestCase::QUICK);
+  AddTestCase (new PartitionHelperTest, TestCase::QUICK);
+}
+
+static WifiRemoteChannelTestSuite g_wifiRemoteChannelTestSuite;
@@ -20,9 +20,21 @@
 #include "ns3/system-wall-clock-ms.h"
 #include "ns3/packet.h"
 #include "ns3/packet-metadata.h"
+#ifdef NS3_BENCH_WIFI
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/nqos-wifi-mac-helper.h"
+#include "ns3/mobility-helper.h"
+#endif
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <stdlib.h> // for exit ()
 
 using namespace ns3;
@@ -254,6 +266,120 @@ benchC (uint32_t n)
 }
 
 
+static void
+benchE (uint32_t n)
+{
+  BenchHeader<8> udp;
+  BenchHeader<25> ipv4;
+  BenchHeader<8> llc;
+  BenchHeader<26> mac;
+  const uint32_t inFlight = 256;
+  const uint32_t receivers = 4;
+  std::vector<Ptr<Packet> > queue (inFlight);
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (100);
+    p->AddHeader (udp);
+    p->AddHeader (ipv4);
+    p->AddHeader (llc);
+    p->AddHeader (mac);
+    for (uint32_t j = 0; j < receivers; j++)
+      {
+        Ptr<Packet> o = p->Copy ();
+        o->RemoveHeader (mac);
+        o->RemoveHeader (llc);
+        o->RemoveHeader (ipv4);
+        o->RemoveHeader (udp);
+      }
+    // keep frames queued, as the stations of a large scenario do
+    queue[i % inFlight] = p;
+  }
+}
+
+static void
+benchF (uint32_t n)
+{
+  // the packet tags a Wi-Fi frame carries: QoS, flow id, SNR and A-MPDU
+  BenchTag<1> qos;
+  BenchTag<4> flowId;
+  BenchTag<8> snr;
+  BenchTag<3> ampdu;
+  BenchTag<2> absent;
+  const uint32_t receivers = 4;
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (100);
+    p->AddPacketTag (qos);
+    p->AddPacketTag (flowId);
+    p->AddPacketTag (ampdu);
+    for (uint32_t j = 0; j < receivers; j++)
+      {
+        Ptr<Packet> o = p->Copy ();
+        o->ReplacePacketTag (snr);
+        o->PeekPacketTag (qos);
+        o->PeekPacketTag (flowId);
+        o->PeekPacketTag (absent);
+        o->RemovePacketTag (ampdu);
+        o->PeekPacketTag (snr);
+      }
+  }
+}
+
+#ifdef NS3_BENCH_WIFI
+static uint32_t g_wifiLeft;
+
+static bool
+WifiReceive (Ptr<NetDevice> receiver, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  BenchHeader<25> ipv4;
+  BenchHeader<8> udp;
+  Ptr<Packet> p = packet->Copy ();
+  p->RemoveHeader (ipv4);
+  p->RemoveHeader (udp);
+  if (--g_wifiLeft > 0)
+    {
+      // answer with the next packet, one frame in flight at a time
+      Ptr<Packet> next = Create<Packet> (100);
+      next->AddHeader (udp);
+      next->AddHeader (ipv4);
+      receiver->Send (next, from, 0x0800);
+    }
+  return true;
+}
+
+static void
+benchWifi (uint32_t n)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  phy.Set ("ChannelWidth", UintegerValue (20));
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate54Mbps"));
+  NqosWifiMacHelper mac = NqosWifiMacHelper::Default ();
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  MobilityHelper mobility;
+  mobility.Install (nodes);
+
+  devices.Get (0)->SetReceiveCallback (MakeCallback (&WifiReceive));
+  devices.Get (1)->SetReceiveCallback (MakeCallback (&WifiReceive));
+  g_wifiLeft = n;
+  BenchHeader<25> ipv4;
+  BenchHeader<8> udp;
+  Ptr<Packet> p = Create<Packet> (100);
+  p->AddHeader (udp);
+  p->AddHeader (ipv4);
+  devices.Get (0)->Send (p, devices.Get (1)->GetAddress (), 0x0800);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+#endif
+
 static void
 runBench (void (*bench) (uint32_t), uint32_t n, char const *name)
 {
@@ -301,6 +427,11 @@ int main (int argc, char *argv[])
   runBench (&benchB, n, "Just add headers");
   runBench (&benchC, n, "Remove by func call");
   runBench (&benchD, n, "Intermixed add/remove headers and tags");
+  runBench (&benchE, n, "Wi-Fi header stack, queued, copied to 4 receivers");
+  runBench (&benchF, n, "Wi-Fi packet tags, copied to 4 receivers");
+#ifdef NS3_BENCH_WIFI
+  runBench (&benchWifi, n, "Through a WifiNetDevice and back, one frame in flight");
+#endif
 
   return 0;
 }